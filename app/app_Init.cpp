@@ -6,6 +6,7 @@
 #include "app/app_Init.hpp"
 
 #include "platform/platform_buzzer.hpp"
+#include "platform/platform_benchmark.hpp"
 #include "platform/platform_boot_counter.hpp"
 #include "platform/platform_display.hpp"
 #include "platform/platform_ethernet.hpp"
@@ -16,9 +17,13 @@
 #include "platform/platform_storage.hpp"
 #include "platform/platform_ws2812.hpp"
 #include "servers/button_service.hpp"
+#include "servers/display_render_service.hpp"
+#include "servers/display_service.hpp"
 #include "servers/encoder_service.hpp"
 #include "servers/hello_service.hpp"
 #include "servers/imu_service.hpp"
+#include "servers/led_effect_service.hpp"
+#include "servers/screen_mirror_service.hpp"
 #include "servers/sensor_service.hpp"
 #include "servers/tcp_service.hpp"
 #include "servers/time_service.hpp"
@@ -38,7 +43,8 @@ int app_Init() noexcept {
     platform::logger().error("failed to init display", ret);
     return ret;
   }
-  ret = display.backlight().set_brightness(100U);
+  /* 启动画面绘制期间背光渐亮，避免上电瞬间的整屏闪白。 */
+  ret = display.backlight().fade_to(100U, CONFIG_SKY_BOARD_BACKLIGHT_FADE_MS);
   if (ret < 0) {
     platform::logger().error("failed to set backlight brightness", ret);
     return ret;
@@ -51,16 +57,47 @@ int app_Init() noexcept {
 
   platform::logger().info("display boot screen ready");
 
+#if defined(CONFIG_SKY_BOARD_BENCHMARK)
+  (void)platform::benchmark_font_raster(platform::logger());
+  (void)platform::benchmark_rle_decode(platform::logger());
+#if defined(CONFIG_SKY_BOARD_CJK_FONT)
+  (void)platform::benchmark_cjk_font(platform::logger());
+#endif
+#if defined(CONFIG_SKY_BOARD_WS2812_DITHER)
+  (void)platform::benchmark_ws2812_dither(platform::logger());
+#endif
+#endif
+
+#if defined(CONFIG_SKY_BOARD_DISPLAY_CONSOLE)
+  /* 控制台模式：面板改作滚动日志窗口，不再启动渲染服务与仪表盘。 */
+  ret = display.set_mode(platform::DisplayMode::kConsole);
+  if (ret < 0) {
+    platform::logger().error("failed to enter display console mode", ret);
+    return ret;
+  }
+  platform::logger().info("display console ready");
+#else
+  /* 启动画面之后由渲染服务独占面板，后续绘制均经其命令队列异步完成。 */
+  static servers::DisplayRenderService display_render_service(platform::logger(), display);
+  ret = display_render_service.run();
+  if (ret < 0) {
+    platform::logger().error("failed to start display render service", ret);
+    return ret;
+  }
+#endif
+
   platform::IBuzzer& buzzer = platform::buzzer();
   ret = buzzer.init();
   if (ret < 0) {
     platform::logger().error("failed to init buzzer", ret);
   }
 
-  ret = platform::ws2812().init();
-  if (ret < 0) {
-    platform::logger().error("failed to init ws2812", ret);
-    return ret;
+  for (size_t i = 0U; i < platform::ws2812_count(); ++i) {
+    ret = platform::ws2812_at(i)->init();
+    if (ret < 0) {
+      platform::logger().error("failed to init ws2812", ret);
+      return ret;
+    }
   }
   ret = platform::ethernet_init();
   if (ret < 0) {
@@ -152,6 +189,30 @@ int app_Init() noexcept {
     platform::logger().error("failed to start sensor service", ret);
     return ret;
   }
+  static servers::LedEffectService led_effect_service(platform::logger(), sensor_service);
+  ret = led_effect_service.run();
+  if (ret < 0) {
+    platform::logger().error("failed to start led effect service", ret);
+    return ret;
+  }
+
+#if !defined(CONFIG_SKY_BOARD_DISPLAY_CONSOLE)
+  static servers::DisplayService display_service(platform::logger(), display_render_service,
+                                                 sensor_service, encoder_service);
+  ret = display_service.run();
+  if (ret < 0) {
+    platform::logger().error("failed to start display service", ret);
+    return ret;
+  }
+#if defined(CONFIG_SKY_BOARD_SCREEN_MIRROR)
+  static servers::ScreenMirrorService screen_mirror_service(platform::logger(), display);
+  ret = screen_mirror_service.run();
+  if (ret < 0) {
+    platform::logger().error("failed to start screen mirror service", ret);
+    return ret;
+  }
+#endif
+#endif
 
 
 
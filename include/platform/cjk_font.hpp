@@ -0,0 +1,267 @@
+/**
+ * @file cjk_font.hpp
+ * @brief 外置 SPI Flash 中文点阵字库：排序码点索引二分查找 + RAM 字形 LRU 缓存 + UTF-8 行光栅化。
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "platform/display_raster.hpp"
+#include "platform/platform_spi_flash.hpp"
+
+#if defined(CONFIG_SKY_BOARD_CJK_FONT)
+
+namespace platform::raster {
+
+/** @brief 字库文件魔数 "SKF1"（小端）。 */
+constexpr uint32_t kCjkFontMagic = 0x31464B53U;
+/** @brief 字形单元边长（像素，Kconfig 可调），必须与打包字库一致。 */
+constexpr uint8_t kCjkGlyphSize = CONFIG_SKY_BOARD_CJK_FONT_SIZE;
+/** @brief 字形缓存槽位数（Kconfig 可调）。 */
+constexpr size_t kCjkCacheSlots = CONFIG_SKY_BOARD_CJK_GLYPH_CACHE_SLOTS;
+/** @brief 二分查找缩小到该条目数以内时一次读出剩余索引并顺序比较。 */
+constexpr uint32_t kCjkIndexBlockEntries = 16U;
+/** @brief 字形记录编码：按行存放的 1bpp 位图（每行 ceil(size / 8) 字节，bit0 为最左像素）。 */
+constexpr uint8_t kCjkGlyphRaw = 0U;
+/** @brief 字形记录编码：行优先比特流的交替游程，每个游程 4 bit，自背景色开始。 */
+constexpr uint8_t kCjkGlyphRuns = 1U;
+/** @brief 字形记录最大字节数：编码 1 字节 + 长度 1 字节 + 原始位图。 */
+constexpr size_t kCjkMaxRecordBytes = 2U + static_cast<size_t>(kCjkGlyphSize) * 2U;
+
+static_assert(kCjkGlyphSize >= 8U && kCjkGlyphSize <= 16U, "CJK glyph size must be 8..16");
+
+/**
+ * @brief 字库文件头（16 字节，小端）。
+ * @note 文件布局：文件头 | 索引（glyph_count 个 CjkIndexEntry，按码点升序） | 字形记录。
+ *       字形记录为 编码(1) | 负载长度(1) | 负载，负载格式见 kCjkGlyphRaw / kCjkGlyphRuns。
+ */
+struct CjkFontHeader {
+  uint32_t magic = 0U;
+  uint8_t width = 0U;
+  uint8_t height = 0U;
+  uint16_t reserved = 0U;
+  uint32_t glyph_count = 0U;
+  uint32_t total_bytes = 0U;
+};
+
+/**
+ * @brief 字库索引条目（8 字节，小端）。
+ */
+struct CjkIndexEntry {
+  /** @brief Unicode 码点。 */
+  uint32_t codepoint = 0U;
+  /** @brief 字形记录相对字库起点的偏移。 */
+  uint32_t offset = 0U;
+};
+
+static_assert(sizeof(CjkFontHeader) == 16U, "font header layout must match the font packer");
+static_assert(sizeof(CjkIndexEntry) == 8U, "font index layout must match the font packer");
+
+/**
+ * @brief 解码后的字形位图。
+ */
+struct CjkGlyph {
+  /** @brief 每行掩码，bit0 为最左像素。 */
+  uint16_t rows[kCjkGlyphSize]{};
+};
+
+/**
+ * @brief 字库统计。
+ */
+struct CjkFontStats {
+  /** @brief 缓存命中次数。 */
+  uint32_t hits = 0U;
+  /** @brief 缓存未命中（读 Flash）次数。 */
+  uint32_t misses = 0U;
+  /** @brief 字库中不存在的码点查询次数。 */
+  uint32_t not_found = 0U;
+  /** @brief 索引与字形读取的 Flash 访问次数。 */
+  uint32_t flash_reads = 0U;
+};
+
+/**
+ * @brief Flash 驻留字库。
+ * @note 首次查询时打开字库；已缓存的字形不再访问 Flash，缓存满时淘汰最久未使用的槽位。
+ *       attach() 与 get() 须在 lock()/unlock() 之间调用（光栅化可能发生在多个线程），
+ *       get_stats() 与 clear() 自行加锁。
+ */
+class CjkFont {
+ public:
+  /**
+   * @brief 指定字库所在 Flash 与偏移，并清空缓存。
+   * @param flash 字库所在 Flash。
+   * @param offset 字库文件头偏移。
+   * @note 未调用时使用 spi_flash_ext() 与 CONFIG_SKY_BOARD_CJK_FONT_OFFSET。
+   */
+  void attach(ISpiFlash& flash, uint32_t offset) noexcept;
+
+  /**
+   * @brief 加锁（所有实例共用一把锁）。
+   */
+  void lock() noexcept;
+
+  /**
+   * @brief 解锁。
+   */
+  void unlock() noexcept;
+
+  /**
+   * @brief 查找字形：先查缓存，未命中时二分查找索引并从 Flash 读取解码。
+   * @param codepoint Unicode 码点。
+   * @param[out] out 字形位图；-ENOENT 时为缺字方框。
+   * @return 0 成功；-ENOENT 字库中无此码点（结果同样缓存）；-EINVAL 字库非法或未 attach；
+   *         其他负值为 Flash 读取错误（例如 Flash 尚未初始化，之后会重试打开）。
+   * @note 调用方须持有锁。
+   */
+  int get(uint32_t codepoint, CjkGlyph& out) noexcept;
+
+  /**
+   * @brief 读取统计信息。
+   * @param[out] out 统计快照。
+   */
+  void get_stats(CjkFontStats& out) noexcept;
+
+  /**
+   * @brief 清空缓存与统计（字库保持打开）。
+   */
+  void clear() noexcept;
+
+ private:
+  /**
+   * @brief 缓存槽位。
+   */
+  struct Slot {
+    uint32_t codepoint = 0U;
+    uint32_t last_use = 0U;
+    /* 字库中无此码点：命中时直接返回 -ENOENT。 */
+    bool missing = false;
+    CjkGlyph glyph{};
+  };
+
+  /**
+   * @brief 读取并校验文件头。
+   * @return 0 成功；负值失败。
+   */
+  int open() noexcept;
+
+  /**
+   * @brief 在索引中二分查找码点。
+   * @param codepoint 码点。
+   * @param[out] offset 字形记录偏移。
+   * @return 0 成功；-ENOENT 未找到；其他负值为读取错误。
+   */
+  int find(uint32_t codepoint, uint32_t& offset) noexcept;
+
+  /**
+   * @brief 读取并解码字形记录。
+   * @param offset 字形记录偏移。
+   * @param[out] out 字形位图。
+   * @return 0 成功；-EIO 记录损坏；其他负值为读取错误。
+   */
+  int load(uint32_t offset, CjkGlyph& out) noexcept;
+
+  /**
+   * @brief 读取 Flash 并计数。
+   * @param offset 相对字库起点的偏移。
+   * @param buffer 输出缓冲。
+   * @param len 字节数。
+   * @return 0 成功；负值失败。
+   */
+  int read(uint32_t offset, void* buffer, size_t len) noexcept;
+
+  /** @brief 字库所在 Flash。 */
+  ISpiFlash* flash_ = nullptr;
+  /** @brief 字库偏移。 */
+  uint32_t base_ = 0U;
+  /** @brief 文件头（open 成功后有效）。 */
+  CjkFontHeader header_{};
+  /** @brief 最近一次打开结果：1 未尝试，0 已打开，负值为失败原因。 */
+  int open_status_ = 1;
+  /** @brief 缓存槽位。 */
+  Slot slots_[kCjkCacheSlots]{};
+  /** @brief LRU 逻辑时钟。 */
+  uint32_t clock_ = 0U;
+  /** @brief 统计。 */
+  CjkFontStats stats_{};
+  /** @brief 二分查找末段的索引读缓冲。 */
+  CjkIndexEntry index_block_[kCjkIndexBlockEntries]{};
+  /** @brief 字形记录读缓冲。 */
+  uint8_t record_[kCjkMaxRecordBytes]{};
+};
+
+/**
+ * @brief 获取全局字库实例。
+ * @return CjkFont 引用。
+ */
+CjkFont& cjk_font() noexcept;
+
+/**
+ * @brief 解码一个 UTF-8 码点。
+ * @param text 文本指针。
+ * @param len 剩余字节数（>= 1）。
+ * @param[out] codepoint 码点；非法序列输出 U+FFFD。
+ * @return 消耗的字节数（>= 1）。
+ */
+size_t utf8_decode(const char* text, size_t len, uint32_t& codepoint) noexcept;
+
+/**
+ * @brief 判断文本是否包含多字节 UTF-8 字符。
+ * @param text 文本指针。
+ * @param len 字节数。
+ * @return true 表示需要走 UTF-8 光栅化路径。
+ */
+bool utf8_has_multibyte(const char* text, size_t len) noexcept;
+
+/**
+ * @brief 求不超过 max_bytes 且不截断 UTF-8 字符的最长前缀。
+ * @param text 文本指针。
+ * @param len 字节数。
+ * @param max_bytes 字节上限（>= 4）。
+ * @return 前缀字节数。
+ */
+size_t utf8_prefix(const char* text, size_t len, size_t max_bytes) noexcept;
+
+/**
+ * @brief 计算 UTF-8 文本行宽度：ASCII 占 kCellWidth 列，其余字符占 kCjkGlyphSize 列。
+ * @param text 文本指针。
+ * @param len 字节数。
+ * @param scale 缩放倍数（>= 1）。
+ * @return 像素宽度。
+ */
+uint32_t utf8_line_width(const char* text, size_t len, uint8_t scale) noexcept;
+
+/**
+ * @brief UTF-8 文本行高度（不含行间隔）。
+ * @param scale 缩放倍数（>= 1）。
+ * @return 像素高度。
+ */
+constexpr uint16_t utf8_line_height(uint8_t scale) noexcept {
+  return static_cast<uint16_t>((kCjkGlyphSize > kCellHeight ? kCjkGlyphSize : kCellHeight) *
+                               scale);
+}
+
+/**
+ * @brief 把一行 UTF-8 文本的矩形片段展开到目标缓冲。
+ * @param font 字库。
+ * @param dst 目标缓冲左上角。
+ * @param pitch 目标缓冲行跨度（像素）。
+ * @param skip 相对文本行起点需要跳过的像素列数。
+ * @param w 输出宽度（像素）。
+ * @param line_row 片段首行相对文本行顶端的像素行号（已含缩放）。
+ * @param h 输出行数，line_row + h 不得超过 utf8_line_height(scale)。
+ * @param text 文本指针（不含 '\n'）。
+ * @param len 字节数。
+ * @param fg_rgb565 前景色。
+ * @param bg_rgb565 背景色。
+ * @param scale 缩放倍数（>= 1）。
+ * @note ASCII 字符使用 5x7 字模并在行内垂直居中；字库中没有的字符画空心方框。
+ */
+void rasterize_utf8_block(CjkFont& font, uint16_t* dst, size_t pitch, uint32_t skip, uint16_t w,
+                          uint16_t line_row, uint16_t h, const char* text, size_t len,
+                          uint16_t fg_rgb565, uint16_t bg_rgb565, uint8_t scale) noexcept;
+
+}  // namespace platform::raster
+
+#endif  // CONFIG_SKY_BOARD_CJK_FONT
@@ -0,0 +1,218 @@
+/**
+ * @file display_raster.hpp
+ * @brief 显示光栅化公共组件：RGB565 行填充、5x7 文本行展开、显示列表与脏矩形合并。
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "platform/font5x7.hpp"
+
+namespace platform::raster {
+
+/** @brief 字符单元宽度（字形 + 间隔列，缩放前）。 */
+constexpr uint8_t kCellWidth = font5x7::kWidth + font5x7::kSpacing;
+/** @brief 字符单元高度（缩放前）。 */
+constexpr uint8_t kCellHeight = font5x7::kHeight;
+
+/**
+ * @brief 屏幕坐标系下的矩形区域。
+ */
+struct Rect {
+  uint16_t x = 0U;
+  uint16_t y = 0U;
+  uint16_t w = 0U;
+  uint16_t h = 0U;
+};
+
+/**
+ * @brief 求两个矩形的交集。
+ * @param a 矩形 a。
+ * @param b 矩形 b。
+ * @param[out] out 交集矩形，仅在返回 true 时有效。
+ * @return true 表示存在非空交集。
+ */
+bool intersect(const Rect& a, const Rect& b, Rect& out) noexcept;
+
+/**
+ * @brief 判断矩形 outer 是否完整包含 inner。
+ * @param outer 外矩形。
+ * @param inner 内矩形。
+ * @return true 表示包含。
+ */
+bool contains(const Rect& outer, const Rect& inner) noexcept;
+
+/**
+ * @brief 以 32-bit 字为单位把 RGB565 颜色填充到像素缓冲。
+ * @param dst 目标缓冲；起始地址未按 4 字节对齐时先补写 1 个像素。
+ * @param count 像素个数。
+ * @param color_rgb565 RGB565 颜色值。
+ */
+void fill_rgb565_words(uint16_t* dst, size_t count, uint16_t color_rgb565) noexcept;
+
+/**
+ * @brief 把一行文本在某个字形行上的像素展开到目标行缓冲。
+ * @param dst 目标行缓冲，至少 count 个像素。
+ * @param skip 相对文本行起点需要跳过的像素数（用于左侧裁剪）。
+ * @param count 需要输出的像素个数。
+ * @param text 文本指针。
+ * @param len 文本字符数。
+ * @param glyph_row 字形行号（0~kCellHeight-1）。
+ * @param fg_rgb565 前景色。
+ * @param bg_rgb565 背景色。
+ * @param scale 缩放倍数（>= 1）。
+ * @note 超出文本行宽度的像素不写入。
+ */
+void rasterize_text_row(uint16_t* dst, uint32_t skip, uint16_t count, const char* text, size_t len,
+                        uint8_t glyph_row, uint16_t fg_rgb565, uint16_t bg_rgb565,
+                        uint8_t scale) noexcept;
+
+/**
+ * @brief 把一行文本的矩形片段展开到目标缓冲。
+ * @param dst 目标缓冲左上角。
+ * @param pitch 目标缓冲行跨度（像素）。
+ * @param skip 相对文本行起点需要跳过的像素列数（用于左侧裁剪）。
+ * @param w 输出宽度（像素）。
+ * @param line_row 片段首行相对文本行顶端的像素行号（已含缩放）。
+ * @param h 输出行数，line_row + h 不得超过 kCellHeight * scale。
+ * @param text 文本指针。
+ * @param len 文本字符数。
+ * @param fg_rgb565 前景色。
+ * @param bg_rgb565 背景色。
+ * @param scale 缩放倍数（>= 1）。
+ * @note 启用字形缓存且 scale 在缓存范围内时逐字符拷贝缓存行，否则逐行展开字模。
+ */
+void rasterize_text_block(uint16_t* dst, size_t pitch, uint32_t skip, uint16_t w,
+                          uint16_t line_row, uint16_t h, const char* text, size_t len,
+                          uint16_t fg_rgb565, uint16_t bg_rgb565, uint8_t scale) noexcept;
+
+/**
+ * @brief 把有符号整数格式化为十进制字符串。
+ * @param value 待格式化整数（支持 INT32_MIN）。
+ * @param buf 输出缓冲，至少 12 字节。
+ * @param size 输出缓冲大小。
+ * @return 写入的字符数（不含结尾 '\0'）；缓冲不足时返回 0。
+ */
+size_t format_int(int32_t value, char* buf, size_t size) noexcept;
+
+/**
+ * @brief 显示列表中的绘制命令类型。
+ */
+enum class OpType : uint8_t {
+  kFill = 0,
+  kText = 1,
+};
+
+/**
+ * @brief 显示列表中的一条绘制命令。
+ * @note bounds 为裁剪到屏幕后的包围盒；文本命令仅描述单行，且背景不透明。
+ */
+struct DrawOp {
+  OpType type = OpType::kFill;
+  uint8_t scale = 1U;
+  /** @brief 文本行起点（未裁剪）。 */
+  uint16_t origin_x = 0U;
+  uint16_t origin_y = 0U;
+  Rect bounds{};
+  uint16_t fg_rgb565 = 0U;
+  uint16_t bg_rgb565 = 0U;
+  /** @brief 文本在文本池中的偏移与长度。 */
+  uint16_t text_offset = 0U;
+  uint16_t text_len = 0U;
+};
+
+/**
+ * @brief 保留模式显示列表：记录绘制命令并维护合并后的脏矩形集合。
+ * @note 非线程安全，由所属显示实例在调用线程内串行使用。
+ */
+class DisplayList {
+ public:
+  /** @brief 单帧最多记录的绘制命令数。 */
+  static constexpr size_t kMaxOps = 32U;
+  /** @brief 文本池容量（字节）。 */
+  static constexpr size_t kTextPoolSize = 512U;
+  /** @brief 最多维护的脏矩形个数。 */
+  static constexpr size_t kMaxDirtyRects = 16U;
+
+  /**
+   * @brief 记录单色填充命令。
+   * @param bounds 已裁剪的填充区域。
+   * @param color_rgb565 RGB565 颜色值。
+   * @return 0 成功；-ENOMEM 表示列表已满，调用方需先 flush。
+   * @note 被新填充完整覆盖的旧命令会被丢弃，避免无效的重复光栅化。
+   */
+  int add_fill(const Rect& bounds, uint16_t color_rgb565) noexcept;
+
+  /**
+   * @brief 记录单行文本命令。
+   * @param origin_x 文本行起点 X。
+   * @param origin_y 文本行起点 Y。
+   * @param bounds 已裁剪的文本行包围盒。
+   * @param text 文本指针（不含 '\n'）。
+   * @param len 文本字符数。
+   * @param fg_rgb565 前景色。
+   * @param bg_rgb565 背景色。
+   * @param scale 缩放倍数（>= 1）。
+   * @return 0 成功；-ENOMEM 表示列表或文本池已满，调用方需先 flush。
+   */
+  int add_text(uint16_t origin_x, uint16_t origin_y, const Rect& bounds, const char* text,
+               size_t len, uint16_t fg_rgb565, uint16_t bg_rgb565, uint8_t scale) noexcept;
+
+  /**
+   * @brief 把与 region 相交的全部命令按记录顺序合成到像素缓冲。
+   * @param region 输出区域，须被已记录命令完整覆盖。
+   * @param out 输出缓冲，按行连续存放 region.w * region.h 个像素。
+   */
+  void render(const Rect& region, uint16_t* out) const noexcept;
+
+  /**
+   * @brief 清空命令、文本池与脏矩形。
+   */
+  void reset() noexcept;
+
+  /**
+   * @brief 判断是否没有待刷新的内容。
+   * @return true 表示为空。
+   */
+  bool empty() const noexcept { return op_count_ == 0U; }
+
+  /**
+   * @brief 获取当前脏矩形个数。
+   * @return 脏矩形个数。
+   */
+  size_t dirty_count() const noexcept { return dirty_count_; }
+
+  /**
+   * @brief 获取指定下标的脏矩形。
+   * @param index 下标，须小于 dirty_count()。
+   * @return 脏矩形引用。
+   */
+  const Rect& dirty_at(size_t index) const noexcept { return dirty_[index]; }
+
+ private:
+  /**
+   * @brief 把新命令的包围盒并入脏矩形集合。
+   * @param rect 新增区域。
+   * @return 0 成功；-ENOMEM 表示脏矩形集合已满。
+   * @note 只做无损合并（包含关系、可精确拼成矩形的相邻/重叠区域），
+   *       保证每个脏矩形内的像素都被已记录命令覆盖。
+   */
+  int add_dirty(Rect rect) noexcept;
+
+  /** @brief 绘制命令数组。 */
+  DrawOp ops_[kMaxOps]{};
+  /** @brief 有效命令个数。 */
+  size_t op_count_ = 0U;
+  /** @brief 文本池。 */
+  char text_pool_[kTextPoolSize]{};
+  /** @brief 文本池已用字节数。 */
+  size_t text_used_ = 0U;
+  /** @brief 合并后的脏矩形集合。 */
+  Rect dirty_[kMaxDirtyRects]{};
+  /** @brief 有效脏矩形个数。 */
+  size_t dirty_count_ = 0U;
+};
+
+}  // namespace platform::raster
@@ -16,6 +16,14 @@ constexpr uint8_t kHeight = 7U;
 /** @brief 字符间隔（像素，缩放前）。 */
 constexpr uint8_t kSpacing = 1U;
 
+#if defined(CONFIG_SKY_BOARD_FONT5X7_EXPANDED_ATLAS)
+/** @brief 编译期横向展开行掩码支持的最大缩放倍数。 */
+constexpr uint8_t kMaxExpandedScale = 3U;
+#else
+/** @brief 编译期横向展开行掩码支持的最大缩放倍数（未启用展开表时仅 1 倍）。 */
+constexpr uint8_t kMaxExpandedScale = 1U;
+#endif
+
 /**
  * @brief 根据 ASCII 字符获取 5x7 字模（按列存储，LSB 在上）。
  * @param c 输入字符。
@@ -23,4 +31,22 @@ constexpr uint8_t kSpacing = 1U;
  */
 const uint8_t* glyph(char c) noexcept;
 
+/**
+ * @brief 获取字符某一字形行的行掩码（编译期由列字模转置生成）。
+ * @param c 输入字符。
+ * @param row 字形行号（0~kHeight-1）。
+ * @return 行掩码，bit0 为最左列；间隔列恒为 0。
+ */
+uint8_t row_mask(char c, uint8_t row) noexcept;
+
+/**
+ * @brief 获取按缩放倍数横向展开后的行掩码。
+ * @param c 输入字符。
+ * @param row 字形行号（0~kHeight-1）。
+ * @param scale 缩放倍数（1~kMaxExpandedScale）。
+ * @return 展开后的掩码，每个字形列占 scale 个连续比特，bit0 为最左像素；
+ *         scale 超出范围时返回 0。
+ */
+uint32_t expanded_row_mask(char c, uint8_t row, uint8_t scale) noexcept;
+
 }  // namespace platform::font5x7
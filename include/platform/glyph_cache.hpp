@@ -0,0 +1,111 @@
+/**
+ * @file glyph_cache.hpp
+ * @brief 预缩放 RGB565 字形缓存：按（字符，缩放，前景色，背景色）缓存可直接拷贝的字形行。
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "platform/display_raster.hpp"
+
+#if defined(CONFIG_SKY_BOARD_DISPLAY_GLYPH_CACHE)
+
+namespace platform::raster {
+
+/** @brief 缓存支持的最大缩放倍数，更大的缩放直接从字模展开。 */
+constexpr uint8_t kGlyphCacheMaxScale = CONFIG_SKY_BOARD_DISPLAY_GLYPH_CACHE_MAX_SCALE;
+/** @brief 单个槽位像素数：kCellHeight 个字形行，每行按最大缩放横向展开。 */
+constexpr size_t kGlyphSlotPixels =
+    static_cast<size_t>(kCellWidth) * kGlyphCacheMaxScale * kCellHeight;
+/** @brief 槽位个数（由 RAM 预算换算）。 */
+constexpr size_t kGlyphSlotCount =
+    CONFIG_SKY_BOARD_DISPLAY_GLYPH_CACHE_BYTES / (kGlyphSlotPixels * sizeof(uint16_t));
+
+static_assert(kGlyphSlotCount > 0U, "glyph cache budget smaller than one slot");
+
+/**
+ * @brief 字形缓存统计。
+ */
+struct GlyphCacheStats {
+  /** @brief 命中次数。 */
+  uint32_t hits = 0U;
+  /** @brief 未命中（重新光栅化）次数。 */
+  uint32_t misses = 0U;
+  /** @brief 淘汰有效槽位的次数。 */
+  uint32_t evictions = 0U;
+};
+
+/**
+ * @brief LRU 字形缓存。
+ * @note 槽位内按行连续存放 kCellHeight 行，每行 kCellWidth * scale 个像素（含间隔列）；
+ *       纵向放大由调用方重复拷贝同一行完成。get() 返回的指针只在持锁期间有效，
+ *       下一次 get() 可能淘汰该槽位。
+ */
+class GlyphCache {
+ public:
+  /**
+   * @brief 加锁，渲染一段文本前调用一次。
+   */
+  void lock() noexcept;
+
+  /**
+   * @brief 解锁。
+   */
+  void unlock() noexcept;
+
+  /**
+   * @brief 查找字形，未命中时光栅化进最久未使用的槽位。
+   * @param c 字符。
+   * @param scale 缩放倍数（1~kGlyphCacheMaxScale）。
+   * @param fg_rgb565 前景色。
+   * @param bg_rgb565 背景色。
+   * @return 字形行数据；scale 超出范围时返回 nullptr。
+   * @note 调用方必须持有锁。
+   */
+  const uint16_t* get(char c, uint8_t scale, uint16_t fg_rgb565, uint16_t bg_rgb565) noexcept;
+
+  /**
+   * @brief 读取统计信息。
+   * @param[out] out 统计快照。
+   */
+  void get_stats(GlyphCacheStats& out) noexcept;
+
+  /**
+   * @brief 清空全部槽位与统计。
+   */
+  void clear() noexcept;
+
+ private:
+  /**
+   * @brief 槽位元数据。
+   */
+  struct Slot {
+    /** @brief 前景色（高 16 位）与背景色（低 16 位）。 */
+    uint32_t colors = 0U;
+    /** @brief 最近一次使用的逻辑时间戳，0 表示空槽。 */
+    uint32_t last_use = 0U;
+    char c = 0;
+    uint8_t scale = 0U;
+  };
+
+  /** @brief 槽位元数据。 */
+  Slot slots_[kGlyphSlotCount]{};
+  /** @brief 槽位像素数据。 */
+  alignas(4) uint16_t pixels_[kGlyphSlotCount][kGlyphSlotPixels]{};
+  /** @brief 逻辑时钟，每次 get() 递增。 */
+  uint32_t clock_ = 0U;
+  /** @brief 统计信息。 */
+  GlyphCacheStats stats_{};
+};
+
+/**
+ * @brief 获取全局字形缓存实例。
+ * @return GlyphCache 引用。
+ */
+GlyphCache& glyph_cache() noexcept;
+
+}  // namespace platform::raster
+
+#endif  // CONFIG_SKY_BOARD_DISPLAY_GLYPH_CACHE
@@ -24,11 +24,19 @@ class IBacklight {
   virtual int set_enabled(bool on) noexcept = 0;
 
   /**
-   * @brief 设置背光亮度百分比。
-   * @param percent 亮度百分比，范围 0~100；超过范围按边界处理。
+   * @brief 立即设置背光亮度百分比。
+   * @param percent 感知亮度百分比，范围 0~100；超过范围按边界处理。
    * @return 0 表示成功；负值表示失败。
    */
   virtual int set_brightness(uint8_t percent) noexcept = 0;
+
+  /**
+   * @brief 从当前亮度渐变到目标亮度，调用立即返回。
+   * @param percent 感知亮度百分比，范围 0~100；超过范围按边界处理。
+   * @param duration_ms 渐变时长（毫秒），0 等同于 set_brightness()。
+   * @return 0 表示成功；负值表示失败。
+   */
+  virtual int fade_to(uint8_t percent, uint32_t duration_ms) noexcept = 0;
 };
 
 }  // namespace platform
@@ -11,6 +11,26 @@
 
 namespace platform {
 
+/**
+ * @brief 显示绘制模式。
+ */
+enum class DisplayMode : uint8_t {
+  /** @brief 立即模式：每次绘制调用直接写入面板。 */
+  kImmediate = 0,
+  /** @brief 保留模式：绘制调用记录到显示列表，flush() 时按合并后的脏矩形一次性下发。 */
+  kRetained = 1,
+  /**
+   * @brief 调色板帧缓冲模式：绘制写入 16 色 4bpp 离屏帧缓冲，flush() 时把脏区域展开为 RGB565
+   *        下发。切入该模式时帧缓冲清为黑色；颜色超过 16 种时映射到最接近的已用颜色。
+   */
+  kPaletteFramebuffer = 2,
+  /**
+   * @brief 日志控制台模式：面板由硬件滚动控制台独占，经 display_console_write() 追加文本，
+   *        普通绘制调用返回 -EBUSY。
+   */
+  kConsole = 3,
+};
+
 /**
  * @brief 显示设备接口。
  */
@@ -55,6 +75,45 @@ class IDisplay {
   virtual int fill_rect(uint16_t x, uint16_t y, uint16_t w, uint16_t h,
                         uint16_t color_rgb565) noexcept = 0;
 
+  /**
+   * @brief 绘制 1 像素宽直线（含两端点）。
+   * @param x0 起点 X，可位于屏幕外。
+   * @param y0 起点 Y，可位于屏幕外。
+   * @param x1 终点 X，可位于屏幕外。
+   * @param y1 终点 Y，可位于屏幕外。
+   * @param color_rgb565 RGB565 颜色值。
+   * @return 0 表示成功；负值表示失败。
+   * @note 图元按水平跨度光栅化并合并为单色矩形写入，而非逐像素绘制；超出屏幕的部分被裁剪。
+   */
+  virtual int draw_line(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                        uint16_t color_rgb565) noexcept = 0;
+
+  /**
+   * @brief 绘制圆或实心圆。
+   * @param cx 圆心 X，可位于屏幕外。
+   * @param cy 圆心 Y，可位于屏幕外。
+   * @param r 半径（像素），0 为单个像素。
+   * @param color_rgb565 RGB565 颜色值。
+   * @param filled true 为实心圆；false 为 1 像素宽圆周。
+   * @return 0 表示成功；负值表示失败。
+   */
+  virtual int draw_circle(int16_t cx, int16_t cy, uint16_t r, uint16_t color_rgb565,
+                          bool filled) noexcept = 0;
+
+  /**
+   * @brief 绘制圆角矩形或实心圆角矩形。
+   * @param x 左上角 X，可位于屏幕外。
+   * @param y 左上角 Y，可位于屏幕外。
+   * @param w 宽度。
+   * @param h 高度。
+   * @param r 圆角半径，超过短边一半时按短边一半处理，0 为直角矩形。
+   * @param color_rgb565 RGB565 颜色值。
+   * @param filled true 为实心；false 为 1 像素宽边框。
+   * @return 0 表示成功；负值表示失败。
+   */
+  virtual int draw_round_rect(int16_t x, int16_t y, uint16_t w, uint16_t h, uint16_t r,
+                              uint16_t color_rgb565, bool filled) noexcept = 0;
+
   /**
    * @brief 绘制单个 5x7 字符（可缩放）。
    * @param x 左上角 X 坐标。
@@ -94,12 +153,56 @@ class IDisplay {
   virtual int draw_int(uint16_t x, uint16_t y, int32_t value, uint16_t fg_rgb565,
                        uint16_t bg_rgb565, uint8_t scale) noexcept = 0;
 
+  /**
+   * @brief 把预先光栅化的 RGB565 像素块写入矩形区域。
+   * @param x 左上角 X 坐标。
+   * @param y 左上角 Y 坐标。
+   * @param w 像素块宽度。
+   * @param h 像素块高度。
+   * @param pixels 按行连续存放的 w*h 个像素。
+   * @return 0 表示成功；-EINVAL 表示区域越界；其他负值表示失败。
+   */
+  virtual int blit(uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+                   const uint16_t* pixels) noexcept = 0;
+
+  /**
+   * @brief 从外置 SPI Flash 流式解码 RLE 图像资源并绘制（格式见 rle_image.hpp）。
+   * @param x 左上角 X 坐标。
+   * @param y 左上角 Y 坐标。
+   * @param flash_offset 图像资源在 spi_flash_ext() 中的偏移。
+   * @return 0 表示成功；-EINVAL 表示资源头非法或起点越界；-EIO 表示数据损坏；
+   *         其他负值表示失败。
+   * @note 超出屏幕的部分被裁剪；调用前须已初始化 spi_flash_ext()。
+   */
+  virtual int draw_image(uint16_t x, uint16_t y, uint32_t flash_offset) noexcept = 0;
+
   /**
    * @brief 绘制启动测试画面。
    * @return 0 表示成功；负值表示绘制失败。
    */
   virtual int show_boot_screen() noexcept = 0;
 
+  /**
+   * @brief 切换绘制模式。
+   * @param mode 目标模式。
+   * @return 0 表示成功；-ENOTSUP 表示后端不支持该模式；其他负值表示失败。
+   * @note 离开保留模式或调色板帧缓冲模式前会先 flush 未下发的内容。
+   */
+  virtual int set_mode(DisplayMode mode) noexcept = 0;
+
+  /**
+   * @brief 获取当前绘制模式。
+   * @return 当前模式。
+   */
+  virtual DisplayMode mode() const noexcept = 0;
+
+  /**
+   * @brief 把保留模式下记录的绘制内容（或帧缓冲的脏区域）下发到面板。
+   * @return 0 表示成功；负值表示失败。
+   * @note 重叠区域只光栅化、传输一次；立即模式下为空操作。
+   */
+  virtual int flush() noexcept = 0;
+
   /**
    * @brief 获取显示关联的背光控制接口。
    * @return IBacklight 引用。
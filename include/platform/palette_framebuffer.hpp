@@ -0,0 +1,127 @@
+/**
+ * @file palette_framebuffer.hpp
+ * @brief 16 色 4bpp 离屏帧缓冲：绘制在调色板索引域完成，下发时按条带展开为 RGB565。
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "platform/display_raster.hpp"
+
+#if defined(CONFIG_SKY_BOARD_DISPLAY_PALETTE_FB)
+
+namespace platform::raster {
+
+/** @brief 调色板颜色数（4bpp）。 */
+constexpr size_t kPaletteSize = 16U;
+/** @brief 帧缓冲支持的最大像素数（320x240，任一方向）。 */
+constexpr size_t kPaletteFbMaxPixels = 320U * 240U;
+
+/**
+ * @brief 4bpp 调色板帧缓冲。
+ * @note 每字节存放两个像素，高半字节为左侧（偶数 X）像素。调色板按首次使用顺序分配，
+ *       16 色用满后新颜色映射到最接近的已有颜色。非线程安全，由所属显示实例串行使用。
+ */
+class PaletteFramebuffer {
+ public:
+  /**
+   * @brief 设置帧缓冲尺寸并清零像素与调色板。
+   * @param width 宽度（像素）。
+   * @param height 高度（像素）。
+   * @return 0 成功；-ENOMEM 表示超过 kPaletteFbMaxPixels。
+   */
+  int configure(uint16_t width, uint16_t height) noexcept;
+
+  /**
+   * @brief 重置调色板，只保留一种颜色（索引 0）。
+   * @param color_rgb565 索引 0 的颜色。
+   * @note 已有像素的索引含义随之改变，应紧接着整屏填充索引 0。
+   */
+  void reset_palette(uint16_t color_rgb565) noexcept;
+
+  /**
+   * @brief 查找或分配颜色对应的调色板索引。
+   * @param color_rgb565 RGB565 颜色值。
+   * @return 调色板索引；调色板已满且无精确匹配时返回最接近颜色的索引。
+   */
+  uint8_t color_index(uint16_t color_rgb565) noexcept;
+
+  /**
+   * @brief 以单一索引填充矩形。
+   * @param rect 已裁剪到帧缓冲内的区域。
+   * @param index 调色板索引。
+   */
+  void fill(const Rect& rect, uint8_t index) noexcept;
+
+  /**
+   * @brief 绘制单行 5x7 文本（背景不透明）。
+   * @param bounds 已裁剪的文本行包围盒，左上角即文本行起点。
+   * @param text 文本指针（不含 '\n'）。
+   * @param len 文本字符数。
+   * @param fg_index 前景色索引。
+   * @param bg_index 背景色索引。
+   * @param scale 缩放倍数（>= 1）。
+   */
+  void draw_text(const Rect& bounds, const char* text, size_t len, uint8_t fg_index,
+                 uint8_t bg_index, uint8_t scale) noexcept;
+
+  /**
+   * @brief 把 RGB565 像素块量化写入帧缓冲。
+   * @param rect 已校验在帧缓冲内的区域。
+   * @param pixels 按行连续存放的 rect.w * rect.h 个像素。
+   * @note 颜色经 color_index() 映射，调色板满后为有损写入。
+   */
+  void blit(const Rect& rect, const uint16_t* pixels) noexcept;
+
+  /**
+   * @brief 把区域展开为 RGB565。
+   * @param region 帧缓冲内的区域。
+   * @param out 输出缓冲，按行连续存放 region.w * region.h 个像素。
+   */
+  void expand(const Rect& region, uint16_t* out) noexcept;
+
+  /**
+   * @brief 取出并清除自上次调用以来的脏区域包围盒。
+   * @param[out] out 脏区域，仅在返回 true 时有效。
+   * @return true 表示存在待下发区域。
+   */
+  bool take_dirty(Rect& out) noexcept;
+
+ private:
+  /**
+   * @brief 写入单个像素的索引。
+   * @param x X 坐标。
+   * @param y Y 坐标。
+   * @param index 调色板索引。
+   */
+  void set_pixel(uint16_t x, uint16_t y, uint8_t index) noexcept;
+
+  /**
+   * @brief 把区域并入脏区域包围盒。
+   * @param rect 新增区域。
+   */
+  void mark_dirty(const Rect& rect) noexcept;
+
+  /** @brief 像素索引，每字节两个像素。 */
+  uint8_t pixels_[kPaletteFbMaxPixels / 2U]{};
+  /** @brief 调色板（RGB565）。 */
+  uint16_t palette_[kPaletteSize]{};
+  /** @brief 字节到两像素 RGB565 的展开表，低半字为左侧像素。 */
+  uint32_t pair_lut_[256]{};
+  /** @brief 已分配的调色板颜色数。 */
+  uint8_t palette_count_ = 1U;
+  /** @brief 展开表是否需要按调色板重建。 */
+  bool lut_stale_ = true;
+  /** @brief 行跨度（字节）。 */
+  uint16_t pitch_ = 0U;
+  /** @brief 脏区域包围盒。 */
+  Rect dirty_{};
+  /** @brief 脏区域是否有效。 */
+  bool dirty_valid_ = false;
+};
+
+}  // namespace platform::raster
+
+#endif  // CONFIG_SKY_BOARD_DISPLAY_PALETTE_FB
@@ -15,4 +15,11 @@ namespace platform {
  */
 IBacklight& backlight();
 
+/**
+ * @brief 上报一次用户操作（按键、编码器）。
+ * @note 背光已空闲调暗时渐变恢复到应用设定的亮度，并重新开始空闲计时；
+ *       可在中断上下文调用。
+ */
+void backlight_user_activity() noexcept;
+
 }  // namespace platform
@@ -0,0 +1,51 @@
+/**
+ * @file platform_benchmark.hpp
+ * @brief 显示与灯带相关热点路径的启动期微基准（CONFIG_SKY_BOARD_BENCHMARK）。
+ */
+
+#pragma once
+
+#include "platform/ilogger.hpp"
+
+namespace platform {
+
+/**
+ * @brief 5x7 字形行光栅化基准：旧版按列逐像素分支 vs 行优先掩码查表。
+ * @param log 日志接口，用于输出每字形周期数。
+ * @return 0 表示两种实现输出一致；-EIO 表示输出不一致。
+ * @note 在调度器加锁状态下计时，结果仍包含中断开销。
+ */
+int benchmark_font_raster(ILogger& log) noexcept;
+
+/**
+ * @brief RLE 图像解码基准：合成图像经片内编码器压缩后，从 RAM 模拟的 Flash 解码并比对。
+ * @param log 日志接口，用于输出压缩比与每像素周期数。
+ * @return 0 表示解码结果与原图一致；-EIO 表示不一致；其他负值表示解码失败。
+ * @note 不读写外置 Flash，计时只包含解码本身，不含 SPI NOR 读取时间。
+ */
+int benchmark_rle_decode(ILogger& log) noexcept;
+
+#if defined(CONFIG_SKY_BOARD_CJK_FONT)
+/**
+ * @brief 中文字库基准：片内生成合成字库放入 RAM 模拟的 Flash，测量缓存未命中/命中的
+ *        单次查找周期数与整行渲染的每字形周期数。
+ * @param log 日志接口，用于输出周期数与每次未命中的 Flash 访问次数。
+ * @return 0 表示查找结果与合成字形一致；-EIO 表示不一致；其他负值表示查找失败。
+ * @note 使用独立字库实例，不影响全局字形缓存；未命中周期数不含 SPI NOR 读取时间，
+ *       实际代价需再加上 reads/miss 次 Flash 读取。
+ */
+int benchmark_cjk_font(ILogger& log) noexcept;
+#endif
+
+#if defined(CONFIG_SKY_BOARD_WS2812_DITHER)
+/**
+ * @brief WS2812 时间抖动基准：低亮度下的合成渐变，对比 8 bit 亮度表与 8.8 定点抖动的
+ *        每帧量化开销，并校验连续 256 帧输出之和等于 8.8 目标值。
+ * @param log 日志接口，用于输出可分辨级数、每帧周期数及其占 LED 帧周期的比例。
+ * @return 0 表示抖动平均值与目标一致；-EIO 表示不一致。
+ * @note 只计量化本身，不含脉冲展开与 DMA；使用独立残差缓冲，不影响灯带实例。
+ */
+int benchmark_ws2812_dither(ILogger& log) noexcept;
+#endif
+
+}  // namespace platform
@@ -5,14 +5,105 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+
 #include "platform/idisplay.hpp"
+#include "platform/ilogger.hpp"
 
 namespace platform {
 
+/**
+ * @brief 显示统计中单独计时的绘制操作。
+ */
+enum class DisplayOp : uint8_t {
+  /** @brief clear()。 */
+  kClear = 0,
+  /** @brief fill_rect()。 */
+  kFillRect,
+  /** @brief draw_char()/draw_text()/draw_int()。 */
+  kDrawText,
+  /** @brief blit()。 */
+  kBlit,
+  /** @brief draw_image()。 */
+  kDrawImage,
+  /** @brief flush()。 */
+  kFlush,
+  /** @brief 控制台写入。 */
+  kConsole,
+  /** @brief draw_line()/draw_circle()/draw_round_rect()。 */
+  kDrawShape,
+  /** @brief 操作种类数。 */
+  kCount,
+};
+
+/** @brief 耗时直方图桶数。 */
+constexpr size_t kDisplayStatsBuckets = 12U;
+/** @brief 首个直方图桶的上界（微秒），之后每桶翻倍，末桶统计其余全部。 */
+constexpr uint32_t kDisplayStatsFirstBucketUs = 64U;
+
+/**
+ * @brief 单种绘制操作的调用统计。
+ */
+struct DisplayOpStats {
+  /** @brief 调用次数。 */
+  uint32_t calls = 0U;
+  /** @brief 累计耗时（微秒）。 */
+  uint32_t total_us = 0U;
+  /** @brief 单次最大耗时（微秒）。 */
+  uint32_t max_us = 0U;
+  /** @brief 耗时直方图：第 i 桶为 [64 << (i - 1), 64 << i) 微秒，首桶下界为 0。 */
+  uint32_t histogram[kDisplayStatsBuckets]{};
+};
+
+/**
+ * @brief 显示传输统计快照。
+ */
+struct DisplayStats {
+  /** @brief display_write 调用次数。 */
+  uint32_t write_calls = 0U;
+  /** @brief 已推送像素数。 */
+  uint32_t write_pixels = 0U;
+  /** @brief 已推送字节数。 */
+  uint32_t write_bytes = 0U;
+  /** @brief display_write 累计耗时（微秒），即面板总线占用时间。 */
+  uint32_t write_us = 0U;
+  /** @brief 各绘制操作统计，按 DisplayOp 下标。 */
+  DisplayOpStats ops[static_cast<size_t>(DisplayOp::kCount)]{};
+};
+
 /**
  * @brief 获取全局显示实例。
  * @return IDisplay 引用，生命周期贯穿整个程序运行期。
  */
 IDisplay& display();
 
+/**
+ * @brief 向显示屏滚动控制台追加日志文本（DisplayMode::kConsole）。
+ * @param text 文本，超出屏宽或遇到 '\n' 时折行。
+ * @param error true 表示错误级（红色显示）。
+ * @return 0 表示成功；-ENODEV 表示显示未处于控制台模式；-ENOTSUP 表示未启用控制台；
+ *         其他负值表示写入失败。
+ * @note 可在任意线程调用；每行只重绘新的一行并更新一次硬件滚动指针。
+ */
+int display_console_write(const char* text, bool error) noexcept;
+
+/**
+ * @brief 读取显示统计快照。
+ * @param[out] out 统计快照。
+ * @param reset true 表示读取后清零，用于按周期统计。
+ * @return 0 表示成功；-ENOTSUP 表示未启用统计（CONFIG_SKY_BOARD_DISPLAY_STATS）。
+ * @note 计时在 ZephyrDisplay 的公开入口处进行，嵌套调用分别计入各自条目
+ *       （例如 clear() 内部的 fill_rect()、blit() 内部的 flush()）。
+ */
+int display_stats(DisplayStats& out, bool reset) noexcept;
+
+/**
+ * @brief 通过日志输出显示统计（总线占用一行，每种有调用的操作一行）。
+ * @param log 日志接口。
+ * @param reset true 表示输出后清零。
+ * @return 0 表示成功；-ENOTSUP 表示未启用统计。
+ */
+int display_stats_log(ILogger& log, bool reset) noexcept;
+
 }  // namespace platform
@@ -54,11 +54,30 @@ class IWs2812 {
   virtual int fill(const Ws2812Rgb& color) noexcept = 0;
 
   /**
-   * @brief 将本地缓冲区下发到灯带.
+   * @brief 将本地缓冲区下发到灯带, 阻塞直到发送完成.
    * @return 0 表示成功, 负值表示失败.
+   * @note 像素与亮度自上次成功提交后未变化时不重新发送.
    */
   virtual int show() noexcept = 0;
 
+  /**
+   * @brief 提交本地缓冲区后立即返回, 由 DMA 完成中断驱动发送.
+   * @return 0 表示已提交, 负值表示失败.
+   * @note 本地缓冲区在提交时被复制, 返回后即可继续组下一帧.
+   *       上一帧仍在发送时新帧排队, 排队期间重复提交只保留最新一帧.
+   *       像素与亮度自上次成功提交后未变化时直接返回 0, 不占用 CPU 编码与 DMA;
+   *       启用时间抖动 (CONFIG_SKY_BOARD_WS2812_DITHER) 且仍有小数级亮度时改为重发该帧.
+   */
+  virtual int show_async() noexcept = 0;
+
+  /**
+   * @brief 等待已提交的帧全部发送完成.
+   * @param timeout_ms 总超时毫秒, 小于 0 表示永久等待.
+   * @return 0 表示成功, -EAGAIN 表示超时, 其他负值为期间发生的发送错误.
+   * @note 超时是整次调用的上限: 排队帧与在途帧合计不超过 timeout_ms, 不会按帧重新计时.
+   */
+  virtual int wait_idle(int32_t timeout_ms) noexcept = 0;
+
   /**
    * @brief 清屏并立即下发.
    * @return 0 表示成功, 负值表示失败.
@@ -74,11 +93,31 @@ class IWs2812 {
 };
 
 /**
- * @brief 获取全局 WS2812 驱动实例.
- * @return 驱动实例引用.
+ * @brief 获取主 WS2812 驱动实例.
+ * @return ws2812-0 别名指向的灯带; 没有别名时为第一个实例; 没有启用的灯带时为空实例.
  */
 IWs2812& ws2812() noexcept;
 
+/**
+ * @brief 获取设备树中启用的 WS2812 灯带个数.
+ * @return 灯带个数.
+ */
+size_t ws2812_count() noexcept;
+
+/**
+ * @brief 按下标获取 WS2812 驱动实例.
+ * @param index 下标, 范围 0..ws2812_count()-1.
+ * @return 驱动实例; 越界时返回 nullptr.
+ */
+IWs2812* ws2812_at(size_t index) noexcept;
+
+/**
+ * @brief 提交所有灯带的当前像素缓冲并统一等待发送完成.
+ * @return 0 表示全部成功, 负值为第一个失败的错误码.
+ * @note 各灯带使用独立的定时器通道与 DMA stream 并行发送, 总耗时约为最长一条的发送时间.
+ */
+int ws2812_show_all() noexcept;
+
 /**
  * @brief 颜色轮函数, 根据相位生成 RGB 颜色.
  * @param pos 相位值, 范围 0..255.
@@ -86,6 +125,18 @@ IWs2812& ws2812() noexcept;
  */
 Ws2812Rgb ws2812_wheel(uint8_t pos) noexcept;
 
+/** @brief ws2812_hsv 的色相范围: 6 个色区, 每区 256 级. */
+constexpr uint16_t kWs2812HueRange = 6U * 256U;
+
+/**
+ * @brief 定点 HSV 转 RGB.
+ * @param hue 色相, 范围 0..kWs2812HueRange-1, 超出时取模; 0 为红, 512 为绿, 1024 为蓝.
+ * @param sat 饱和度, 范围 0..255.
+ * @param val 明度, 范围 0..255.
+ * @return 对应 RGB 颜色.
+ */
+Ws2812Rgb ws2812_hsv(uint16_t hue, uint8_t sat, uint8_t val) noexcept;
+
 /**
  * @brief 渲染一帧彩虹流水灯效果.
  * @param ws WS2812 驱动实例.
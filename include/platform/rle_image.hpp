@@ -0,0 +1,145 @@
+/**
+ * @file rle_image.hpp
+ * @brief RLE 压缩图像资源格式与流式解码器：从外置 SPI Flash 分块读取，逐行解码到条带缓冲。
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "platform/platform_spi_flash.hpp"
+
+namespace platform::raster {
+
+/** @brief 图像资源魔数 "SKI1"（小端）。 */
+constexpr uint32_t kImageMagic = 0x31494B53U;
+/** @brief 索引色图像的最大调色板颜色数。 */
+constexpr size_t kImagePaletteMax = 16U;
+
+/**
+ * @brief 图像像素编码格式。
+ */
+enum class ImageFormat : uint8_t {
+  /** @brief RLE 压缩的 RGB565（小端）。 */
+  kRgb565Rle = 0,
+  /** @brief RLE 压缩的 4bpp 调色板索引，调色板紧随文件头。 */
+  kIndexed4Rle = 1,
+};
+
+/**
+ * @brief 图像资源文件头（16 字节，小端）。
+ * @note 文件布局：文件头 | 调色板（palette_count 个 RGB565） | RLE 数据（payload_bytes 字节）。
+ *       RLE 数据按行优先连续编码，包可跨行：包头最高位为 1 表示重复包，后跟 1 个像素值；
+ *       为 0 表示字面包，后跟 n 个像素值；n = (包头 & 0x7F) + 1。索引色的像素值为 4 bit，
+ *       字面包按高半字节在前打包，奇数个像素时末字节低半字节填 0。
+ */
+struct ImageHeader {
+  uint32_t magic = 0U;
+  uint16_t width = 0U;
+  uint16_t height = 0U;
+  uint8_t format = 0U;
+  uint8_t palette_count = 0U;
+  uint16_t reserved = 0U;
+  uint32_t payload_bytes = 0U;
+};
+
+static_assert(sizeof(ImageHeader) == 16U, "image header layout must match the asset packer");
+
+/**
+ * @brief RLE 图像流式解码器。
+ * @note 只持有一个 kChunkBytes 的读缓冲，解码结果直接写入调用方的条带缓冲，
+ *       不需要整幅图像的 RAM 拷贝。非线程安全，由调用线程独占使用。
+ */
+class RleImageReader {
+ public:
+  /** @brief 单次从 Flash 读取的字节数。 */
+  static constexpr size_t kChunkBytes = 256U;
+
+  /**
+   * @brief 打开图像：读取并校验文件头与调色板，复位解码状态。
+   * @param flash 图像所在的 Flash。
+   * @param offset 图像文件头在 Flash 中的偏移。
+   * @return 0 成功；-EINVAL 文件头非法；其他负值为 Flash 读取错误。
+   */
+  int open(ISpiFlash& flash, uint32_t offset) noexcept;
+
+  /**
+   * @brief 获取图像宽度。
+   * @return 宽度（像素），未打开时为 0。
+   */
+  uint16_t width() const noexcept { return header_.width; }
+
+  /**
+   * @brief 获取图像高度。
+   * @return 高度（像素），未打开时为 0。
+   */
+  uint16_t height() const noexcept { return header_.height; }
+
+  /**
+   * @brief 按行解码矩形片段到目标缓冲。
+   * @param dst 目标缓冲左上角。
+   * @param pitch 目标缓冲行跨度（像素）。
+   * @param skip 每行左侧跳过的像素数。
+   * @param w 每行输出的像素数，skip + w 不得超过图像宽度。
+   * @param rows 解码行数。
+   * @return 0 成功；-EIO 数据流损坏或提前结束；其他负值为 Flash 读取错误。
+   * @note 从上次停止的位置继续，调用方按从上到下的顺序逐条带调用。
+   */
+  int read_rows(uint16_t* dst, size_t pitch, uint16_t skip, uint16_t w, uint16_t rows) noexcept;
+
+ private:
+  /**
+   * @brief 输出（或在 dst 为 nullptr 时丢弃）接下来的 count 个像素。
+   * @param dst 目标缓冲，可为 nullptr。
+   * @param count 像素数。
+   * @return 0 成功；负值失败。
+   */
+  int emit(uint16_t* dst, size_t count) noexcept;
+
+  /**
+   * @brief 读取下一个包头，重复包同时读取其像素值。
+   * @return 0 成功；负值失败。
+   */
+  int next_packet() noexcept;
+
+  /**
+   * @brief 读取一个字节，读缓冲耗尽时从 Flash 补充。
+   * @param[out] out 字节值。
+   * @return 0 成功；-EIO 数据已耗尽；其他负值为 Flash 读取错误。
+   */
+  int next_byte(uint8_t& out) noexcept;
+
+  /**
+   * @brief 从 Flash 补充读缓冲。
+   * @return 0 成功；-EIO 数据已耗尽；其他负值为 Flash 读取错误。
+   */
+  int refill() noexcept;
+
+  /** @brief 图像所在的 Flash。 */
+  ISpiFlash* flash_ = nullptr;
+  /** @brief 文件头。 */
+  ImageHeader header_{};
+  /** @brief 调色板（仅索引色图像）。 */
+  uint16_t palette_[kImagePaletteMax]{};
+  /** @brief 下一次读取的 Flash 偏移。 */
+  uint32_t next_offset_ = 0U;
+  /** @brief 尚未读入缓冲的 RLE 数据字节数。 */
+  uint32_t unread_bytes_ = 0U;
+  /** @brief 读缓冲。 */
+  alignas(4) uint8_t chunk_[kChunkBytes]{};
+  /** @brief 读缓冲有效字节数。 */
+  size_t chunk_len_ = 0U;
+  /** @brief 读缓冲当前位置。 */
+  size_t chunk_pos_ = 0U;
+  /** @brief 当前包剩余像素数。 */
+  uint8_t packet_left_ = 0U;
+  /** @brief 当前包是否为字面包。 */
+  bool literal_ = false;
+  /** @brief 字面索引包中已读入、尚未输出低半字节的字节；无则为负。 */
+  int16_t pending_nibble_ = -1;
+  /** @brief 重复包的像素值（RGB565）。 */
+  uint16_t run_color_ = 0U;
+};
+
+}  // namespace platform::raster
@@ -0,0 +1,154 @@
+/**
+ * @file screen_capture.hpp
+ * @brief 屏幕镜像捕获：在面板写入路径上把像素块编码为行增量 + RLE 记录流。
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+
+#if defined(CONFIG_SKY_BOARD_SCREEN_MIRROR)
+
+namespace platform {
+
+/** @brief 镜像流协议版本。 */
+constexpr uint8_t kMirrorVersion = 1U;
+/** @brief 记录类型：会话开始，w/h 为屏幕分辨率。 */
+constexpr uint8_t kMirrorHello = 'H';
+/** @brief 记录类型：自 (x, y) 起 h 行内容相同的 w 像素行段，负载为一行的 RLE 包。 */
+constexpr uint8_t kMirrorRows = 'R';
+/** @brief 记录类型：此前有记录因缓冲溢出被丢弃，随后会整屏重绘。 */
+constexpr uint8_t kMirrorResync = 'S';
+/** @brief 支持的最大行宽（像素）。 */
+constexpr uint16_t kMirrorMaxWidth = 320U;
+/** @brief 单行 RLE 负载上限：全部为 128 像素字面包时的像素与包头。 */
+constexpr size_t kMirrorMaxRowBytes = kMirrorMaxWidth * 2U + (kMirrorMaxWidth + 127U) / 128U;
+
+/**
+ * @brief 镜像流记录头（12 字节，小端），其后紧跟 payload_bytes 字节负载。
+ * @note kMirrorRows 的负载与 RLE 图像的 RGB565 包格式相同：包头 bit7 置位为游程
+ *       （(h & 0x7F) + 1 个像素，随后 1 个像素值），否则为字面包（随后 n 个像素值）。
+ */
+struct MirrorRecordHeader {
+  uint8_t type = 0U;
+  uint8_t version = kMirrorVersion;
+  uint16_t x = 0U;
+  uint16_t y = 0U;
+  uint16_t w = 0U;
+  uint16_t h = 0U;
+  uint16_t payload_bytes = 0U;
+};
+
+static_assert(sizeof(MirrorRecordHeader) == 12U, "mirror record layout must match the client");
+
+/**
+ * @brief 捕获统计。
+ */
+struct ScreenCaptureStats {
+  /** @brief 捕获的像素数据字节数（RGB565）。 */
+  uint32_t raw_bytes = 0U;
+  /** @brief 写入记录流的字节数。 */
+  uint32_t stream_bytes = 0U;
+  /** @brief 写入的行段记录数。 */
+  uint32_t records = 0U;
+  /** @brief 因缓冲溢出丢弃的记录数。 */
+  uint32_t dropped = 0U;
+};
+
+/**
+ * @brief 屏幕镜像捕获器。
+ * @note 显示层每次面板写入后调用 record()：块内连续相同的行合并为一条记录（行增量），
+ *       每行再做 RLE，因此静止画面不产生任何数据，编码开销与实际写入的像素数成正比。
+ *       记录写入环形缓冲，由镜像服务线程取出发送；未开始捕获时 record() 只检查一个原子标志。
+ *       镜像只能看到开始捕获之后的写入，因此开始捕获或缓冲溢出后会请求仪表盘整屏重绘。
+ */
+class ScreenCapture {
+ public:
+  /**
+   * @brief 开始捕获：清空缓冲、写入会话开始记录并请求整屏重绘。
+   * @param width 屏幕宽度。
+   * @param height 屏幕高度。
+   */
+  void begin(uint16_t width, uint16_t height) noexcept;
+
+  /**
+   * @brief 停止捕获。
+   */
+  void end() noexcept;
+
+  /**
+   * @brief 记录一次面板写入。
+   * @param x 左上角 X。
+   * @param y 左上角 Y。
+   * @param w 宽度（像素）。
+   * @param h 高度（像素）。
+   * @param pixels 行优先 RGB565 像素，行跨度为 w。
+   */
+  void record(uint16_t x, uint16_t y, uint16_t w, uint16_t h, const uint16_t* pixels) noexcept;
+
+  /**
+   * @brief 取出记录流数据。
+   * @param out 输出缓冲。
+   * @param max_len 最多取出的字节数。
+   * @param timeout 缓冲为空时的最长等待时间。
+   * @return 取出的字节数，超时为 0。
+   */
+  size_t read(uint8_t* out, size_t max_len, k_timeout_t timeout) noexcept;
+
+  /**
+   * @brief 查询并清除整屏重绘请求。
+   * @return true 表示需要整屏重绘。
+   */
+  bool take_resync() noexcept;
+
+  /**
+   * @brief 读取统计信息。
+   * @param[out] out 统计快照。
+   * @param reset true 时读取后清零。
+   */
+  void get_stats(ScreenCaptureStats& out, bool reset) noexcept;
+
+ private:
+  /**
+   * @brief 编码一条行段记录并写入缓冲，空间不足时丢弃并请求重绘。
+   * @param x 起始 X。
+   * @param y 起始 Y。
+   * @param w 宽度。
+   * @param rows 相同内容的行数。
+   * @param row 行像素。
+   */
+  void put_rows(uint16_t x, uint16_t y, uint16_t w, uint16_t rows, const uint16_t* row) noexcept;
+
+  /**
+   * @brief 把记录头与负载整体写入缓冲。
+   * @param header 记录头。
+   * @param payload 负载，可为 nullptr。
+   * @return true 写入成功；false 空间不足。
+   */
+  bool put_record(const MirrorRecordHeader& header, const uint8_t* payload) noexcept;
+
+  /** @brief 捕获开关：1 捕获中，0 停止。 */
+  atomic_t active_ = ATOMIC_INIT(0);
+  /** @brief 整屏重绘请求。 */
+  atomic_t resync_ = ATOMIC_INIT(0);
+  /** @brief 有记录被丢弃，下一条记录前需先写入 kMirrorResync。 */
+  bool lost_ = false;
+  /** @brief 统计。 */
+  ScreenCaptureStats stats_{};
+  /** @brief 单行 RLE 编码缓冲。 */
+  uint8_t row_buf_[kMirrorMaxRowBytes]{};
+};
+
+/**
+ * @brief 获取全局屏幕捕获器。
+ * @return ScreenCapture 引用。
+ */
+ScreenCapture& screen_capture() noexcept;
+
+}  // namespace platform
+
+#endif  // CONFIG_SKY_BOARD_SCREEN_MIRROR
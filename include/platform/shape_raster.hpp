@@ -0,0 +1,69 @@
+/**
+ * @file shape_raster.hpp
+ * @brief 二维图元光栅化：直线、圆、圆角矩形按水平跨度生成，并合并为尽量少的单色矩形。
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "platform/display_raster.hpp"
+
+namespace platform::raster {
+
+/**
+ * @brief 单色矩形输出回调，每个矩形对应一次单色填充。
+ * @param rect 已裁剪到 clip 内的非空矩形。
+ * @param user 调用方上下文。
+ * @return 0 表示继续；负值中止光栅化并由图元函数原样返回。
+ */
+using RectSink = int (*)(const Rect& rect, void* user);
+
+/**
+ * @brief 光栅化 1 像素宽直线（含两端点）。
+ * @param x0 起点 X。
+ * @param y0 起点 Y。
+ * @param x1 终点 X。
+ * @param y1 终点 Y。
+ * @param clip 裁剪区域（通常为整屏）。
+ * @param sink 矩形输出回调。
+ * @param user 回调上下文。
+ * @return 0 表示成功；负值为 sink 返回的错误。
+ * @note 同一行上的连续像素合并为一个跨度；陡峭直线上 X 不变的相邻行合并为竖条。
+ */
+int rasterize_line(int32_t x0, int32_t y0, int32_t x1, int32_t y1, const Rect& clip,
+                   RectSink sink, void* user) noexcept;
+
+/**
+ * @brief 光栅化圆或实心圆。
+ * @param cx 圆心 X。
+ * @param cy 圆心 Y。
+ * @param r 半径（像素），0 为单个像素，超过 32767 时按 32767 处理。
+ * @param filled true 为实心圆；false 为 1 像素宽圆周。
+ * @param clip 裁剪区域。
+ * @param sink 矩形输出回调。
+ * @param user 回调上下文。
+ * @return 0 表示成功；负值为 sink 返回的错误。
+ * @note 圆周取与圆心距离四舍五入等于 r 的像素，八方向对称且 8 邻接连续。
+ */
+int rasterize_circle(int32_t cx, int32_t cy, uint16_t r, bool filled, const Rect& clip,
+                     RectSink sink, void* user) noexcept;
+
+/**
+ * @brief 光栅化圆角矩形或实心圆角矩形。
+ * @param x 左上角 X。
+ * @param y 左上角 Y。
+ * @param w 宽度。
+ * @param h 高度。
+ * @param r 圆角半径，超过短边一半时按短边一半处理，0 为直角矩形。
+ * @param filled true 为实心；false 为 1 像素宽边框。
+ * @param clip 裁剪区域。
+ * @param sink 矩形输出回调。
+ * @param user 回调上下文。
+ * @return 0 表示成功；负值为 sink 返回的错误。
+ * @note 圆角与 rasterize_circle 的圆周一致；实心时圆角之间的各行合并为一个矩形。
+ */
+int rasterize_round_rect(int32_t x, int32_t y, uint16_t w, uint16_t h, uint16_t r, bool filled,
+                         const Rect& clip, RectSink sink, void* user) noexcept;
+
+}  // namespace platform::raster
@@ -0,0 +1,107 @@
+/**
+ * @file sparkline.hpp
+ * @brief 滚动曲线（sparkline）控件：环形扫描绘制时间序列，每个样本只重绘新增的一列。
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "platform/display_raster.hpp"
+#include "platform/idisplay.hpp"
+
+namespace platform {
+
+/**
+ * @brief 曲线配色。
+ */
+struct SparklineStyle {
+  /** @brief 曲线颜色。 */
+  uint16_t fg_rgb565 = 0xFFFFU;
+  /** @brief 背景色。 */
+  uint16_t bg_rgb565 = 0x0000U;
+  /** @brief 扫描光标颜色（标记最新一列之后的位置）。 */
+  uint16_t cursor_rgb565 = 0x39E7U;
+};
+
+/**
+ * @brief 环形扫描曲线控件。
+ * @note 写入位置像示波器扫描一样从左到右循环，最新一列之后画一列光标分隔新旧数据。
+ *       每个样本最多 4 次 1 像素宽的 fill_rect（列背景上/下段、曲线段、光标列），
+ *       单次更新代价只与图表高度有关，与宽度无关，已绘制的列不移动也不重绘。
+ *       相邻样本之间用竖直线段连接，瞬态尖峰不会因为只占一列而丢失。
+ *       非线程安全，由调用线程独占使用。
+ */
+class SparklineChart {
+ public:
+  /**
+   * @brief 设置图表区域、量程与配色，并标记需要重绘背景。
+   * @param area 屏幕区域，宽度至少 2 像素。
+   * @param min_value 量程下限（对应底行）。
+   * @param max_value 量程上限（对应顶行），必须大于下限。
+   * @param style 配色。
+   * @return 0 成功；-EINVAL 参数非法。
+   * @note 超出量程的样本被钳位到顶行或底行。
+   */
+  int configure(const raster::Rect& area, int32_t min_value, int32_t max_value,
+                const SparklineStyle& style) noexcept;
+
+  /**
+   * @brief 标记屏幕内容已失效（例如整屏被清除或绘制失败），下次 push 先重绘背景。
+   */
+  void invalidate() noexcept { valid_ = false; }
+
+  /**
+   * @brief 追加一个样本并绘制对应的一列。
+   * @param display 绘制目标。
+   * @param value 样本值。
+   * @return 0 成功；-EINVAL 未配置；其他负值为绘制失败（图表随之失效）。
+   */
+  int push(IDisplay& display, int32_t value) noexcept;
+
+ private:
+  /**
+   * @brief 清空图表区域并复位扫描位置。
+   * @param display 绘制目标。
+   * @return 0 成功；负值失败。
+   */
+  int reset(IDisplay& display) noexcept;
+
+  /**
+   * @brief 把样本值映射为行高（0 为底行）。
+   * @param value 样本值。
+   * @return 行高。
+   */
+  uint16_t level_of(int32_t value) const noexcept;
+
+  /**
+   * @brief 在图表内填充一段单列竖线。
+   * @param display 绘制目标。
+   * @param col 列（相对图表左侧）。
+   * @param top 起始行（相对图表顶部）。
+   * @param rows 行数，0 时不绘制。
+   * @param color_rgb565 颜色。
+   * @return 0 成功；负值失败。
+   */
+  int fill_column(IDisplay& display, uint16_t col, uint16_t top, uint16_t rows,
+                  uint16_t color_rgb565) noexcept;
+
+  /** @brief 图表区域。 */
+  raster::Rect area_{};
+  /** @brief 量程下限。 */
+  int32_t min_value_ = 0;
+  /** @brief 量程上限。 */
+  int32_t max_value_ = 0;
+  /** @brief 配色。 */
+  SparklineStyle style_{};
+  /** @brief 下一个样本写入的列。 */
+  uint16_t cursor_ = 0U;
+  /** @brief 上一个样本的行高。 */
+  uint16_t prev_level_ = 0U;
+  /** @brief prev_level_ 是否有效（复位后的首个样本不画连接线）。 */
+  bool has_prev_ = false;
+  /** @brief 屏幕上的图表背景是否有效。 */
+  bool valid_ = false;
+};
+
+}  // namespace platform
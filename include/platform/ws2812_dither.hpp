@@ -0,0 +1,101 @@
+/**
+ * @file ws2812_dither.hpp
+ * @brief WS2812 时间抖动: 以 8.8 定点保留亮度缩放后的小数部分, 把舍入误差分摊到后续帧.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "platform/platform_ws2812.hpp"
+
+namespace platform {
+
+/**
+ * @brief 8.8 定点通道值的最大值 (255.0).
+ * @note 上限取 0xFF00 而不是 0xFFFF, 加上 8 bit 残差后仍不超过 16 bit.
+ */
+constexpr uint16_t kWs2812DitherLevelMax = 0xFF00U;
+
+/**
+ * @brief 一阶时间抖动器 (逐通道 sigma-delta).
+ * @note 每帧每个通道: acc = 目标值(8.8) + 残差, 输出 acc 高 8 bit, 低 8 bit 留作下一帧的残差.
+ *       连续 256 帧输出之和恰好等于目标值, 低亮度下相邻 8 bit 级之间的过渡由帧间平均给出.
+ *       残差由调用方提供, 每像素 3 字节, 按 {r, g, b} 排列. 非线程安全.
+ */
+class Ws2812Dither {
+ public:
+  /**
+   * @brief 绑定残差存储并复位残差.
+   * @param residuals 残差缓冲, 至少 pixel_count * 3 字节, 须在对象生命周期内有效.
+   * @param pixel_count 像素个数.
+   */
+  Ws2812Dither(uint8_t* residuals, size_t pixel_count) noexcept;
+
+  /**
+   * @brief 按亮度重建 8.8 目标值表, 亮度未变化时直接返回.
+   * @param brightness 全局亮度, 范围 0..255.
+   */
+  void set_brightness(uint8_t brightness) noexcept;
+
+  /**
+   * @brief 把全部残差复位为 0.5, 使第一帧按四舍五入输出.
+   */
+  void reset() noexcept;
+
+  /**
+   * @brief 开始新的一帧, 清除本帧的小数标记.
+   */
+  void begin_frame() noexcept { fraction_ = 0U; }
+
+  /**
+   * @brief 本帧编码过的通道是否都没有小数部分.
+   * @return true 表示本帧无需抖动, 重复发送输出不变.
+   */
+  bool frame_exact() const noexcept { return fraction_ == 0U; }
+
+  /**
+   * @brief 查询通道值对应的 8.8 目标值.
+   * @param value 通道值, 范围 0..255.
+   * @return 校正并缩放后的 8.8 定点值.
+   */
+  uint16_t target(uint8_t value) const noexcept { return target_[value]; }
+
+  /**
+   * @brief 抖动一个像素并推进其残差.
+   * @param index 像素下标, 小于 pixel_count.
+   * @param color 原始 RGB 颜色.
+   * @return 本帧输出的 8 bit 通道值.
+   * @note 每通道一次查表, 一次加法, 一次残差写回, 可在 DMA 中断中逐像素调用.
+   */
+  Ws2812Rgb apply(const size_t index, const Ws2812Rgb& color) noexcept {
+    uint8_t* residual = &residuals_[index * 3U];
+    return {step(residual[0], color.r), step(residual[1], color.g), step(residual[2], color.b)};
+  }
+
+ private:
+  /**
+   * @brief 单通道 sigma-delta 步进.
+   * @param residual 该通道的残差, 原地更新.
+   * @param value 通道值.
+   * @return 本帧输出的 8 bit 通道值.
+   */
+  uint8_t step(uint8_t& residual, const uint8_t value) noexcept {
+    const uint16_t target = target_[value];
+    const uint16_t acc = static_cast<uint16_t>(target + residual);
+    fraction_ = static_cast<uint8_t>(fraction_ | target);
+    residual = static_cast<uint8_t>(acc);
+    return static_cast<uint8_t>(acc >> 8);
+  }
+
+  uint8_t* residuals_;
+  size_t pixel_count_;
+  bool target_valid_ = false;
+  uint8_t target_brightness_ = 255U;
+  /* 本帧所有目标值低 8 bit 的按位或, 非 0 表示存在需要抖动的小数. */
+  uint8_t fraction_ = 0U;
+  uint16_t target_[256] = {};
+};
+
+}  // namespace platform
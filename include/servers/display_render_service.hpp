@@ -0,0 +1,485 @@
+/**
+ * @file display_render_service.hpp
+ * @brief 异步显示渲染服务声明：命令队列 + 光栅化线程 + 双条带缓冲发送线程。
+ */
+
+#pragma once
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+
+#include <cstdint>
+
+#include "platform/display_raster.hpp"
+#include "platform/ilogger.hpp"
+#include "platform/platform_display.hpp"
+#include "platform/rle_image.hpp"
+
+namespace servers {
+
+/**
+ * @brief 异步显示渲染服务。
+ * @note 服务启动后独占底层面板：调用方的绘制接口只把命令放入有界队列并立即返回，
+ *       光栅化线程把命令合成到两个条带缓冲之一，发送线程同时把另一个条带经 SPI(DMA)
+ *       写入面板。调用方通过 fence 获知此前提交的命令何时真正落到屏幕上。
+ */
+class DisplayRenderService final : public platform::IDisplay {
+ public:
+  /**
+   * @brief 构造渲染服务。
+   * @param log 日志接口引用，必须在服务生命周期内保持有效。
+   * @param panel 被独占的底层显示实例，默认使用全局实例。
+   */
+  explicit DisplayRenderService(platform::ILogger& log,
+                                platform::IDisplay& panel = platform::display())
+      : log_(log), panel_(panel) {}
+
+  /**
+   * @brief 启动光栅化与发送线程（幂等）。
+   * @return 0 表示成功或已在运行；负值表示失败。
+   */
+  int run() noexcept;
+
+  /**
+   * @brief 请求停止服务线程。
+   * @note 仅发出停止请求，不阻塞等待线程退出；队列中未处理的命令被丢弃。
+   */
+  void stop() noexcept;
+
+  /**
+   * @brief 提交一个 fence，标记此前提交的全部命令。
+   * @param[out] out_seq fence 序号，用于 wait_fence/fence_done。
+   * @return 0 表示成功；-EAGAIN 表示队列已满；-ENODEV 表示服务未运行。
+   * @note 保留模式下尚未 flush 的内容不在 fence 覆盖范围内。
+   */
+  int submit_fence(uint32_t& out_seq) noexcept;
+
+  /**
+   * @brief 查询 fence 是否已完成。
+   * @param seq submit_fence 返回的序号。
+   * @return true 表示该 fence 之前的命令已全部写入面板。
+   */
+  bool fence_done(uint32_t seq) noexcept;
+
+  /**
+   * @brief 等待 fence 完成。
+   * @param seq submit_fence 返回的序号。
+   * @param timeout_ms 最长等待时间（毫秒），必须大于 0。
+   * @return 0 表示已完成；-ETIMEDOUT 表示超时；-EINVAL 表示参数非法。
+   */
+  int wait_fence(uint32_t seq, int64_t timeout_ms) noexcept;
+
+  /**
+   * @brief 初始化底层面板。
+   * @return 0 表示成功；负值表示失败。
+   */
+  int init() noexcept override;
+
+  /**
+   * @brief 获取屏幕宽度（像素）。
+   * @return 屏幕宽度。
+   */
+  uint16_t width() const noexcept override { return panel_.width(); }
+
+  /**
+   * @brief 获取屏幕高度（像素）。
+   * @return 屏幕高度。
+   */
+  uint16_t height() const noexcept override { return panel_.height(); }
+
+  /**
+   * @brief 异步清屏。
+   * @param color_rgb565 RGB565 颜色值。
+   * @return 0 表示已入队；-EAGAIN 表示队列已满。
+   */
+  int clear(uint16_t color_rgb565) noexcept override;
+
+  /**
+   * @brief 异步填充矩形。
+   * @return 0 表示已入队；-EAGAIN 表示队列已满。
+   */
+  int fill_rect(uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+                uint16_t color_rgb565) noexcept override;
+
+  /**
+   * @brief 异步绘制直线。
+   * @return 0 表示已入队；-EAGAIN 表示队列已满。
+   * @note 图元在渲染线程内光栅化为单色矩形，逐个经条带缓冲下发；保留模式下先下发已记录内容。
+   */
+  int draw_line(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                uint16_t color_rgb565) noexcept override;
+
+  /**
+   * @brief 异步绘制圆或实心圆。
+   * @return 0 表示已入队；-EAGAIN 表示队列已满。
+   */
+  int draw_circle(int16_t cx, int16_t cy, uint16_t r, uint16_t color_rgb565,
+                  bool filled) noexcept override;
+
+  /**
+   * @brief 异步绘制圆角矩形或实心圆角矩形。
+   * @return 0 表示已入队；-EAGAIN 表示队列已满。
+   */
+  int draw_round_rect(int16_t x, int16_t y, uint16_t w, uint16_t h, uint16_t r,
+                      uint16_t color_rgb565, bool filled) noexcept override;
+
+  /**
+   * @brief 异步绘制单个字符。
+   * @return 0 表示已入队；-EAGAIN 表示队列已满。
+   */
+  int draw_char(uint16_t x, uint16_t y, char c, uint16_t fg_rgb565, uint16_t bg_rgb565,
+                uint8_t scale) noexcept override;
+
+  /**
+   * @brief 异步绘制字符串。
+   * @return 0 表示已入队；-EAGAIN 表示队列空间不足以容纳整段文本；-E2BIG 表示分段后的
+   *         命令条数超过 kCommandQueueDepth，队列全空也放不下。
+   * @note 文本被复制进命令，调用返回后即可复用缓冲；长行按 kMaxInlineText 字节分段，
+   *       启用中文字库时不会从 UTF-8 字符中间切开。空间不足时整段丢弃，不会只入队一半。
+   */
+  int draw_text(uint16_t x, uint16_t y, const char* text, uint16_t fg_rgb565, uint16_t bg_rgb565,
+                uint8_t scale) noexcept override;
+
+  /**
+   * @brief 异步绘制有符号整数。
+   * @return 0 表示已入队；-EAGAIN 表示队列已满。
+   */
+  int draw_int(uint16_t x, uint16_t y, int32_t value, uint16_t fg_rgb565, uint16_t bg_rgb565,
+               uint8_t scale) noexcept override;
+
+  /**
+   * @brief 异步写入像素块。
+   * @return 0 表示已入队；-EAGAIN 表示队列空间不足；-EINVAL 表示参数非法；
+   *         -E2BIG 表示块所需命令条数超过 kCommandQueueDepth。
+   * @note 像素被复制进命令（每条命令最多 kMaxInlinePixels 个像素，按行分段），单次 blit
+   *       最多 kCommandQueueDepth 条命令：宽度不超过 kMaxInlinePixels 时约
+   *       kCommandQueueDepth * kMaxInlinePixels 个像素（如 32x24），更大的图像请分块
+   *       blit 或使用 draw_image。空间不足时整块丢弃，不会只入队一半。
+   */
+  int blit(uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+           const uint16_t* pixels) noexcept override;
+
+  /**
+   * @brief 异步绘制外置 SPI Flash 中的 RLE 图像。
+   * @return 0 表示已入队；-EAGAIN 表示队列已满；-EINVAL 表示起点越界。
+   * @note 解码在渲染线程内按条带进行，与发送线程的 SPI 写入流水并行；
+   *       资源头非法或数据损坏时记录错误日志。
+   */
+  int draw_image(uint16_t x, uint16_t y, uint32_t flash_offset) noexcept override;
+
+  /**
+   * @brief 在渲染线程排空流水线后同步绘制启动画面。
+   * @return 0 表示已入队；-EAGAIN 表示队列已满。
+   */
+  int show_boot_screen() noexcept override;
+
+  /**
+   * @brief 异步切换绘制模式（保留模式下命令在渲染线程内合并，flush 时统一发送）。
+   * @param mode 目标模式。
+   * @return 0 表示已入队；-EAGAIN 表示队列已满；-ENOTSUP 表示不支持该模式。
+   */
+  int set_mode(platform::DisplayMode mode) noexcept override;
+
+  /**
+   * @brief 获取最近一次请求的绘制模式。
+   * @return 绘制模式。
+   */
+  platform::DisplayMode mode() const noexcept override { return requested_mode_; }
+
+  /**
+   * @brief 异步下发保留模式下记录的内容。
+   * @return 0 表示已入队；-EAGAIN 表示队列已满。
+   */
+  int flush() noexcept override;
+
+  /**
+   * @brief 获取底层面板的背光接口。
+   * @return IBacklight 引用。
+   */
+  platform::IBacklight& backlight() noexcept override { return panel_.backlight(); }
+
+ private:
+  /** @brief 光栅化线程栈大小（字节）。 */
+  static constexpr size_t kRenderStackSize = 1536;
+  /** @brief 发送线程栈大小（字节）。 */
+  static constexpr size_t kTxStackSize = 1024;
+  /** @brief 光栅化线程优先级。 */
+  static constexpr int kRenderPriority = K_LOWEST_APPLICATION_THREAD_PRIO;
+  /** @brief 发送线程优先级：高于光栅化线程，SPI 传输结束后尽快衔接下一条带。 */
+  static constexpr int kTxPriority = K_LOWEST_APPLICATION_THREAD_PRIO - 1;
+  /** @brief 命令队列深度（条）。 */
+  static constexpr size_t kCommandQueueDepth = 24;
+  /** @brief 发送队列深度（条），需大于条带缓冲个数以容纳 fence。 */
+  static constexpr size_t kTxQueueDepth = 8;
+  /** @brief 线程轮询停止标志的周期（毫秒）。 */
+  static constexpr int32_t kPollPeriodMs = 200;
+  /** @brief 单条命令内联负载大小（字节）。 */
+  static constexpr size_t kInlinePayloadBytes = 64;
+  /** @brief 单条文本命令内联的最大字符数。 */
+  static constexpr size_t kMaxInlineText = kInlinePayloadBytes;
+  /** @brief 单条像素块命令内联的最大像素数。 */
+  static constexpr size_t kMaxInlinePixels = kInlinePayloadBytes / sizeof(uint16_t);
+  /** @brief 条带缓冲宽度上限（像素）。 */
+  static constexpr uint16_t kStripWidth = 320U;
+  /** @brief 每个条带缓冲的行数。 */
+  static constexpr uint16_t kStripRows = 8U;
+  /** @brief 每个条带缓冲的像素数。 */
+  static constexpr size_t kStripPixels = static_cast<size_t>(kStripWidth) * kStripRows;
+  /** @brief 乒乓条带缓冲个数。 */
+  static constexpr size_t kStripBufferCount = 2;
+
+  /**
+   * @brief 渲染命令类型。
+   */
+  enum class CommandType : uint8_t {
+    kFill,
+    kText,
+    /* 按 UTF-8 行高排版的文本段：同一段文本的每个分段都走 CJK 光栅化，纯 ASCII 段亦然。 */
+    kUtf8Text,
+    kBlit,
+    kSetMode,
+    kFlush,
+    kFence,
+    kBootScreen,
+    kImage,
+    kShape,
+  };
+
+  /**
+   * @brief 图元种类。
+   */
+  enum class ShapeKind : uint8_t {
+    kLine,
+    kCircle,
+    kRoundRect,
+  };
+
+  /**
+   * @brief 图元命令参数。
+   * @note 直线使用 (x0, y0)-(x1, y1)；圆以 (x0, y0) 为圆心；圆角矩形以 (x0, y0) 为左上角、
+   *       w/h 为尺寸。
+   */
+  struct ShapeParams {
+    ShapeKind kind;
+    bool filled;
+    int16_t x0;
+    int16_t y0;
+    int16_t x1;
+    int16_t y1;
+    uint16_t w;
+    uint16_t h;
+    uint16_t r;
+  };
+
+  /**
+   * @brief 队列中的渲染命令，文本与像素按值内联，调用方无需保持缓冲有效。
+   */
+  struct Command {
+    CommandType type = CommandType::kFill;
+    uint8_t scale = 1U;
+    platform::DisplayMode mode = platform::DisplayMode::kImmediate;
+    uint16_t x = 0U;
+    uint16_t y = 0U;
+    uint16_t w = 0U;
+    uint16_t h = 0U;
+    uint16_t fg_rgb565 = 0U;
+    uint16_t bg_rgb565 = 0U;
+    uint32_t seq = 0U;
+    uint32_t flash_offset = 0U;
+    union {
+      char text[kMaxInlineText];
+      uint16_t pixels[kMaxInlinePixels];
+      ShapeParams shape;
+    } payload{};
+  };
+
+  /**
+   * @brief 图元光栅化上下文，作为 shape_sink 的 user 参数。
+   */
+  struct ShapeJob {
+    DisplayRenderService* service;
+    uint16_t color_rgb565;
+  };
+
+  /**
+   * @brief 发送线程任务：一个待写入的条带或一个 fence。
+   */
+  struct TxJob {
+    bool fence = false;
+    uint8_t buffer = 0U;
+    uint32_t seq = 0U;
+    platform::raster::Rect region{};
+  };
+
+  /**
+   * @brief 光栅化线程入口静态适配函数。
+   * @param p1 DisplayRenderService 对象指针。
+   * @param p2 未使用。
+   * @param p3 未使用。
+   */
+  static void renderThreadEntry(void* p1, void* p2, void* p3);
+
+  /**
+   * @brief 发送线程入口静态适配函数。
+   * @param p1 DisplayRenderService 对象指针。
+   * @param p2 未使用。
+   * @param p3 未使用。
+   */
+  static void txThreadEntry(void* p1, void* p2, void* p3);
+
+  /**
+   * @brief 光栅化线程主循环：取命令、合成条带、交给发送线程。
+   */
+  void render_loop() noexcept;
+
+  /**
+   * @brief 发送线程主循环：把条带写入面板并归还缓冲，推进 fence。
+   */
+  void tx_loop() noexcept;
+
+  /**
+   * @brief 以非阻塞方式把命令放入队列。
+   * @param cmd 命令。
+   * @return 0 表示成功；-EAGAIN 队列已满；-ENODEV 服务未运行。
+   */
+  int enqueue(const Command& cmd) noexcept;
+
+  /**
+   * @brief 在渲染线程内处理一条命令。
+   * @param cmd 命令。
+   */
+  void handle_command(const Command& cmd) noexcept;
+
+  /**
+   * @brief 把填充/文本命令记录进显示列表，立即模式下随即渲染。
+   * @param cmd 命令。
+   */
+  void record_command(const Command& cmd) noexcept;
+
+  /**
+   * @brief 把显示列表按脏矩形切成条带，逐条带光栅化并交给发送线程。
+   */
+  void render_list() noexcept;
+
+  /**
+   * @brief 逐条带解码 RLE 图像并交给发送线程。
+   * @param cmd 图像命令。
+   * @return 0 表示成功；负值表示资源或 Flash 读取错误，或服务正在停止。
+   */
+  int render_image(const Command& cmd) noexcept;
+
+  /**
+   * @brief 光栅化图元命令，把得到的每个单色矩形按条带交给发送线程。
+   * @param cmd 图元命令。
+   * @return 0 表示成功；-ECANCELED 表示服务正在停止。
+   */
+  int render_shape(const Command& cmd) noexcept;
+
+  /**
+   * @brief 图元光栅化的矩形输出（RectSink）。
+   * @param rect 已裁剪到屏幕内的矩形。
+   * @param user ShapeJob 指针。
+   * @return 0 表示成功；-ECANCELED 表示服务正在停止。
+   */
+  static int shape_sink(const platform::raster::Rect& rect, void* user);
+
+  /**
+   * @brief 以单色填充一个矩形：按条带填充颜色后交给发送线程。
+   * @param rect 已裁剪到屏幕内的矩形。
+   * @param color_rgb565 RGB565 颜色值。
+   * @return 0 表示成功；-ECANCELED 表示服务正在停止。
+   */
+  int render_solid(const platform::raster::Rect& rect, uint16_t color_rgb565) noexcept;
+
+#if defined(CONFIG_SKY_BOARD_CJK_FONT)
+  /**
+   * @brief 逐条带光栅化含多字节字符的 UTF-8 文本命令并交给发送线程。
+   * @param cmd 文本命令。
+   * @return 0 表示成功；-ECANCELED 表示服务正在停止。
+   */
+  int render_utf8_text(const Command& cmd) noexcept;
+#endif
+
+  /**
+   * @brief 获取一个空闲条带缓冲（两块都在发送中时阻塞）。
+   * @param[out] out_index 缓冲下标。
+   * @return 0 表示成功；-ECANCELED 表示服务正在停止。
+   */
+  int acquire_strip(uint8_t& out_index) noexcept;
+
+  /**
+   * @brief 把任务交给发送线程（发送队列满时阻塞）。
+   * @param job 发送任务。
+   * @return 0 表示成功；-ECANCELED 表示服务正在停止。
+   */
+  int post_tx(const TxJob& job) noexcept;
+
+  /**
+   * @brief 等待发送线程写完全部已提交的条带。
+   * @return 0 表示成功；-ECANCELED 表示服务正在停止。
+   */
+  int drain_pipeline() noexcept;
+
+  /**
+   * @brief 服务线程退出时调用，最后一个退出的线程清除运行标志。
+   * @param name 线程名，用于日志。
+   */
+  void on_thread_exit(const char* name) noexcept;
+
+  /** @brief 日志接口。 */
+  platform::ILogger& log_;
+  /** @brief 被独占的底层面板。 */
+  platform::IDisplay& panel_;
+  /** @brief 光栅化线程控制块。 */
+  struct k_thread render_thread_;
+  /** @brief 发送线程控制块。 */
+  struct k_thread tx_thread_;
+  /** @brief 光栅化线程栈。 */
+  K_KERNEL_STACK_MEMBER(render_stack_, kRenderStackSize);
+  /** @brief 发送线程栈。 */
+  K_KERNEL_STACK_MEMBER(tx_stack_, kTxStackSize);
+  /** @brief 运行状态标志：1 运行中，0 未运行。 */
+  atomic_t running_ = ATOMIC_INIT(0);
+  /** @brief 停止请求标志：1 请求停止，0 继续运行。 */
+  atomic_t stop_requested_ = ATOMIC_INIT(0);
+  /** @brief 仍在运行的服务线程数，归零时清除 running_。 */
+  atomic_t live_threads_ = ATOMIC_INIT(0);
+  /** @brief 命令队列及其存储。 */
+  struct k_msgq cmd_q_{};
+  alignas(4) char cmd_q_buf_[sizeof(Command) * kCommandQueueDepth]{};
+  /** @brief 发送队列及其存储。 */
+  struct k_msgq tx_q_{};
+  alignas(4) char tx_q_buf_[sizeof(TxJob) * kTxQueueDepth]{};
+  /** @brief 空闲条带缓冲计数信号量。 */
+  struct k_sem free_strips_{};
+  /** @brief 乒乓条带缓冲，仅由持有对应信号量份额的线程访问。 */
+  alignas(4) uint16_t strips_[kStripBufferCount][kStripPixels]{};
+  /** @brief 下一个分配的条带缓冲下标（仅光栅化线程访问）。 */
+  uint8_t next_strip_ = 0U;
+  /** @brief 保护 completed_fence_ 的互斥锁。 */
+  struct k_mutex fence_mutex_{};
+  /** @brief 串行化入队的互斥锁（可重入）：多命令绘制在其内统计空位并整体入队。 */
+  struct k_mutex enqueue_mutex_{};
+  /** @brief fence 完成通知条件变量。 */
+  struct k_condvar fence_cond_{};
+  /** @brief 最近分配的 fence 序号。 */
+  atomic_t fence_seq_ = ATOMIC_INIT(0);
+  /** @brief 最近完成的 fence 序号，受 fence_mutex_ 保护。 */
+  uint32_t completed_fence_ = 0U;
+  /** @brief 面板宽度缓存（run() 时读取）。 */
+  uint16_t width_ = 0U;
+  /** @brief 面板高度缓存（run() 时读取）。 */
+  uint16_t height_ = 0U;
+  /** @brief 调用方最近请求的绘制模式。 */
+  platform::DisplayMode requested_mode_ = platform::DisplayMode::kImmediate;
+  /** @brief 渲染线程当前生效的绘制模式（仅光栅化线程访问）。 */
+  platform::DisplayMode mode_ = platform::DisplayMode::kImmediate;
+  /** @brief 渲染线程使用的显示列表（仅光栅化线程访问）。 */
+  platform::raster::DisplayList list_{};
+  /** @brief 图像资源流式解码器（仅光栅化线程访问）。 */
+  platform::raster::RleImageReader image_reader_{};
+  /** @brief 面板写入连续失败计数（仅发送线程访问）。 */
+  uint32_t tx_error_streak_ = 0U;
+};
+
+}  // namespace servers
@@ -0,0 +1,157 @@
+/**
+ * @file display_service.hpp
+ * @brief 仪表盘显示服务声明：周期刷新 INA226/AHT20/编码器/按键字段，仅重绘变化的字形；
+ *        底部以滚动曲线显示 INA226 电流历史。
+ */
+
+#pragma once
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#include "platform/idisplay.hpp"
+#include "platform/ilogger.hpp"
+#include "platform/sparkline.hpp"
+#include "servers/encoder_service.hpp"
+#include "servers/sensor_service.hpp"
+
+namespace servers {
+
+/**
+ * @brief 仪表盘显示服务。
+ * @note 首次刷新绘制标题与标签，之后每个周期只比较各字段的新旧字符串，
+ *       把变化的字符连续段交给显示接口重绘；整屏不再重复刷新。
+ */
+class DisplayService {
+ public:
+  /**
+   * @brief 构造仪表盘服务。
+   * @param log 日志接口引用。
+   * @param display 显示接口（通常为异步渲染服务）。
+   * @param sensors 传感器服务。
+   * @param encoder 编码器服务。
+   * @note 所有引用必须在服务生命周期内保持有效；按键状态直接读取平台按键电平。
+   */
+  DisplayService(platform::ILogger& log, platform::IDisplay& display, SensorService& sensors,
+                 EncoderService& encoder)
+      : log_(log), display_(display), sensors_(sensors), encoder_(encoder) {}
+
+  /**
+   * @brief 启动服务线程（幂等）。
+   * @return 0 表示成功或已在运行；负值表示启动失败。
+   */
+  int run() noexcept;
+
+  /**
+   * @brief 请求停止服务线程。
+   * @note 仅发出停止请求，不阻塞等待线程退出。
+   */
+  void stop() noexcept;
+
+ private:
+  /** @brief 服务线程栈大小（字节）。 */
+  static constexpr size_t kStackSize = 2048;
+  /** @brief 服务线程优先级。 */
+  static constexpr int kPriority = K_LOWEST_APPLICATION_THREAD_PRIO;
+  /** @brief 刷新周期（毫秒），兼顾编码器/按键的响应速度。 */
+  static constexpr int64_t kRefreshPeriodMs = 200;
+  /** @brief 字段值的固定字符宽度（右对齐，不足补空格）。 */
+  static constexpr size_t kFieldChars = 10;
+  /** @brief 两个变化段之间不超过该字符数时合并为一次绘制。 */
+  static constexpr size_t kRunMergeGap = 1;
+
+  /**
+   * @brief 仪表盘字段下标。
+   */
+  enum Field : uint8_t {
+    kBusVoltage = 0,
+    kCurrent,
+    kPower,
+    kTemperature,
+    kHumidity,
+    kEncoderCount,
+    kButtons,
+    kFieldCount,
+  };
+
+  /**
+   * @brief 单个字段的屏幕状态。
+   */
+  struct FieldState {
+    /** @brief 屏幕上当前显示的字符串（固定 kFieldChars 个字符）。 */
+    char shown[kFieldChars + 1] = {};
+    /** @brief shown 是否与屏幕一致；为 false 时下次整字段重绘。 */
+    bool valid = false;
+  };
+
+  /**
+   * @brief 线程入口静态适配函数。
+   * @param p1 DisplayService 对象指针。
+   * @param p2 未使用。
+   * @param p3 未使用。
+   */
+  static void threadEntry(void* p1, void* p2, void* p3);
+
+  /**
+   * @brief 服务线程主循环。
+   */
+  void threads() noexcept;
+
+  /**
+   * @brief 清屏并绘制标题、分隔线与字段标签。
+   * @return 0 表示成功；负值表示失败。
+   */
+  int draw_static_layout() noexcept;
+
+  /**
+   * @brief 采集全部数据源并刷新各字段。
+   */
+  void refresh() noexcept;
+
+  /**
+   * @brief 把字段格式化结果与屏幕内容比较，只重绘变化的字符段。
+   * @param field 字段下标。
+   * @param text 新的字段文本（不超过 kFieldChars 个字符，右对齐显示）。
+   */
+  void update_field(Field field, const char* text) noexcept;
+
+  /**
+   * @brief 把新的 INA226 电流样本追加到曲线（同一样本只追加一次）。
+   * @param sample INA226 样本。
+   */
+  void update_chart(const platform::Ina226Sample& sample) noexcept;
+
+  /** @brief 日志接口。 */
+  platform::ILogger& log_;
+  /** @brief 显示接口。 */
+  platform::IDisplay& display_;
+  /** @brief 传感器服务。 */
+  SensorService& sensors_;
+  /** @brief 编码器服务。 */
+  EncoderService& encoder_;
+  /** @brief Zephyr 线程控制块。 */
+  struct k_thread thread_;
+  /** @brief Zephyr 线程栈。 */
+  K_KERNEL_STACK_MEMBER(stack_, kStackSize);
+  /** @brief 线程 ID，未运行时为 nullptr。 */
+  k_tid_t thread_id_ = nullptr;
+  /** @brief 运行状态标志：1 运行中，0 未运行。 */
+  atomic_t running_ = ATOMIC_INIT(0);
+  /** @brief 停止请求标志：1 请求停止，0 继续运行。 */
+  atomic_t stop_requested_ = ATOMIC_INIT(0);
+  /** @brief 各字段屏幕状态（仅服务线程访问）。 */
+  FieldState fields_[kFieldCount] = {};
+  /** @brief INA226 电流曲线。 */
+  platform::SparklineChart chart_{};
+  /** @brief 最近一次追加到曲线的样本时间戳，-1 表示尚未追加。 */
+  int64_t chart_ts_ms_ = -1;
+  /** @brief 静态布局是否已绘制。 */
+  bool layout_drawn_ = false;
+  /** @brief 显示写入连续失败计数。 */
+  uint32_t error_streak_ = 0U;
+};
+
+}  // namespace servers
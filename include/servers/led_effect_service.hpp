@@ -0,0 +1,140 @@
+/**
+ * @file led_effect_service.hpp
+ * @brief WS2812 灯效服务声明：固定帧周期调度灯效注册表中的效果，统计跳帧。
+ */
+
+#pragma once
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#include "platform/ilogger.hpp"
+#include "platform/platform_ws2812.hpp"
+#include "servers/sensor_service.hpp"
+
+namespace servers {
+
+/**
+ * @brief 灯效运行统计。
+ */
+struct LedEffectStats {
+  /** @brief 已渲染的帧数。 */
+  uint32_t frames = 0U;
+  /** @brief 因调度延迟或灯带仍在发送而跳过的帧数。 */
+  uint32_t skipped = 0U;
+};
+
+/**
+ * @brief WS2812 灯效服务。
+ * @note 不占用独立线程：帧由系统工作队列上的 k_work_delayable 按绝对截止时间调度，
+ *       帧率不随编码与 DMA 耗时漂移；错过的帧直接跳过并计数，动画按时间推进不变慢。
+ *       每帧经 show_async 提交，发送由 WS2812 驱动的 DMA 中断完成。
+ */
+class LedEffectService {
+ public:
+  /**
+   * @brief 构造灯效服务。
+   * @param log 日志接口引用。
+   * @param sensors 传感器服务，供传感器映射类灯效读取最新样本。
+   * @param ws WS2812 驱动，默认使用全局实例。
+   * @note 所有引用必须在服务生命周期内保持有效。
+   */
+  LedEffectService(platform::ILogger& log, SensorService& sensors,
+                   platform::IWs2812& ws = platform::ws2812())
+      : log_(log), sensors_(sensors), ws_(ws) {}
+
+  /**
+   * @brief 开始调度灯效帧（幂等）。
+   * @return 0 表示成功或已在运行；负值表示启动失败。
+   */
+  int run() noexcept;
+
+  /**
+   * @brief 请求停止调度。
+   * @note 取消尚未执行的帧；正在执行的帧结束后不再重新调度。
+   */
+  void stop() noexcept;
+
+  /**
+   * @brief 切换当前灯效。
+   * @param index 灯效下标，范围 [0, effect_count())。
+   * @return 0 表示成功；-EINVAL 表示下标越界。
+   */
+  int set_effect(size_t index) noexcept;
+
+  /**
+   * @brief 获取注册的灯效个数。
+   * @return 灯效个数。
+   */
+  static size_t effect_count() noexcept;
+
+  /**
+   * @brief 获取灯效名称。
+   * @param index 灯效下标。
+   * @return 灯效名称；越界时返回 nullptr。
+   */
+  static const char* effect_name(size_t index) noexcept;
+
+  /**
+   * @brief 读取运行统计。
+   * @param out 输出统计。
+   */
+  void get_stats(LedEffectStats& out) const noexcept;
+
+ private:
+  /** @brief 跳帧统计的日志周期（毫秒），期间没有新增跳帧时不输出。 */
+  static constexpr int64_t kStatsLogPeriodMs = 60000;
+
+  /**
+   * @brief 帧工作项回调。
+   * @param work 工作项。
+   */
+  static void workHandler(struct k_work* work);
+
+  /**
+   * @brief 渲染并提交一帧，然后按绝对截止时间调度下一帧。
+   */
+  void frame() noexcept;
+
+  /** @brief 日志接口。 */
+  platform::ILogger& log_;
+  /** @brief 传感器服务。 */
+  SensorService& sensors_;
+  /** @brief WS2812 驱动。 */
+  platform::IWs2812& ws_;
+  /**
+   * @brief 帧工作项及其所属服务（标准布局，供回调经 CONTAINER_OF 找回服务对象）。
+   */
+  struct FrameWork {
+    struct k_work_delayable work;
+    LedEffectService* owner;
+  };
+
+  /** @brief 帧工作项。 */
+  FrameWork work_{{}, this};
+  /** @brief 运行状态标志：1 运行中，0 未运行。 */
+  atomic_t running_ = ATOMIC_INIT(0);
+  /** @brief 停止请求标志：1 请求停止，0 继续运行。 */
+  atomic_t stop_requested_ = ATOMIC_INIT(0);
+  /** @brief 当前灯效下标。 */
+  atomic_t effect_ = ATOMIC_INIT(0);
+  /** @brief 下一帧的截止时间（系统 tick）。 */
+  int64_t next_tick_ = 0;
+  /** @brief 动画帧号，跳帧时同样推进。 */
+  uint32_t frame_index_ = 0U;
+  /** @brief 已渲染的帧数。 */
+  atomic_t frames_ = ATOMIC_INIT(0);
+  /** @brief 跳过的帧数。 */
+  atomic_t skipped_ = ATOMIC_INIT(0);
+  /** @brief 帧提交或发送连续失败计数。 */
+  uint32_t error_streak_ = 0U;
+  /** @brief 上次日志输出时的跳帧数。 */
+  uint32_t logged_skipped_ = 0U;
+  /** @brief 下一次允许输出统计日志的时间点。 */
+  int64_t next_log_ms_ = 0;
+};
+
+}  // namespace servers
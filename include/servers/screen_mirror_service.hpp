@@ -0,0 +1,57 @@
+/**
+ * @file screen_mirror_service.hpp
+ * @brief 屏幕镜像服务声明：通过 TCP 推送显示层写入的行增量 + RLE 记录流。
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "platform/idisplay.hpp"
+#include "platform/ilogger.hpp"
+#include "servers/tcp_service.hpp"
+
+#if defined(CONFIG_SKY_BOARD_SCREEN_MIRROR)
+
+namespace servers {
+
+/**
+ * @brief 屏幕镜像服务。
+ * @note 监听 CONFIG_SKY_BOARD_SCREEN_MIRROR_PORT，同一时刻服务一个客户端。客户端接入后开始捕获
+ *       并请求仪表盘整屏重绘，此后只推送显示层实际写入的行，画面静止时不产生流量。
+ *       记录格式见 platform/screen_capture.hpp，PC 端可用 scripts/screen_mirror.py 查看。
+ */
+class ScreenMirrorService final : public TcpService {
+ public:
+  /**
+   * @brief 构造屏幕镜像服务。
+   * @param log 日志接口引用，必须在服务生命周期内保持有效。
+   * @param display 被镜像的显示设备，用于取得分辨率。
+   */
+  ScreenMirrorService(platform::ILogger& log, platform::IDisplay& display)
+      : TcpService(log, CONFIG_SKY_BOARD_SCREEN_MIRROR_PORT, "screen_mirror"),
+        display_(display) {}
+
+ protected:
+  /**
+   * @brief 镜像会话：开始捕获并持续发送记录流，直到客户端断开或请求停止。
+   * @param client_fd 客户端 socket。
+   */
+  void serve(int client_fd) noexcept override;
+
+ private:
+  /** @brief 单次发送的最大字节数。 */
+  static constexpr size_t kChunkBytes = 1024U;
+  /** @brief 记录流为空时的等待时间（毫秒），期间探测客户端是否断开。 */
+  static constexpr int32_t kIdleWaitMs = 200;
+
+  /** @brief 被镜像的显示设备。 */
+  platform::IDisplay& display_;
+  /** @brief 发送缓冲。 */
+  uint8_t chunk_[kChunkBytes]{};
+};
+
+}  // namespace servers
+
+#endif  // CONFIG_SKY_BOARD_SCREEN_MIRROR
@@ -15,6 +15,7 @@ namespace servers {
 /**
  * @brief TCP 回传服务。
  * @note 服务运行在独立线程中，监听 0.0.0.0:8000，收到的数据会原样回传。
+ *       派生类可指定端口并重写 serve() 提供其他单连接 TCP 服务，监听与接入逻辑复用本类。
  */
 class TcpService {
  public:
@@ -22,7 +23,9 @@ class TcpService {
    * @brief 构造 TCP 回传服务。
    * @param log 日志接口引用，必须在服务生命周期内保持有效。
    */
-  explicit TcpService(platform::ILogger& log) : log_(log) {}
+  explicit TcpService(platform::ILogger& log) : TcpService(log, kListenPort, "tcp_service") {}
+
+  virtual ~TcpService() = default;
 
   /**
    * @brief 启动服务线程（幂等）。
@@ -36,12 +39,47 @@ class TcpService {
    */
   void stop() noexcept;
 
+ protected:
+  /**
+   * @brief 构造监听指定端口的 TCP 服务。
+   * @param log 日志接口引用，必须在服务生命周期内保持有效。
+   * @param port 监听端口。
+   * @param name 线程名，同时用作日志前缀。
+   */
+  TcpService(platform::ILogger& log, uint16_t port, const char* name)
+      : log_(log), port_(port), name_(name) {}
+
+  /**
+   * @brief 服务一个已接入的客户端，返回后连接被关闭。
+   * @param client_fd 客户端 socket，收发超时均为 1 秒。
+   * @note 默认实现原样回传收到的数据；实现须周期检查 stop_requested()。
+   */
+  virtual void serve(int client_fd) noexcept;
+
+  /**
+   * @brief 查询是否已请求停止。
+   * @return true 表示应尽快返回。
+   */
+  bool stop_requested() const noexcept { return atomic_get(&stop_requested_) != 0; }
+
+  /**
+   * @brief 发送全部数据（处理短写与发送超时）。
+   * @param fd socket。
+   * @param data 数据。
+   * @param len 字节数。
+   * @return 0 成功；-ECANCELED 请求停止；其他负值为发送错误。
+   */
+  int send_all(int fd, const void* data, size_t len) noexcept;
+
+  /** @brief 日志接口。 */
+  platform::ILogger& log_;
+
  private:
   /** @brief 服务线程栈大小（字节）。 */
   static constexpr size_t kStackSize = 2048;
   /** @brief 服务线程优先级。 */
   static constexpr int kPriority = K_LOWEST_APPLICATION_THREAD_PRIO;
-  /** @brief TCP 监听端口。 */
+  /** @brief 回传服务监听端口。 */
   static constexpr uint16_t kListenPort = 8000U;
 
   /**
@@ -57,8 +95,10 @@ class TcpService {
    */
   void threads() noexcept;
 
-  /** @brief 日志接口。 */
-  platform::ILogger& log_;
+  /** @brief 监听端口。 */
+  uint16_t port_;
+  /** @brief 线程名与日志前缀。 */
+  const char* name_;
   /** @brief Zephyr 线程控制块。 */
   struct k_thread thread_;
   /** @brief Zephyr 线程栈。 */
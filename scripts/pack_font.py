@@ -0,0 +1,187 @@
+#!/usr/bin/env python3
+"""Pack a BDF bitmap font into the CJK font blob read by platform::raster::CjkFont.
+
+Layout (documented in include/platform/cjk_font.hpp, all little-endian):
+16-byte header, glyph_count 8-byte index entries sorted by codepoint, then one
+record per glyph: encoding byte, payload length byte, payload. Each glyph is
+stored either as raw 1bpp rows or as alternating 4-bit background/ink runs over
+the row-major bit stream, whichever is smaller (sparse strokes compress, dense
+glyphs fall back to raw). ASCII is skipped (the firmware draws it with the
+built-in 5x7 font). The blob is programmed into the external SPI NOR at the offset set by
+CONFIG_SKY_BOARD_CJK_FONT_OFFSET.
+
+Select glyphs with --chars (UTF-8 text files, e.g. the UI strings) and/or
+--range (e.g. 0x4E00-0x9FA5); without either, every non-ASCII glyph is packed.
+"""
+
+import argparse
+import struct
+import sys
+from pathlib import Path
+
+MAGIC = 0x31464B53  # "SKF1"
+ENC_RAW = 0
+ENC_RUNS = 1
+RUN_MAX = 15
+
+
+def parse_bdf(path):
+    """Return (font_bbx, {codepoint: (bbx, rows)}) with rows as MSB-first ints."""
+    font_bbx = None
+    glyphs = {}
+    code = bbx = None
+    rows = None
+    for line in path.read_text(encoding="latin-1").splitlines():
+        fields = line.split()
+        if not fields:
+            continue
+        key = fields[0]
+        if key == "FONTBOUNDINGBOX":
+            font_bbx = tuple(int(v) for v in fields[1:5])
+        elif key == "ENCODING":
+            code = int(fields[1])
+        elif key == "BBX":
+            bbx = tuple(int(v) for v in fields[1:5])
+        elif key == "BITMAP":
+            rows = []
+        elif key == "ENDCHAR":
+            if code is not None and code >= 0 and bbx is not None:
+                glyphs[code] = (bbx, rows or [])
+            code = bbx = rows = None
+        elif rows is not None:
+            rows.append(int(key, 16) >> (len(key) * 4 - bbx[0]))
+    if font_bbx is None:
+        sys.exit("error: %s has no FONTBOUNDINGBOX" % path)
+    return font_bbx, glyphs
+
+
+def render(font_bbx, glyph, size):
+    """Place a BDF glyph into a size x size cell; returns rows with bit0 leftmost."""
+    _, font_h, font_x, font_y = font_bbx
+    (w, h, x_off, y_off), bitmap = glyph
+    left = x_off - font_x
+    top = (font_h + font_y) - (h + y_off) - (font_h - size) // 2
+    cell = [0] * size
+    for r, bits in enumerate(bitmap):
+        y = top + r
+        if not 0 <= y < size:
+            continue
+        for c in range(w):
+            x = left + c
+            if 0 <= x < size and (bits >> (w - 1 - c)) & 1:
+                cell[y] |= 1 << x
+    return cell
+
+
+def encode_raw(cell, size):
+    row_bytes = (size + 7) // 8
+    return b"".join(row.to_bytes(row_bytes, "little") for row in cell)
+
+
+def encode_runs(cell, size):
+    bits = [(cell[p // size] >> (p % size)) & 1 for p in range(size * size)]
+    while bits and bits[-1] == 0:
+        bits.pop()  # trailing background is implicit
+    runs = []
+    colour = 0
+    i = 0
+    while i < len(bits):
+        n = 0
+        while i < len(bits) and bits[i] == colour and n < RUN_MAX:
+            n += 1
+            i += 1
+        runs.append(n)
+        if n == RUN_MAX and i < len(bits) and bits[i] == colour:
+            runs.append(0)  # longer run: continue after a zero-length run of the other colour
+        else:
+            colour ^= 1
+    runs += [0] * (len(runs) & 1)
+    return bytes((runs[k] << 4) | runs[k + 1] for k in range(0, len(runs), 2))
+
+
+def decode_record(record, size):
+    """Reference decoder mirroring CjkFont::load()."""
+    encoding, length = record[0], record[1]
+    payload = record[2:2 + length]
+    cell = [0] * size
+    if encoding == ENC_RAW:
+        row_bytes = (size + 7) // 8
+        return [int.from_bytes(payload[r * row_bytes:(r + 1) * row_bytes], "little")
+                for r in range(size)]
+    pos = 0
+    ink = False
+    for k in range(2 * len(payload)):
+        n = (payload[k // 2] >> 4) if k % 2 == 0 else (payload[k // 2] & 0x0F)
+        if ink:
+            for p in range(pos, pos + n):
+                cell[p // size] |= 1 << (p % size)
+        pos += n
+        ink = not ink
+    if pos > size * size:
+        raise ValueError("run overflow")
+    return cell
+
+
+def encode_glyph(cell, size):
+    raw = encode_raw(cell, size)
+    runs = encode_runs(cell, size)
+    if len(runs) < len(raw):
+        return bytes([ENC_RUNS, len(runs)]) + runs
+    return bytes([ENC_RAW, len(raw)]) + raw
+
+
+def parse_range(text):
+    lo, _, hi = text.partition("-")
+    return range(int(lo, 0), int(hi or lo, 0) + 1)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("bdf", type=Path, help="input BDF font")
+    parser.add_argument("-o", "--output", type=Path, required=True, help="output blob")
+    parser.add_argument("--size", type=int, default=16, choices=range(8, 17), metavar="8..16",
+                        help="glyph cell size, must match CONFIG_SKY_BOARD_CJK_FONT_SIZE")
+    parser.add_argument("--chars", type=Path, action="append", default=[],
+                        help="UTF-8 text file whose characters are packed (repeatable)")
+    parser.add_argument("--range", type=parse_range, action="append", default=[],
+                        help="codepoint range such as 0x4E00-0x9FA5 (repeatable)")
+    args = parser.parse_args()
+
+    font_bbx, glyphs = parse_bdf(args.bdf)
+    wanted = set()
+    for path in args.chars:
+        wanted.update(ord(ch) for ch in path.read_text(encoding="utf-8"))
+    for codes in args.range:
+        wanted.update(codes)
+    if not args.chars and not args.range:
+        wanted = set(glyphs)
+    codes = sorted(c for c in wanted if c >= 0x80 and c in glyphs)
+    missing = sorted(c for c in wanted if c >= 0x80 and c not in glyphs)
+    if not codes:
+        sys.exit("error: no glyphs selected")
+
+    index = bytearray()
+    records = bytearray()
+    records_base = 16 + 8 * len(codes)
+    raw_bytes = 0
+    for code in codes:
+        cell = render(font_bbx, glyphs[code], args.size)
+        record = encode_glyph(cell, args.size)
+        if decode_record(record, args.size) != cell:
+            sys.exit("error: round-trip mismatch for U+%04X" % code)
+        index += struct.pack("<II", code, records_base + len(records))
+        records += record
+        raw_bytes += 2 + len(encode_raw(cell, args.size))
+
+    total = records_base + len(records)
+    header = struct.pack("<IBBHII", MAGIC, args.size, args.size, 0, len(codes), total)
+    args.output.write_bytes(header + bytes(index) + bytes(records))
+    print("%d glyphs, %d bytes (glyph records %.1f%% of raw)" % (
+        len(codes), total, 100.0 * len(records) / raw_bytes))
+    if missing:
+        print("warning: %d requested characters not in font, e.g. %s" % (
+            len(missing), " ".join("U+%04X" % c for c in missing[:8])), file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,155 @@
+#!/usr/bin/env python3
+"""Pack PNG/BMP images into RLE image assets for IDisplay::draw_image().
+
+Each input becomes one asset (layout documented in include/platform/rle_image.hpp):
+16-byte little-endian header, optional RGB565 palette, then the RLE stream.
+Images with at most 16 distinct RGB565 colours are stored as 4bpp palette
+indices, everything else as RGB565. Assets are concatenated into one blob
+(each aligned to --align bytes) that is programmed into the external SPI NOR
+at --base; the offset table printed on stdout is what draw_image() expects.
+
+Requires Pillow (pip install pillow).
+"""
+
+import argparse
+import struct
+import sys
+from pathlib import Path
+
+MAGIC = 0x31494B53  # "SKI1"
+FORMAT_RGB565 = 0
+FORMAT_INDEXED4 = 1
+PALETTE_MAX = 16
+PACKET_MAX = 128
+
+
+def rgb565(r, g, b):
+    return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3)
+
+
+def load_pixels(path):
+    try:
+        from PIL import Image
+    except ImportError:
+        sys.exit("error: Pillow is required (pip install pillow)")
+    with Image.open(path) as img:
+        img = img.convert("RGB")
+        return img.width, img.height, [rgb565(*p) for p in img.getdata()]
+
+
+def packets(values):
+    """Split values into ('run', value, n) / ('lit', values) packets of at most 128."""
+    i = 0
+    count = len(values)
+    while i < count:
+        run = 1
+        while i + run < count and run < PACKET_MAX and values[i + run] == values[i]:
+            run += 1
+        if run >= 2:
+            yield "run", values[i], run
+            i += run
+            continue
+        start = i
+        while i < count and i - start < PACKET_MAX:
+            if i + 1 < count and values[i + 1] == values[i]:
+                break
+            i += 1
+        yield "lit", values[start:i], i - start
+
+
+def encode(values, indexed):
+    out = bytearray()
+    for kind, data, n in packets(values):
+        if kind == "run":
+            out.append(0x80 | (n - 1))
+            out += bytes([data]) if indexed else struct.pack("<H", data)
+            continue
+        out.append(n - 1)
+        if indexed:
+            padded = list(data) + [0] * (n & 1)
+            out += bytes((padded[k] << 4) | padded[k + 1] for k in range(0, n, 2))
+        else:
+            out += struct.pack("<%dH" % n, *data)
+    return bytes(out)
+
+
+def decode(blob, offset=0):
+    """Reference decoder mirroring RleImageReader; returns (width, height, pixels)."""
+    magic, width, height, fmt, palette_count, _, payload = struct.unpack_from(
+        "<IHHBBHI", blob, offset)
+    if magic != MAGIC:
+        raise ValueError("bad magic at 0x%X" % offset)
+    pos = offset + 16
+    palette = list(struct.unpack_from("<%dH" % palette_count, blob, pos))
+    pos += 2 * palette_count
+    end = pos + payload
+    pixels = []
+    while len(pixels) < width * height:
+        if pos >= end:
+            raise ValueError("truncated stream at 0x%X" % offset)
+        head = blob[pos]
+        pos += 1
+        n = (head & 0x7F) + 1
+        if head & 0x80:
+            if fmt == FORMAT_INDEXED4:
+                value = palette[blob[pos] & 0x0F]
+                pos += 1
+            else:
+                value = struct.unpack_from("<H", blob, pos)[0]
+                pos += 2
+            pixels += [value] * n
+        elif fmt == FORMAT_INDEXED4:
+            for k in range(n):
+                byte = blob[pos + k // 2]
+                pixels.append(palette[(byte >> 4) if k % 2 == 0 else (byte & 0x0F)])
+            pos += (n + 1) // 2
+        else:
+            pixels += struct.unpack_from("<%dH" % n, blob, pos)
+            pos += 2 * n
+    return width, height, pixels[:width * height]
+
+
+def pack(width, height, pixels, force_rgb565=False):
+    if not (0 < width <= 0xFFFF and 0 < height <= 0xFFFF):
+        raise ValueError("image size out of range")
+    colours = sorted(set(pixels))
+    indexed = not force_rgb565 and len(colours) <= PALETTE_MAX
+    if indexed:
+        lookup = {c: i for i, c in enumerate(colours)}
+        payload = encode([lookup[p] for p in pixels], True)
+        palette = struct.pack("<%dH" % len(colours), *colours)
+    else:
+        payload = encode(pixels, False)
+        palette = b""
+    header = struct.pack("<IHHBBHI", MAGIC, width, height,
+                         FORMAT_INDEXED4 if indexed else FORMAT_RGB565,
+                         len(colours) if indexed else 0, 0, len(payload))
+    return header + palette + payload
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("images", nargs="+", type=Path, help="input images")
+    parser.add_argument("-o", "--output", type=Path, required=True, help="output blob")
+    parser.add_argument("--base", type=lambda v: int(v, 0), default=0,
+                        help="flash offset the blob is programmed at (default 0)")
+    parser.add_argument("--align", type=int, default=4, help="asset alignment in bytes")
+    parser.add_argument("--rgb565", action="store_true", help="never use the 4bpp palette form")
+    args = parser.parse_args()
+
+    blob = bytearray()
+    for path in args.images:
+        blob += b"\xFF" * (-len(blob) % args.align)
+        width, height, pixels = load_pixels(path)
+        asset = pack(width, height, pixels, args.rgb565)
+        if decode(asset)[2] != pixels:
+            sys.exit("error: round-trip mismatch for %s" % path)
+        print("0x%08X %4dx%-4d %6d bytes (%4.1f%% of raw) %s" % (
+            args.base + len(blob), width, height, len(asset),
+            100.0 * len(asset) / (2 * width * height), path.name))
+        blob += asset
+    args.output.write_bytes(bytes(blob))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,153 @@
+#!/usr/bin/env python3
+"""Mirror the LCD of one or more boards running the screen mirror service.
+
+Connects to each HOST[:PORT] (CONFIG_SKY_BOARD_SCREEN_MIRROR_PORT, default
+8001), rebuilds the screen from the record stream and rewrites
+<out-dir>/<host>.ppm whenever the picture changed, at most once per
+--interval seconds. Any image viewer that reloads on change turns that into
+a live view. Disconnected boards are retried every few seconds.
+
+Stream format (documented in include/platform/screen_capture.hpp): 12-byte
+little-endian record headers <type, version, x, y, w, h, payload_bytes>.
+'H' starts a session (w x h screen), 'R' carries one RLE-compressed row that
+is repeated over h rows starting at (x, y), 'S' marks dropped records (the
+board repaints the whole screen right after). No third-party modules needed.
+"""
+
+import argparse
+import socket
+import struct
+import sys
+import threading
+import time
+from pathlib import Path
+
+HEADER = struct.Struct("<BBHHHHH")
+DEFAULT_PORT = 8001
+
+
+def decode_row(payload, width):
+    """Decode one row of RGB565 RLE packets (same packets as pack_image.py)."""
+    row = []
+    pos = 0
+    while len(row) < width:
+        head = payload[pos]
+        pos += 1
+        n = (head & 0x7F) + 1
+        if head & 0x80:
+            row += [struct.unpack_from("<H", payload, pos)[0]] * n
+            pos += 2
+        else:
+            row += struct.unpack_from("<%dH" % n, payload, pos)
+            pos += 2 * n
+    if len(row) != width or pos != len(payload):
+        raise ValueError("row payload does not match its width")
+    return row
+
+
+class Mirror:
+    """Screen state rebuilt from a record stream; feed() accepts arbitrary chunks."""
+
+    def __init__(self):
+        self.width = 0
+        self.height = 0
+        self.pixels = []
+        self.pending = b""
+        self.changed = False
+        self.resyncs = 0
+        self.bytes = 0
+
+    def feed(self, data):
+        self.bytes += len(data)
+        buf = self.pending + data
+        pos = 0
+        while len(buf) - pos >= HEADER.size:
+            kind, _, x, y, w, h, size = HEADER.unpack_from(buf, pos)
+            if len(buf) - pos < HEADER.size + size:
+                break
+            payload = buf[pos + HEADER.size:pos + HEADER.size + size]
+            pos += HEADER.size + size
+            self.apply(kind, x, y, w, h, payload)
+        self.pending = buf[pos:]
+
+    def apply(self, kind, x, y, w, h, payload):
+        if kind == ord("H"):
+            self.width, self.height = w, h
+            self.pixels = [[0] * w for _ in range(h)]
+            self.changed = True
+        elif kind == ord("S"):
+            self.resyncs += 1
+        elif kind == ord("R"):
+            row = decode_row(payload, w)
+            for yy in range(y, min(y + h, self.height)):
+                end = min(x + w, self.width)
+                self.pixels[yy][x:end] = row[:end - x]
+            self.changed = True
+        else:
+            raise ValueError("unknown record type 0x%02X" % kind)
+
+    def ppm(self):
+        out = bytearray(b"P6 %d %d 255\n" % (self.width, self.height))
+        for row in self.pixels:
+            for p in row:
+                r, g, b = (p >> 11) & 0x1F, (p >> 5) & 0x3F, p & 0x1F
+                out += bytes(((r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2)))
+        return bytes(out)
+
+
+def watch(host, port, out_dir, interval):
+    path = out_dir / ("%s.ppm" % host)
+    while True:
+        try:
+            with socket.create_connection((host, port), timeout=5) as sock:
+                sock.settimeout(interval)
+                mirror = Mirror()
+                print("%s: connected" % host)
+                last = time.monotonic()
+                while True:
+                    try:
+                        data = sock.recv(65536)
+                        if not data:
+                            raise ConnectionError("closed by board")
+                        mirror.feed(data)
+                    except socket.timeout:
+                        pass
+                    now = time.monotonic()
+                    if mirror.changed and mirror.width and now - last >= interval:
+                        path.with_suffix(".tmp").write_bytes(mirror.ppm())
+                        path.with_suffix(".tmp").replace(path)
+                        print("%s: %.1f KiB/s, %d resyncs" % (
+                            host, mirror.bytes / 1024.0 / (now - last), mirror.resyncs))
+                        mirror.changed = False
+                        mirror.bytes = 0
+                        last = now
+        except (OSError, ValueError) as err:
+            print("%s: %s, retrying" % (host, err), file=sys.stderr)
+            time.sleep(3)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("hosts", nargs="+", help="board address, optionally HOST:PORT")
+    parser.add_argument("--out-dir", type=Path, default=Path("."), help="snapshot directory")
+    parser.add_argument("--interval", type=float, default=1.0, help="snapshot period in seconds")
+    args = parser.parse_args()
+
+    args.out_dir.mkdir(parents=True, exist_ok=True)
+    threads = []
+    for spec in args.hosts:
+        host, _, port = spec.partition(":")
+        thread = threading.Thread(target=watch, daemon=True,
+                                  args=(host, int(port or DEFAULT_PORT), args.out_dir,
+                                        args.interval))
+        thread.start()
+        threads.append(thread)
+    try:
+        for thread in threads:
+            thread.join()
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,496 @@
+/**
+ * @file cjk_font.cpp
+ * @brief Flash 驻留中文点阵字库与 UTF-8 行光栅化实现。
+ */
+
+#include "platform/cjk_font.hpp"
+
+#include <errno.h>
+#include <zephyr/kernel.h>
+
+#include "platform/font5x7.hpp"
+
+namespace {
+
+/** @brief 保护字库缓存与 Flash 读缓冲的互斥锁（光栅化可能发生在多个线程）。 */
+K_MUTEX_DEFINE(g_cjk_font_mutex);
+
+/** @brief 全局字库实例。 */
+platform::raster::CjkFont g_cjk_font;
+
+/** @brief 非法 UTF-8 序列的替换字符。 */
+constexpr uint32_t kReplacementChar = 0xFFFDU;
+/** @brief 每行位图字节数。 */
+constexpr size_t kRowBytes = (platform::raster::kCjkGlyphSize + 7U) / 8U;
+/** @brief 字形像素总数。 */
+constexpr uint32_t kGlyphPixels =
+    static_cast<uint32_t>(platform::raster::kCjkGlyphSize) * platform::raster::kCjkGlyphSize;
+
+/**
+ * @brief 生成字库缺字时显示的空心方框（内缩 1 像素）。
+ * @param[out] out 字形位图。
+ */
+void tofu_glyph(platform::raster::CjkGlyph& out) noexcept {
+  constexpr uint8_t kSize = platform::raster::kCjkGlyphSize;
+  const uint16_t edge = static_cast<uint16_t>(((1U << (kSize - 2U)) - 1U) << 1);
+  const uint16_t sides = static_cast<uint16_t>((1U << 1) | (1U << (kSize - 2U)));
+  for (uint8_t row = 0U; row < kSize; ++row) {
+    out.rows[row] = (row == 0U || row == kSize - 1U)      ? 0U
+                    : (row == 1U || row == kSize - 2U) ? edge
+                                                       : sides;
+  }
+}
+
+}  // namespace
+
+namespace platform::raster {
+
+/**
+ * @brief 指定字库位置并清空缓存。
+ * @param flash 字库所在 Flash。
+ * @param offset 字库偏移。
+ */
+void CjkFont::attach(ISpiFlash& flash, uint32_t offset) noexcept {
+  flash_ = &flash;
+  base_ = offset;
+  header_ = {};
+  open_status_ = 1;
+  for (Slot& slot : slots_) {
+    slot = {};
+  }
+  clock_ = 0U;
+}
+
+/**
+ * @brief 加锁。
+ */
+void CjkFont::lock() noexcept {
+  (void)k_mutex_lock(&g_cjk_font_mutex, K_FOREVER);
+}
+
+/**
+ * @brief 解锁。
+ */
+void CjkFont::unlock() noexcept {
+  (void)k_mutex_unlock(&g_cjk_font_mutex);
+}
+
+/**
+ * @brief 读取 Flash 并计数。
+ * @param offset 相对字库起点的偏移。
+ * @param buffer 输出缓冲。
+ * @param len 字节数。
+ * @return 0 成功；负值失败。
+ */
+int CjkFont::read(uint32_t offset, void* buffer, size_t len) noexcept {
+  ++stats_.flash_reads;
+  return flash_->read(static_cast<off_t>(base_ + offset), buffer, len);
+}
+
+/**
+ * @brief 读取并校验文件头。
+ * @return 0 成功；-EINVAL 文件头非法；其他负值为读取错误。
+ */
+int CjkFont::open() noexcept {
+  CjkFontHeader header{};
+  int ret = read(0U, &header, sizeof(header));
+  if (ret == 0) {
+    const uint64_t index_end =
+        sizeof(header) + static_cast<uint64_t>(header.glyph_count) * sizeof(CjkIndexEntry);
+    if (header.magic != kCjkFontMagic || header.width != kCjkGlyphSize ||
+        header.height != kCjkGlyphSize || header.glyph_count == 0U ||
+        header.total_bytes < index_end) {
+      ret = -EINVAL;
+    }
+  }
+
+  if (ret == 0) {
+    header_ = header;
+  }
+  open_status_ = ret;
+  return ret;
+}
+
+/**
+ * @brief 二分查找码点：区间缩小到 kCjkIndexBlockEntries 以内后一次读出并顺序比较。
+ * @param codepoint 码点。
+ * @param[out] offset 字形记录偏移。
+ * @return 0 成功；负值失败。
+ */
+int CjkFont::find(uint32_t codepoint, uint32_t& offset) noexcept {
+  uint32_t lo = 0U;
+  uint32_t hi = header_.glyph_count;
+  while (hi - lo > kCjkIndexBlockEntries) {
+    const uint32_t mid = lo + (hi - lo) / 2U;
+    CjkIndexEntry entry{};
+    const int ret = read(sizeof(CjkFontHeader) + mid * sizeof(entry), &entry, sizeof(entry));
+    if (ret < 0) {
+      return ret;
+    }
+    if (entry.codepoint == codepoint) {
+      offset = entry.offset;
+      return 0;
+    }
+    if (entry.codepoint < codepoint) {
+      lo = mid + 1U;
+    } else {
+      hi = mid;
+    }
+  }
+
+  if (hi == lo) {
+    return -ENOENT;
+  }
+
+  const int ret = read(sizeof(CjkFontHeader) + lo * sizeof(CjkIndexEntry), index_block_,
+                       (hi - lo) * sizeof(CjkIndexEntry));
+  if (ret < 0) {
+    return ret;
+  }
+  for (uint32_t i = 0U; i < hi - lo; ++i) {
+    if (index_block_[i].codepoint == codepoint) {
+      offset = index_block_[i].offset;
+      return 0;
+    }
+  }
+  return -ENOENT;
+}
+
+/**
+ * @brief 读取并解码字形记录。
+ * @param offset 字形记录偏移。
+ * @param[out] out 字形位图。
+ * @return 0 成功；负值失败。
+ */
+int CjkFont::load(uint32_t offset, CjkGlyph& out) noexcept {
+  if (offset >= header_.total_bytes || header_.total_bytes - offset < 2U) {
+    return -EIO;
+  }
+
+  const size_t avail = header_.total_bytes - offset;
+  const size_t len = avail < kCjkMaxRecordBytes ? avail : kCjkMaxRecordBytes;
+  const int ret = read(offset, record_, len);
+  if (ret < 0) {
+    return ret;
+  }
+
+  const uint8_t encoding = record_[0];
+  const size_t payload = record_[1];
+  const uint8_t* data = &record_[2];
+  if (payload > len - 2U) {
+    return -EIO;
+  }
+
+  out = {};
+  if (encoding == kCjkGlyphRaw) {
+    if (payload != kRowBytes * kCjkGlyphSize) {
+      return -EIO;
+    }
+    for (uint8_t row = 0U; row < kCjkGlyphSize; ++row) {
+      const uint8_t* bytes = &data[row * kRowBytes];
+      out.rows[row] = static_cast<uint16_t>(kRowBytes > 1U ? (bytes[0] | (bytes[1] << 8))
+                                                           : bytes[0]);
+    }
+    return 0;
+  }
+
+  if (encoding != kCjkGlyphRuns) {
+    return -EIO;
+  }
+
+  /* 游程交替表示背景/前景，自背景开始；末尾未覆盖的像素视为背景。 */
+  uint32_t pos = 0U;
+  bool ink = false;
+  for (size_t i = 0U; i < payload * 2U; ++i) {
+    const uint32_t run = (i & 1U) == 0U ? (data[i / 2U] >> 4) : (data[i / 2U] & 0x0FU);
+    if (pos + run > kGlyphPixels) {
+      return -EIO;
+    }
+    if (ink) {
+      for (uint32_t p = pos; p < pos + run; ++p) {
+        out.rows[p / kCjkGlyphSize] |= static_cast<uint16_t>(1U << (p % kCjkGlyphSize));
+      }
+    }
+    pos += run;
+    ink = !ink;
+  }
+  return 0;
+}
+
+/**
+ * @brief 查找字形。
+ * @param codepoint 码点。
+ * @param[out] out 字形位图。
+ * @return 0 成功；负值失败。
+ */
+int CjkFont::get(uint32_t codepoint, CjkGlyph& out) noexcept {
+  /* 逻辑时钟回绕时整体失效，避免时间戳比较错乱。 */
+  if (++clock_ == 0U) {
+    for (Slot& slot : slots_) {
+      slot = {};
+    }
+    clock_ = 1U;
+  }
+
+  size_t victim = 0U;
+  for (size_t i = 0U; i < kCjkCacheSlots; ++i) {
+    Slot& slot = slots_[i];
+    if (slot.last_use != 0U && slot.codepoint == codepoint) {
+      slot.last_use = clock_;
+      ++stats_.hits;
+      if (slot.missing) {
+        ++stats_.not_found;
+        tofu_glyph(out);
+        return -ENOENT;
+      }
+      out = slot.glyph;
+      return 0;
+    }
+    if (slot.last_use < slots_[victim].last_use) {
+      victim = i;
+    }
+  }
+
+  if (flash_ == nullptr) {
+    attach(spi_flash_ext(), CONFIG_SKY_BOARD_CJK_FONT_OFFSET);
+  }
+  if (open_status_ == -EINVAL) {
+    return -EINVAL;
+  }
+  if (open_status_ != 0) {
+    /* Flash 尚未就绪等暂时性错误：下次查询重试。 */
+    const int ret = open();
+    if (ret < 0) {
+      return ret;
+    }
+  }
+
+  ++stats_.misses;
+  uint32_t offset = 0U;
+  int ret = find(codepoint, offset);
+  const bool missing = (ret == -ENOENT);
+  if (missing) {
+    /* 缺字同样占一个槽位，重复出现（例如非法 UTF-8 的 U+FFFD）时不再查 Flash。 */
+    ++stats_.not_found;
+    tofu_glyph(out);
+  } else if (ret == 0) {
+    ret = load(offset, out);
+  }
+  if (ret < 0 && !missing) {
+    return ret;
+  }
+
+  Slot& slot = slots_[victim];
+  slot.codepoint = codepoint;
+  slot.last_use = clock_;
+  slot.missing = missing;
+  slot.glyph = out;
+  return ret;
+}
+
+/**
+ * @brief 读取统计信息。
+ * @param[out] out 统计快照。
+ */
+void CjkFont::get_stats(CjkFontStats& out) noexcept {
+  lock();
+  out = stats_;
+  unlock();
+}
+
+/**
+ * @brief 清空缓存与统计。
+ */
+void CjkFont::clear() noexcept {
+  lock();
+  for (Slot& slot : slots_) {
+    slot = {};
+  }
+  clock_ = 0U;
+  stats_ = {};
+  unlock();
+}
+
+/**
+ * @brief 获取全局字库实例。
+ * @return CjkFont 引用。
+ */
+CjkFont& cjk_font() noexcept {
+  return g_cjk_font;
+}
+
+/**
+ * @brief 解码一个 UTF-8 码点。
+ * @param text 文本指针。
+ * @param len 剩余字节数。
+ * @param[out] codepoint 码点。
+ * @return 消耗的字节数。
+ * @note 拒绝超长编码、代理区与超出 U+10FFFF 的值，均替换为 U+FFFD。
+ */
+size_t utf8_decode(const char* text, size_t len, uint32_t& codepoint) noexcept {
+  const uint8_t lead = static_cast<uint8_t>(text[0]);
+  if (lead < 0x80U) {
+    codepoint = lead;
+    return 1U;
+  }
+
+  const size_t n = lead >= 0xF5U   ? 0U
+                   : lead >= 0xF0U ? 4U
+                   : lead >= 0xE0U ? 3U
+                   : lead >= 0xC2U ? 2U
+                                   : 0U;
+  if (n == 0U || n > len) {
+    codepoint = kReplacementChar;
+    return 1U;
+  }
+
+  uint32_t cp = lead & (0x7FU >> n);
+  for (size_t i = 1U; i < n; ++i) {
+    const uint8_t cont = static_cast<uint8_t>(text[i]);
+    if ((cont & 0xC0U) != 0x80U) {
+      codepoint = kReplacementChar;
+      return i;
+    }
+    cp = (cp << 6) | (cont & 0x3FU);
+  }
+
+  if ((n == 3U && cp < 0x800U) || (n == 4U && cp < 0x10000U) || cp > 0x10FFFFU ||
+      (cp >= 0xD800U && cp <= 0xDFFFU)) {
+    cp = kReplacementChar;
+  }
+  codepoint = cp;
+  return n;
+}
+
+/**
+ * @brief 判断文本是否包含多字节 UTF-8 字符。
+ * @param text 文本指针。
+ * @param len 字节数。
+ * @return true 表示包含。
+ */
+bool utf8_has_multibyte(const char* text, size_t len) noexcept {
+  for (size_t i = 0U; i < len; ++i) {
+    if ((static_cast<uint8_t>(text[i]) & 0x80U) != 0U) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief 求不截断 UTF-8 字符的最长前缀。
+ * @param text 文本指针。
+ * @param len 字节数。
+ * @param max_bytes 字节上限。
+ * @return 前缀字节数。
+ */
+size_t utf8_prefix(const char* text, size_t len, size_t max_bytes) noexcept {
+  if (len <= max_bytes) {
+    return len;
+  }
+
+  size_t end = max_bytes;
+  while (end > 0U && (static_cast<uint8_t>(text[end]) & 0xC0U) == 0x80U) {
+    --end;
+  }
+  /* 连续的续字节超过上限（非法序列）：按上限硬切。 */
+  return end > 0U ? end : max_bytes;
+}
+
+/**
+ * @brief 计算 UTF-8 文本行宽度。
+ * @param text 文本指针。
+ * @param len 字节数。
+ * @param scale 缩放倍数。
+ * @return 像素宽度。
+ */
+uint32_t utf8_line_width(const char* text, size_t len, uint8_t scale) noexcept {
+  uint32_t cells = 0U;
+  size_t pos = 0U;
+  while (pos < len) {
+    uint32_t cp = 0U;
+    pos += utf8_decode(&text[pos], len - pos, cp);
+    cells += cp < 0x80U ? kCellWidth : kCjkGlyphSize;
+  }
+  return cells * scale;
+}
+
+/**
+ * @brief 把一行 UTF-8 文本的矩形片段展开到目标缓冲。
+ * @param font 字库。
+ * @param dst 目标缓冲。
+ * @param pitch 行跨度（像素）。
+ * @param skip 左侧跳过的像素列数。
+ * @param w 输出宽度。
+ * @param line_row 片段首行（已含缩放）。
+ * @param h 输出行数。
+ * @param text 文本指针。
+ * @param len 字节数。
+ * @param fg_rgb565 前景色。
+ * @param bg_rgb565 背景色。
+ * @param scale 缩放倍数。
+ * @note 先整体铺背景色，再逐字符只写前景像素；与片段不相交的字符不查字库。
+ */
+void rasterize_utf8_block(CjkFont& font, uint16_t* dst, size_t pitch, uint32_t skip, uint16_t w,
+                          uint16_t line_row, uint16_t h, const char* text, size_t len,
+                          uint16_t fg_rgb565, uint16_t bg_rgb565, uint8_t scale) noexcept {
+  for (uint16_t row = 0U; row < h; ++row) {
+    fill_rgb565_words(&dst[row * pitch], w, bg_rgb565);
+  }
+
+  const uint16_t line_cells = static_cast<uint16_t>(utf8_line_height(1U));
+  const uint32_t end = skip + w;
+  uint32_t gx = 0U;
+  size_t pos = 0U;
+  while (pos < len && gx < end) {
+    uint32_t cp = 0U;
+    pos += utf8_decode(&text[pos], len - pos, cp);
+    const bool ascii = cp < 0x80U;
+    const uint32_t advance = static_cast<uint32_t>(ascii ? kCellWidth : kCjkGlyphSize) * scale;
+    if (gx + advance <= skip) {
+      gx += advance;
+      continue;
+    }
+
+    CjkGlyph glyph{};
+    uint8_t glyph_rows = kCjkGlyphSize;
+    if (ascii) {
+      glyph_rows = font5x7::kHeight;
+      for (uint8_t row = 0U; row < glyph_rows; ++row) {
+        glyph.rows[row] = font5x7::row_mask(static_cast<char>(cp), row);
+      }
+    } else {
+      font.lock();
+      const int ret = font.get(cp, glyph);
+      font.unlock();
+      if (ret < 0) {
+        tofu_glyph(glyph);
+      }
+    }
+
+    /* 5x7 字形（含 1 行间隔）在行内垂直居中，字库字形占满行高。 */
+    const uint16_t top = static_cast<uint16_t>(ascii ? (line_cells - kCellHeight) / 2U
+                                                     : (line_cells - kCjkGlyphSize) / 2U);
+    const uint32_t x0 = gx > skip ? gx : skip;
+    const uint32_t x1 = gx + advance < end ? gx + advance : end;
+    for (uint16_t row = 0U; row < h; ++row) {
+      const uint16_t cell_row = static_cast<uint16_t>((line_row + row) / scale);
+      if (cell_row < top || cell_row >= top + glyph_rows) {
+        continue;
+      }
+      const uint16_t mask = glyph.rows[cell_row - top];
+      if (mask == 0U) {
+        continue;
+      }
+      uint16_t* out = &dst[row * pitch];
+      for (uint32_t x = x0; x < x1; ++x) {
+        if (((mask >> ((x - gx) / scale)) & 0x01U) != 0U) {
+          out[x - skip] = fg_rgb565;
+        }
+      }
+    }
+    gx += advance;
+  }
+}
+
+}  // namespace platform::raster
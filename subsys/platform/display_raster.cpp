@@ -0,0 +1,460 @@
+/**
+ * @file display_raster.cpp
+ * @brief 显示光栅化公共组件实现。
+ */
+
+#include "platform/display_raster.hpp"
+
+#include <errno.h>
+#include <string.h>
+
+#include "platform/glyph_cache.hpp"
+
+namespace {
+
+/**
+ * @brief 判断两个矩形能否无损拼接为一个矩形（同列宽纵向相接/重叠，或同行高横向相接/重叠）。
+ * @param a 矩形 a。
+ * @param b 矩形 b。
+ * @return true 表示二者的并集恰好是一个矩形。
+ */
+bool exact_union(const platform::raster::Rect& a, const platform::raster::Rect& b) noexcept {
+  if (a.x == b.x && a.w == b.w) {
+    return b.y <= a.y + a.h && a.y <= b.y + b.h;
+  }
+  if (a.y == b.y && a.h == b.h) {
+    return b.x <= a.x + a.w && a.x <= b.x + b.w;
+  }
+  return false;
+}
+
+/**
+ * @brief 计算两个矩形的包围盒。
+ * @param a 矩形 a。
+ * @param b 矩形 b。
+ * @return 包围盒。
+ */
+platform::raster::Rect bounding_box(const platform::raster::Rect& a,
+                                    const platform::raster::Rect& b) noexcept {
+  const uint32_t x0 = a.x < b.x ? a.x : b.x;
+  const uint32_t y0 = a.y < b.y ? a.y : b.y;
+  const uint32_t ax1 = static_cast<uint32_t>(a.x) + a.w;
+  const uint32_t bx1 = static_cast<uint32_t>(b.x) + b.w;
+  const uint32_t ay1 = static_cast<uint32_t>(a.y) + a.h;
+  const uint32_t by1 = static_cast<uint32_t>(b.y) + b.h;
+  platform::raster::Rect out{};
+  out.x = static_cast<uint16_t>(x0);
+  out.y = static_cast<uint16_t>(y0);
+  out.w = static_cast<uint16_t>((ax1 > bx1 ? ax1 : bx1) - x0);
+  out.h = static_cast<uint16_t>((ay1 > by1 ? ay1 : by1) - y0);
+  return out;
+}
+
+}  // namespace
+
+namespace platform::raster {
+
+/**
+ * @brief 求两个矩形的交集。
+ * @param a 矩形 a。
+ * @param b 矩形 b。
+ * @param[out] out 交集矩形。
+ * @return true 表示存在非空交集。
+ */
+bool intersect(const Rect& a, const Rect& b, Rect& out) noexcept {
+  const uint32_t x0 = a.x > b.x ? a.x : b.x;
+  const uint32_t y0 = a.y > b.y ? a.y : b.y;
+  const uint32_t ax1 = static_cast<uint32_t>(a.x) + a.w;
+  const uint32_t bx1 = static_cast<uint32_t>(b.x) + b.w;
+  const uint32_t ay1 = static_cast<uint32_t>(a.y) + a.h;
+  const uint32_t by1 = static_cast<uint32_t>(b.y) + b.h;
+  const uint32_t x1 = ax1 < bx1 ? ax1 : bx1;
+  const uint32_t y1 = ay1 < by1 ? ay1 : by1;
+  if (x1 <= x0 || y1 <= y0) {
+    return false;
+  }
+
+  out.x = static_cast<uint16_t>(x0);
+  out.y = static_cast<uint16_t>(y0);
+  out.w = static_cast<uint16_t>(x1 - x0);
+  out.h = static_cast<uint16_t>(y1 - y0);
+  return true;
+}
+
+/**
+ * @brief 判断 outer 是否完整包含 inner。
+ * @param outer 外矩形。
+ * @param inner 内矩形。
+ * @return true 表示包含。
+ */
+bool contains(const Rect& outer, const Rect& inner) noexcept {
+  return inner.x >= outer.x && inner.y >= outer.y &&
+         static_cast<uint32_t>(inner.x) + inner.w <= static_cast<uint32_t>(outer.x) + outer.w &&
+         static_cast<uint32_t>(inner.y) + inner.h <= static_cast<uint32_t>(outer.y) + outer.h;
+}
+
+/**
+ * @brief 以 32-bit 字为单位填充 RGB565 像素。
+ * @param dst 目标缓冲。
+ * @param count 像素个数。
+ * @param color_rgb565 RGB565 颜色值。
+ * @note 工程以 -fno-strict-aliasing 编译，按字访问像素缓冲是安全的。
+ */
+void fill_rgb565_words(uint16_t* dst, size_t count, uint16_t color_rgb565) noexcept {
+  if (count == 0U) {
+    return;
+  }
+
+  /* 起始地址只有半字对齐时先写 1 个像素，使后续整字写入对齐。 */
+  if ((reinterpret_cast<uintptr_t>(dst) & 0x03U) != 0U) {
+    *dst++ = color_rgb565;
+    --count;
+  }
+
+  const uint32_t pattern = (static_cast<uint32_t>(color_rgb565) << 16) | color_rgb565;
+  uint32_t* words = reinterpret_cast<uint32_t*>(dst);
+  size_t word_count = count / 2U;
+
+  /* 4 字展开，减少循环判断开销。 */
+  while (word_count >= 4U) {
+    words[0] = pattern;
+    words[1] = pattern;
+    words[2] = pattern;
+    words[3] = pattern;
+    words += 4;
+    word_count -= 4U;
+  }
+  while (word_count > 0U) {
+    *words++ = pattern;
+    --word_count;
+  }
+
+  if ((count & 0x01U) != 0U) {
+    dst[count - 1U] = color_rgb565;
+  }
+}
+
+/**
+ * @brief 展开文本行在某字形行上的像素。
+ * @param dst 目标行缓冲。
+ * @param skip 左侧跳过的像素数。
+ * @param count 输出像素个数。
+ * @param text 文本指针。
+ * @param len 文本字符数。
+ * @param glyph_row 字形行号。
+ * @param fg_rgb565 前景色。
+ * @param bg_rgb565 背景色。
+ * @param scale 缩放倍数。
+ */
+void rasterize_text_row(uint16_t* dst, uint32_t skip, uint16_t count, const char* text, size_t len,
+                        uint8_t glyph_row, uint16_t fg_rgb565, uint16_t bg_rgb565,
+                        uint8_t scale) noexcept {
+  /* 以行掩码比特为下标查色，逐像素无数据相关分支；相邻两像素合并为一次 32-bit 写入。 */
+  const uint16_t colors[2] = {bg_rgb565, fg_rgb565};
+  const uint32_t pairs[4] = {
+      (static_cast<uint32_t>(bg_rgb565) << 16) | bg_rgb565,
+      (static_cast<uint32_t>(bg_rgb565) << 16) | fg_rgb565,
+      (static_cast<uint32_t>(fg_rgb565) << 16) | bg_rgb565,
+      (static_cast<uint32_t>(fg_rgb565) << 16) | fg_rgb565,
+  };
+  const uint32_t cell_px = static_cast<uint32_t>(kCellWidth) * scale;
+  size_t ch = skip / cell_px;
+  uint32_t in_cell = skip % cell_px;
+  uint16_t px = 0U;
+
+  while (px < count && ch < len) {
+    const uint32_t left = cell_px - in_cell;
+    const uint16_t n =
+        static_cast<uint16_t>(left < static_cast<uint32_t>(count - px) ? left : count - px);
+    uint16_t* out = &dst[px];
+
+    if (scale <= font5x7::kMaxExpandedScale) {
+      /* 编译期展开表：每个输出像素恰好对应掩码中的一个比特。 */
+      uint32_t bits = font5x7::expanded_row_mask(text[ch], glyph_row, scale) >> in_cell;
+      uint16_t i = 0U;
+      if (n > 0U && (reinterpret_cast<uintptr_t>(out) & 0x02U) != 0U) {
+        out[i++] = colors[bits & 0x01U];
+        bits >>= 1;
+      }
+      uint32_t* words = reinterpret_cast<uint32_t*>(&out[i]);
+      for (; (i + 1U) < n; i = static_cast<uint16_t>(i + 2U)) {
+        *words++ = pairs[bits & 0x03U];
+        bits >>= 2;
+      }
+      if (i < n) {
+        out[i] = colors[bits & 0x01U];
+      }
+    } else {
+      const uint8_t mask = font5x7::row_mask(text[ch], glyph_row);
+      uint8_t col = static_cast<uint8_t>(in_cell / scale);
+      uint8_t sub = static_cast<uint8_t>(in_cell % scale);
+      for (uint16_t i = 0U; i < n; ++i) {
+        out[i] = colors[(mask >> col) & 0x01U];
+        if (++sub == scale) {
+          sub = 0U;
+          ++col;
+        }
+      }
+    }
+
+    px = static_cast<uint16_t>(px + n);
+    in_cell = 0U;
+    ++ch;
+  }
+}
+
+/**
+ * @brief 展开文本行的矩形片段。
+ * @param dst 目标缓冲左上角。
+ * @param pitch 目标缓冲行跨度。
+ * @param skip 左侧跳过的像素列数。
+ * @param w 输出宽度。
+ * @param line_row 片段首行在文本行内的像素行号。
+ * @param h 输出行数。
+ * @param text 文本指针。
+ * @param len 文本字符数。
+ * @param fg_rgb565 前景色。
+ * @param bg_rgb565 背景色。
+ * @param scale 缩放倍数。
+ */
+void rasterize_text_block(uint16_t* dst, size_t pitch, uint32_t skip, uint16_t w,
+                          uint16_t line_row, uint16_t h, const char* text, size_t len,
+                          uint16_t fg_rgb565, uint16_t bg_rgb565, uint8_t scale) noexcept {
+  if (w == 0U || h == 0U) {
+    return;
+  }
+
+#if defined(CONFIG_SKY_BOARD_DISPLAY_GLYPH_CACHE)
+  if (scale <= kGlyphCacheMaxScale) {
+    /* 按字符列推进：每个字符只查一次缓存，随后把所需的字形行逐行拷贝到目标缓冲。 */
+    const uint32_t cell_px = static_cast<uint32_t>(kCellWidth) * scale;
+    size_t ch = skip / cell_px;
+    uint32_t in_cell = skip % cell_px;
+    uint16_t px = 0U;
+    GlyphCache& cache = glyph_cache();
+    cache.lock();
+    while (px < w && ch < len) {
+      const uint32_t left = cell_px - in_cell;
+      const uint16_t n = static_cast<uint16_t>(left < static_cast<uint32_t>(w - px) ? left
+                                                                                  : w - px);
+      const uint16_t* cell = cache.get(text[ch], scale, fg_rgb565, bg_rgb565);
+      for (uint16_t r = 0U; r < h; ++r) {
+        const uint16_t* src =
+            &cell[static_cast<size_t>((line_row + r) / scale) * cell_px + in_cell];
+        (void)memcpy(&dst[static_cast<size_t>(r) * pitch + px], src, n * sizeof(src[0]));
+      }
+      px = static_cast<uint16_t>(px + n);
+      in_cell = 0U;
+      ++ch;
+    }
+    cache.unlock();
+    return;
+  }
+#endif
+
+  for (uint16_t r = 0U; r < h; ++r) {
+    uint16_t* row = &dst[static_cast<size_t>(r) * pitch];
+    const uint16_t glyph_px_row = static_cast<uint16_t>(line_row + r);
+    /* 同一字形行放大出的后续像素行直接复制上一行。 */
+    if (r > 0U && (glyph_px_row % scale) != 0U) {
+      (void)memcpy(row, row - pitch, static_cast<size_t>(w) * sizeof(row[0]));
+      continue;
+    }
+    rasterize_text_row(row, skip, w, text, len, static_cast<uint8_t>(glyph_px_row / scale),
+                       fg_rgb565, bg_rgb565, scale);
+  }
+}
+
+/**
+ * @brief 有符号整数转十进制字符串。
+ * @param value 待格式化整数。
+ * @param buf 输出缓冲。
+ * @param size 输出缓冲大小。
+ * @return 写入字符数；缓冲不足返回 0。
+ */
+size_t format_int(int32_t value, char* buf, size_t size) noexcept {
+  if (buf == nullptr || size < 12U) {
+    return 0U;
+  }
+
+  size_t len = 0U;
+  uint32_t abs_value = 0U;
+  if (value < 0) {
+    buf[len++] = '-';
+    /* 兼容 INT32_MIN：先 +1 再取反并补 1。 */
+    abs_value = static_cast<uint32_t>(-(value + 1)) + 1U;
+  } else {
+    abs_value = static_cast<uint32_t>(value);
+  }
+
+  char digits[10]{};
+  uint8_t dlen = 0U;
+  do {
+    digits[dlen++] = static_cast<char>('0' + (abs_value % 10U));
+    abs_value /= 10U;
+  } while (abs_value != 0U && dlen < sizeof(digits));
+
+  while (dlen > 0U) {
+    buf[len++] = digits[--dlen];
+  }
+  buf[len] = '\0';
+  return len;
+}
+
+/**
+ * @brief 记录单色填充命令，并丢弃被其完整覆盖的旧命令。
+ * @param bounds 已裁剪的填充区域。
+ * @param color_rgb565 RGB565 颜色值。
+ * @return 0 成功；-ENOMEM 列表已满。
+ */
+int DisplayList::add_fill(const Rect& bounds, uint16_t color_rgb565) noexcept {
+  if (bounds.w == 0U || bounds.h == 0U) {
+    return 0;
+  }
+  if (dirty_count_ >= kMaxDirtyRects) {
+    return -ENOMEM;
+  }
+
+  /* 被新填充完整覆盖的旧命令不再可见，直接移除。 */
+  size_t kept = 0U;
+  for (size_t i = 0U; i < op_count_; ++i) {
+    if (!contains(bounds, ops_[i].bounds)) {
+      ops_[kept++] = ops_[i];
+    }
+  }
+  op_count_ = kept;
+  if (op_count_ == 0U) {
+    text_used_ = 0U;
+  }
+
+  if (op_count_ >= kMaxOps) {
+    return -ENOMEM;
+  }
+
+  DrawOp& op = ops_[op_count_++];
+  op = {};
+  op.type = OpType::kFill;
+  op.origin_x = bounds.x;
+  op.origin_y = bounds.y;
+  op.bounds = bounds;
+  op.fg_rgb565 = color_rgb565;
+  return add_dirty(bounds);
+}
+
+/**
+ * @brief 记录单行文本命令。
+ * @param origin_x 文本行起点 X。
+ * @param origin_y 文本行起点 Y。
+ * @param bounds 已裁剪的包围盒。
+ * @param text 文本指针。
+ * @param len 文本字符数。
+ * @param fg_rgb565 前景色。
+ * @param bg_rgb565 背景色。
+ * @param scale 缩放倍数。
+ * @return 0 成功；-ENOMEM 列表或文本池已满。
+ */
+int DisplayList::add_text(uint16_t origin_x, uint16_t origin_y, const Rect& bounds,
+                          const char* text, size_t len, uint16_t fg_rgb565, uint16_t bg_rgb565,
+                          uint8_t scale) noexcept {
+  if (bounds.w == 0U || bounds.h == 0U || len == 0U) {
+    return 0;
+  }
+  if (op_count_ >= kMaxOps || dirty_count_ >= kMaxDirtyRects ||
+      len > kTextPoolSize - text_used_) {
+    return -ENOMEM;
+  }
+
+  (void)memcpy(&text_pool_[text_used_], text, len);
+
+  DrawOp& op = ops_[op_count_++];
+  op = {};
+  op.type = OpType::kText;
+  op.scale = scale;
+  op.origin_x = origin_x;
+  op.origin_y = origin_y;
+  op.bounds = bounds;
+  op.fg_rgb565 = fg_rgb565;
+  op.bg_rgb565 = bg_rgb565;
+  op.text_offset = static_cast<uint16_t>(text_used_);
+  op.text_len = static_cast<uint16_t>(len);
+  text_used_ += len;
+  return add_dirty(bounds);
+}
+
+/**
+ * @brief 合并脏矩形：包含关系直接吸收，可精确拼接的矩形合并后重新参与合并。
+ * @param rect 新增区域。
+ * @return 0 成功；-ENOMEM 集合已满。
+ */
+int DisplayList::add_dirty(Rect rect) noexcept {
+  bool merged = true;
+  while (merged) {
+    merged = false;
+    bool absorbed = false;
+    size_t kept = 0U;
+    for (size_t i = 0U; i < dirty_count_; ++i) {
+      if (!absorbed) {
+        if (contains(dirty_[i], rect)) {
+          /* 已被现有脏矩形覆盖：保留它并继续压缩剩余条目。 */
+          absorbed = true;
+        } else if (contains(rect, dirty_[i])) {
+          continue;
+        } else if (!merged && exact_union(dirty_[i], rect)) {
+          rect = bounding_box(dirty_[i], rect);
+          merged = true;
+          continue;
+        }
+      }
+      dirty_[kept++] = dirty_[i];
+    }
+    dirty_count_ = kept;
+    if (absorbed) {
+      return 0;
+    }
+  }
+
+  if (dirty_count_ >= kMaxDirtyRects) {
+    return -ENOMEM;
+  }
+  dirty_[dirty_count_++] = rect;
+  return 0;
+}
+
+/**
+ * @brief 按记录顺序把相交命令合成到输出缓冲，每个像素只由最上层命令决定。
+ * @param region 输出区域。
+ * @param out 输出缓冲。
+ */
+void DisplayList::render(const Rect& region, uint16_t* out) const noexcept {
+  for (size_t i = 0U; i < op_count_; ++i) {
+    const DrawOp& op = ops_[i];
+    Rect clip{};
+    if (!intersect(op.bounds, region, clip)) {
+      continue;
+    }
+
+    uint16_t* dst = &out[static_cast<size_t>(clip.y - region.y) * region.w + (clip.x - region.x)];
+    if (op.type == OpType::kText) {
+      rasterize_text_block(dst, region.w, static_cast<uint32_t>(clip.x - op.origin_x), clip.w,
+                           static_cast<uint16_t>(clip.y - op.origin_y), clip.h,
+                           &text_pool_[op.text_offset], op.text_len, op.fg_rgb565, op.bg_rgb565,
+                           op.scale);
+      continue;
+    }
+
+    for (uint16_t row = 0U; row < clip.h; ++row) {
+      fill_rgb565_words(&dst[static_cast<size_t>(row) * region.w], clip.w, op.fg_rgb565);
+    }
+  }
+}
+
+/**
+ * @brief 清空显示列表。
+ */
+void DisplayList::reset() noexcept {
+  op_count_ = 0U;
+  text_used_ = 0U;
+  dirty_count_ = 0U;
+}
+
+}  // namespace platform::raster
@@ -5,6 +5,8 @@
 
 #include "platform/font5x7.hpp"
 
+#include <cstddef>
+
 namespace {
 
 /** @brief 可显示的首个 ASCII 码。 */
@@ -50,6 +52,72 @@ constexpr uint8_t kFontTable[][5] = {
     {0x00, 0x41, 0x36, 0x08, 0x00}, {0x02, 0x01, 0x02, 0x04, 0x02},
 };
 
+/** @brief 字库字符个数。 */
+constexpr size_t kGlyphCount = kAsciiLast - kAsciiFirst + 1U;
+
+static_assert(sizeof(kFontTable) / sizeof(kFontTable[0]) == kGlyphCount, "font table size");
+
+/**
+ * @brief 行优先字形表：kGlyphCount 个字符 x kHeight 行，每行一个掩码。
+ * @tparam T 掩码类型，需容纳 kWidth * Scale 个比特。
+ * @tparam Scale 横向展开倍数。
+ */
+template <typename T, uint8_t Scale>
+struct RowAtlas {
+  T rows[kGlyphCount][platform::font5x7::kHeight];
+};
+
+/**
+ * @brief 由列优先的 kFontTable 在编译期生成行优先字形表。
+ * @tparam T 掩码类型。
+ * @tparam Scale 横向展开倍数：每个字形列在掩码中占 Scale 个连续比特。
+ * @return 行优先字形表。
+ */
+template <typename T, uint8_t Scale>
+constexpr RowAtlas<T, Scale> make_row_atlas() {
+  static_assert(sizeof(T) * 8U >= platform::font5x7::kWidth * Scale, "mask type too narrow");
+  RowAtlas<T, Scale> atlas{};
+  const T column_bits = static_cast<T>((1U << Scale) - 1U);
+  for (size_t g = 0U; g < kGlyphCount; ++g) {
+    for (uint8_t row = 0U; row < platform::font5x7::kHeight; ++row) {
+      T mask = 0U;
+      for (uint8_t col = 0U; col < platform::font5x7::kWidth; ++col) {
+        if (((kFontTable[g][col] >> row) & 0x01U) != 0U) {
+          mask = static_cast<T>(mask | (column_bits << (col * Scale)));
+        }
+      }
+      atlas.rows[g][row] = mask;
+    }
+  }
+  return atlas;
+}
+
+/** @brief 1 倍行优先字形表（665 字节）。 */
+constexpr RowAtlas<uint8_t, 1U> kRowAtlas = make_row_atlas<uint8_t, 1U>();
+
+#if defined(CONFIG_SKY_BOARD_FONT5X7_EXPANDED_ATLAS)
+/** @brief 2 倍横向展开字形表（1330 字节）。 */
+constexpr RowAtlas<uint16_t, 2U> kRowAtlas2x = make_row_atlas<uint16_t, 2U>();
+/** @brief 3 倍横向展开字形表（2660 字节）。 */
+constexpr RowAtlas<uint32_t, 3U> kRowAtlas3x = make_row_atlas<uint32_t, 3U>();
+#endif
+
+/** @brief 编译期自检：'0' 的首行为 .###.（bit1~bit3）。 */
+static_assert(kRowAtlas.rows['0' - kAsciiFirst][0] == 0x0EU, "row atlas transpose");
+
+/**
+ * @brief 把字符映射为字库下标，超出范围时映射为 '?'。
+ * @param c 输入字符。
+ * @return 字库下标。
+ */
+size_t glyph_index(char c) noexcept {
+  uint8_t uc = static_cast<uint8_t>(c);
+  if (uc < kAsciiFirst || uc > kAsciiLast) {
+    uc = static_cast<uint8_t>('?');
+  }
+  return static_cast<size_t>(uc - kAsciiFirst);
+}
+
 }  // namespace
 
 namespace platform::font5x7 {
@@ -60,12 +128,47 @@ namespace platform::font5x7 {
  * @return 对应字符的列数据指针；超出范围时返回 '?' 字模。
  */
 const uint8_t* glyph(char c) noexcept {
-  uint8_t uc = static_cast<uint8_t>(c);
-  if (uc < kAsciiFirst || uc > kAsciiLast) {
-    uc = static_cast<uint8_t>('?');
+  return kFontTable[glyph_index(c)];
+}
+
+/**
+ * @brief 查询 1 倍行掩码。
+ * @param c 输入字符。
+ * @param row 字形行号。
+ * @return 行掩码；row 越界时返回 0。
+ */
+uint8_t row_mask(char c, uint8_t row) noexcept {
+  if (row >= kHeight) {
+    return 0U;
   }
+  return kRowAtlas.rows[glyph_index(c)][row];
+}
 
-  return kFontTable[uc - kAsciiFirst];
+/**
+ * @brief 查询横向展开后的行掩码。
+ * @param c 输入字符。
+ * @param row 字形行号。
+ * @param scale 缩放倍数。
+ * @return 展开后的掩码；row/scale 越界时返回 0。
+ */
+uint32_t expanded_row_mask(char c, uint8_t row, uint8_t scale) noexcept {
+  if (row >= kHeight) {
+    return 0U;
+  }
+
+  const size_t index = glyph_index(c);
+  switch (scale) {
+    case 1U:
+      return kRowAtlas.rows[index][row];
+#if defined(CONFIG_SKY_BOARD_FONT5X7_EXPANDED_ATLAS)
+    case 2U:
+      return kRowAtlas2x.rows[index][row];
+    case 3U:
+      return kRowAtlas3x.rows[index][row];
+#endif
+    default:
+      return 0U;
+  }
 }
 
 }  // namespace platform::font5x7
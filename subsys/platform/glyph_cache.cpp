@@ -0,0 +1,123 @@
+/**
+ * @file glyph_cache.cpp
+ * @brief 预缩放 RGB565 字形缓存实现。
+ */
+
+#include "platform/glyph_cache.hpp"
+
+#include <zephyr/kernel.h>
+
+namespace {
+
+/** @brief 保护全局字形缓存的互斥锁（光栅化可能发生在多个线程）。 */
+K_MUTEX_DEFINE(g_glyph_cache_mutex);
+
+/** @brief 全局字形缓存实例。 */
+platform::raster::GlyphCache g_glyph_cache;
+
+}  // namespace
+
+namespace platform::raster {
+
+/**
+ * @brief 加锁。
+ */
+void GlyphCache::lock() noexcept {
+  (void)k_mutex_lock(&g_glyph_cache_mutex, K_FOREVER);
+}
+
+/**
+ * @brief 解锁。
+ */
+void GlyphCache::unlock() noexcept {
+  (void)k_mutex_unlock(&g_glyph_cache_mutex);
+}
+
+/**
+ * @brief 查找字形，未命中时光栅化进最久未使用的槽位。
+ * @param c 字符。
+ * @param scale 缩放倍数。
+ * @param fg_rgb565 前景色。
+ * @param bg_rgb565 背景色。
+ * @return 字形行数据；scale 超出范围时返回 nullptr。
+ */
+const uint16_t* GlyphCache::get(char c, uint8_t scale, uint16_t fg_rgb565,
+                                uint16_t bg_rgb565) noexcept {
+  if (scale == 0U || scale > kGlyphCacheMaxScale) {
+    return nullptr;
+  }
+
+  /* 逻辑时钟回绕时整体失效，避免时间戳比较错乱。 */
+  if (++clock_ == 0U) {
+    for (Slot& slot : slots_) {
+      slot = {};
+    }
+    clock_ = 1U;
+  }
+
+  const uint32_t colors = (static_cast<uint32_t>(fg_rgb565) << 16) | bg_rgb565;
+  size_t victim = 0U;
+  for (size_t i = 0U; i < kGlyphSlotCount; ++i) {
+    Slot& slot = slots_[i];
+    if (slot.last_use != 0U && slot.c == c && slot.scale == scale && slot.colors == colors) {
+      slot.last_use = clock_;
+      ++stats_.hits;
+      return pixels_[i];
+    }
+    if (slot.last_use < slots_[victim].last_use) {
+      victim = i;
+    }
+  }
+
+  ++stats_.misses;
+  if (slots_[victim].last_use != 0U) {
+    ++stats_.evictions;
+  }
+
+  Slot& slot = slots_[victim];
+  slot.c = c;
+  slot.scale = scale;
+  slot.colors = colors;
+  slot.last_use = clock_;
+
+  const uint16_t cell_px = static_cast<uint16_t>(kCellWidth * scale);
+  uint16_t* dst = pixels_[victim];
+  for (uint8_t row = 0U; row < kCellHeight; ++row) {
+    rasterize_text_row(&dst[static_cast<size_t>(row) * cell_px], 0U, cell_px, &c, 1U, row,
+                       fg_rgb565, bg_rgb565, scale);
+  }
+  return dst;
+}
+
+/**
+ * @brief 读取统计信息。
+ * @param[out] out 统计快照。
+ */
+void GlyphCache::get_stats(GlyphCacheStats& out) noexcept {
+  lock();
+  out = stats_;
+  unlock();
+}
+
+/**
+ * @brief 清空全部槽位与统计。
+ */
+void GlyphCache::clear() noexcept {
+  lock();
+  for (Slot& slot : slots_) {
+    slot = {};
+  }
+  clock_ = 0U;
+  stats_ = {};
+  unlock();
+}
+
+/**
+ * @brief 获取全局字形缓存实例。
+ * @return GlyphCache 引用。
+ */
+GlyphCache& glyph_cache() noexcept {
+  return g_glyph_cache;
+}
+
+}  // namespace platform::raster
@@ -0,0 +1,309 @@
+/**
+ * @file palette_framebuffer.cpp
+ * @brief 16 色 4bpp 离屏帧缓冲实现。
+ */
+
+#include "platform/palette_framebuffer.hpp"
+
+#include <errno.h>
+#include <string.h>
+
+namespace {
+
+/**
+ * @brief 计算两个 RGB565 颜色的距离平方（红/蓝左移 1 位与 6-bit 绿色对齐）。
+ * @param a 颜色 a。
+ * @param b 颜色 b。
+ * @return 距离平方。
+ */
+uint32_t color_distance(uint16_t a, uint16_t b) noexcept {
+  const int32_t dr = ((a >> 11) - (b >> 11)) * 2;
+  const int32_t dg = ((a >> 5) & 0x3F) - ((b >> 5) & 0x3F);
+  const int32_t db = ((a & 0x1F) - (b & 0x1F)) * 2;
+  return static_cast<uint32_t>(dr * dr + dg * dg + db * db);
+}
+
+}  // namespace
+
+namespace platform::raster {
+
+/**
+ * @brief 设置帧缓冲尺寸并清零像素与调色板。
+ * @param width 宽度。
+ * @param height 高度。
+ * @return 0 成功；-ENOMEM 超出容量。
+ */
+int PaletteFramebuffer::configure(uint16_t width, uint16_t height) noexcept {
+  const uint16_t pitch = static_cast<uint16_t>((width + 1U) / 2U);
+  if (static_cast<size_t>(pitch) * height > sizeof(pixels_)) {
+    return -ENOMEM;
+  }
+
+  pitch_ = pitch;
+  (void)memset(pixels_, 0, sizeof(pixels_));
+  reset_palette(0x0000U);
+  dirty_valid_ = false;
+  return 0;
+}
+
+/**
+ * @brief 重置调色板。
+ * @param color_rgb565 索引 0 的颜色。
+ */
+void PaletteFramebuffer::reset_palette(uint16_t color_rgb565) noexcept {
+  (void)memset(palette_, 0, sizeof(palette_));
+  palette_[0] = color_rgb565;
+  palette_count_ = 1U;
+  lut_stale_ = true;
+}
+
+/**
+ * @brief 查找或分配调色板索引。
+ * @param color_rgb565 RGB565 颜色值。
+ * @return 调色板索引。
+ */
+uint8_t PaletteFramebuffer::color_index(uint16_t color_rgb565) noexcept {
+  for (uint8_t i = 0U; i < palette_count_; ++i) {
+    if (palette_[i] == color_rgb565) {
+      return i;
+    }
+  }
+
+  if (palette_count_ < kPaletteSize) {
+    palette_[palette_count_] = color_rgb565;
+    lut_stale_ = true;
+    return palette_count_++;
+  }
+
+  uint8_t best = 0U;
+  uint32_t best_dist = UINT32_MAX;
+  for (uint8_t i = 0U; i < palette_count_; ++i) {
+    const uint32_t dist = color_distance(palette_[i], color_rgb565);
+    if (dist < best_dist) {
+      best_dist = dist;
+      best = i;
+    }
+  }
+  return best;
+}
+
+/**
+ * @brief 写入单个像素。
+ * @param x X 坐标。
+ * @param y Y 坐标。
+ * @param index 调色板索引。
+ */
+void PaletteFramebuffer::set_pixel(uint16_t x, uint16_t y, uint8_t index) noexcept {
+  uint8_t& byte = pixels_[static_cast<size_t>(y) * pitch_ + x / 2U];
+  if ((x & 0x01U) == 0U) {
+    byte = static_cast<uint8_t>((byte & 0x0FU) | (index << 4));
+  } else {
+    byte = static_cast<uint8_t>((byte & 0xF0U) | index);
+  }
+}
+
+/**
+ * @brief 并入脏区域包围盒。
+ * @param rect 新增区域。
+ */
+void PaletteFramebuffer::mark_dirty(const Rect& rect) noexcept {
+  if (!dirty_valid_) {
+    dirty_ = rect;
+    dirty_valid_ = true;
+    return;
+  }
+
+  const uint32_t x0 = dirty_.x < rect.x ? dirty_.x : rect.x;
+  const uint32_t y0 = dirty_.y < rect.y ? dirty_.y : rect.y;
+  const uint32_t dx1 = static_cast<uint32_t>(dirty_.x) + dirty_.w;
+  const uint32_t dy1 = static_cast<uint32_t>(dirty_.y) + dirty_.h;
+  const uint32_t rx1 = static_cast<uint32_t>(rect.x) + rect.w;
+  const uint32_t ry1 = static_cast<uint32_t>(rect.y) + rect.h;
+  dirty_.x = static_cast<uint16_t>(x0);
+  dirty_.y = static_cast<uint16_t>(y0);
+  dirty_.w = static_cast<uint16_t>((dx1 > rx1 ? dx1 : rx1) - x0);
+  dirty_.h = static_cast<uint16_t>((dy1 > ry1 ? dy1 : ry1) - y0);
+}
+
+/**
+ * @brief 以单一索引填充矩形。
+ * @param rect 区域。
+ * @param index 调色板索引。
+ * @note 中间整字节按 memset 填充，只有奇数起点/终点的半字节单独处理。
+ */
+void PaletteFramebuffer::fill(const Rect& rect, uint8_t index) noexcept {
+  if (rect.w == 0U || rect.h == 0U) {
+    return;
+  }
+
+  const uint8_t packed = static_cast<uint8_t>((index << 4) | index);
+  const uint16_t x_end = static_cast<uint16_t>(rect.x + rect.w);
+  for (uint16_t y = rect.y; y < rect.y + rect.h; ++y) {
+    uint16_t x0 = rect.x;
+    uint16_t x1 = x_end;
+    if ((x0 & 0x01U) != 0U) {
+      set_pixel(x0, y, index);
+      ++x0;
+    }
+    if (x1 > x0 && (x1 & 0x01U) != 0U) {
+      --x1;
+      set_pixel(x1, y, index);
+    }
+    if (x1 > x0) {
+      (void)memset(&pixels_[static_cast<size_t>(y) * pitch_ + x0 / 2U], packed, (x1 - x0) / 2U);
+    }
+  }
+
+  mark_dirty(rect);
+}
+
+/**
+ * @brief 绘制单行文本。
+ * @param bounds 文本行包围盒。
+ * @param text 文本指针。
+ * @param len 文本字符数。
+ * @param fg_index 前景色索引。
+ * @param bg_index 背景色索引。
+ * @param scale 缩放倍数。
+ * @note 每个字形行只展开一次，其余 scale-1 个像素行按字节拷贝。
+ */
+void PaletteFramebuffer::draw_text(const Rect& bounds, const char* text, size_t len,
+                                   uint8_t fg_index, uint8_t bg_index, uint8_t scale) noexcept {
+  if (bounds.w == 0U || bounds.h == 0U) {
+    return;
+  }
+
+  const uint16_t x_begin = bounds.x;
+  const uint16_t x_end = static_cast<uint16_t>(bounds.x + bounds.w);
+  for (uint16_t line_row = 0U; line_row < bounds.h;
+       line_row = static_cast<uint16_t>(line_row + scale)) {
+    const uint8_t glyph_row = static_cast<uint8_t>(line_row / scale);
+    const uint16_t y = static_cast<uint16_t>(bounds.y + line_row);
+
+    uint16_t x = x_begin;
+    for (size_t i = 0U; i < len && x < x_end; ++i) {
+      const uint8_t mask = font5x7::row_mask(text[i], glyph_row);
+      for (uint8_t col = 0U; col < kCellWidth && x < x_end; ++col) {
+        const uint8_t index = ((mask >> col) & 0x01U) != 0U ? fg_index : bg_index;
+        for (uint8_t rep = 0U; rep < scale && x < x_end; ++rep, ++x) {
+          set_pixel(x, y, index);
+        }
+      }
+    }
+
+    /* 纵向放大：复制刚展开的像素行，奇数边界半字节保留相邻像素。 */
+    const uint8_t* src = &pixels_[static_cast<size_t>(y) * pitch_];
+    for (uint16_t rep = 1U; rep < scale && line_row + rep < bounds.h; ++rep) {
+      uint8_t* dst = &pixels_[static_cast<size_t>(y + rep) * pitch_];
+      uint16_t x0 = x_begin;
+      uint16_t x1 = x_end;
+      if ((x0 & 0x01U) != 0U) {
+        dst[x0 / 2U] = static_cast<uint8_t>((dst[x0 / 2U] & 0xF0U) | (src[x0 / 2U] & 0x0FU));
+        ++x0;
+      }
+      if (x1 > x0 && (x1 & 0x01U) != 0U) {
+        --x1;
+        dst[x1 / 2U] = static_cast<uint8_t>((dst[x1 / 2U] & 0x0FU) | (src[x1 / 2U] & 0xF0U));
+      }
+      if (x1 > x0) {
+        (void)memcpy(&dst[x0 / 2U], &src[x0 / 2U], (x1 - x0) / 2U);
+      }
+    }
+  }
+
+  mark_dirty(bounds);
+}
+
+/**
+ * @brief 量化写入 RGB565 像素块。
+ * @param rect 区域。
+ * @param pixels 像素数据。
+ */
+void PaletteFramebuffer::blit(const Rect& rect, const uint16_t* pixels) noexcept {
+  if (rect.w == 0U || rect.h == 0U) {
+    return;
+  }
+
+  /* 相邻像素颜色通常相同，缓存上一次映射结果避免重复查表。 */
+  uint16_t last_color = pixels[0];
+  uint8_t last_index = color_index(last_color);
+  for (uint16_t row = 0U; row < rect.h; ++row) {
+    for (uint16_t col = 0U; col < rect.w; ++col) {
+      const uint16_t color = *pixels++;
+      if (color != last_color) {
+        last_color = color;
+        last_index = color_index(color);
+      }
+      set_pixel(static_cast<uint16_t>(rect.x + col), static_cast<uint16_t>(rect.y + row),
+                last_index);
+    }
+  }
+
+  mark_dirty(rect);
+}
+
+/**
+ * @brief 把区域展开为 RGB565。
+ * @param region 区域。
+ * @param out 输出缓冲。
+ * @note 成对像素经 256 项展开表一次查出；输出按字对齐时整字写入（小端，低半字为左像素）。
+ */
+void PaletteFramebuffer::expand(const Rect& region, uint16_t* out) noexcept {
+  if (lut_stale_) {
+    for (size_t b = 0U; b < 256U; ++b) {
+      pair_lut_[b] = (static_cast<uint32_t>(palette_[b & 0x0FU]) << 16) | palette_[b >> 4];
+    }
+    lut_stale_ = false;
+  }
+
+  for (uint16_t row = 0U; row < region.h; ++row) {
+    const uint8_t* src = &pixels_[static_cast<size_t>(region.y + row) * pitch_ + region.x / 2U];
+    uint16_t* dst = out;
+    size_t count = region.w;
+
+    if ((region.x & 0x01U) != 0U && count > 0U) {
+      *dst++ = palette_[*src++ & 0x0FU];
+      --count;
+    }
+
+    size_t pairs = count / 2U;
+    if ((reinterpret_cast<uintptr_t>(dst) & 0x03U) == 0U) {
+      uint32_t* words = reinterpret_cast<uint32_t*>(dst);
+      while (pairs > 0U) {
+        *words++ = pair_lut_[*src++];
+        --pairs;
+      }
+      dst = reinterpret_cast<uint16_t*>(words);
+    } else {
+      while (pairs > 0U) {
+        const uint32_t pair = pair_lut_[*src++];
+        dst[0] = static_cast<uint16_t>(pair);
+        dst[1] = static_cast<uint16_t>(pair >> 16);
+        dst += 2;
+        --pairs;
+      }
+    }
+
+    if ((count & 0x01U) != 0U) {
+      *dst = palette_[*src >> 4];
+    }
+    out += region.w;
+  }
+}
+
+/**
+ * @brief 取出并清除脏区域。
+ * @param[out] out 脏区域。
+ * @return true 表示存在待下发区域。
+ */
+bool PaletteFramebuffer::take_dirty(Rect& out) noexcept {
+  if (!dirty_valid_) {
+    return false;
+  }
+
+  out = dirty_;
+  dirty_valid_ = false;
+  return true;
+}
+
+}  // namespace platform::raster
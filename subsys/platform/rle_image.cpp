@@ -0,0 +1,245 @@
+/**
+ * @file rle_image.cpp
+ * @brief RLE 图像流式解码器实现。
+ */
+
+#include "platform/rle_image.hpp"
+
+#include <errno.h>
+#include <string.h>
+
+#include "platform/display_raster.hpp"
+
+namespace platform::raster {
+
+/**
+ * @brief 打开图像并校验文件头。
+ * @param flash 图像所在的 Flash。
+ * @param offset 文件头偏移。
+ * @return 0 成功；负值失败。
+ */
+int RleImageReader::open(ISpiFlash& flash, uint32_t offset) noexcept {
+  header_ = {};
+  flash_ = &flash;
+  chunk_len_ = 0U;
+  chunk_pos_ = 0U;
+  packet_left_ = 0U;
+  pending_nibble_ = -1;
+
+  ImageHeader header{};
+  int ret = flash.read(static_cast<off_t>(offset), &header, sizeof(header));
+  if (ret < 0) {
+    return ret;
+  }
+
+  const bool indexed = header.format == static_cast<uint8_t>(ImageFormat::kIndexed4Rle);
+  if (header.magic != kImageMagic || header.width == 0U || header.height == 0U ||
+      (!indexed && header.format != static_cast<uint8_t>(ImageFormat::kRgb565Rle)) ||
+      (indexed && (header.palette_count == 0U || header.palette_count > kImagePaletteMax)) ||
+      (!indexed && header.palette_count != 0U)) {
+    return -EINVAL;
+  }
+
+  uint32_t next = offset + sizeof(header);
+  if (indexed) {
+    (void)memset(palette_, 0, sizeof(palette_));
+    const size_t palette_bytes = header.palette_count * sizeof(palette_[0]);
+    ret = flash.read(static_cast<off_t>(next), palette_, palette_bytes);
+    if (ret < 0) {
+      return ret;
+    }
+    next += palette_bytes;
+  }
+
+  header_ = header;
+  next_offset_ = next;
+  unread_bytes_ = header.payload_bytes;
+  return 0;
+}
+
+/**
+ * @brief 从 Flash 补充读缓冲。
+ * @return 0 成功；负值失败。
+ */
+int RleImageReader::refill() noexcept {
+  if (unread_bytes_ == 0U) {
+    return -EIO;
+  }
+
+  const size_t len = unread_bytes_ < kChunkBytes ? unread_bytes_ : kChunkBytes;
+  const int ret = flash_->read(static_cast<off_t>(next_offset_), chunk_, len);
+  if (ret < 0) {
+    return ret;
+  }
+
+  next_offset_ += len;
+  unread_bytes_ -= len;
+  chunk_len_ = len;
+  chunk_pos_ = 0U;
+  return 0;
+}
+
+/**
+ * @brief 读取一个字节。
+ * @param[out] out 字节值。
+ * @return 0 成功；负值失败。
+ */
+int RleImageReader::next_byte(uint8_t& out) noexcept {
+  if (chunk_pos_ == chunk_len_) {
+    const int ret = refill();
+    if (ret < 0) {
+      return ret;
+    }
+  }
+
+  out = chunk_[chunk_pos_++];
+  return 0;
+}
+
+/**
+ * @brief 读取下一个包头。
+ * @return 0 成功；负值失败。
+ */
+int RleImageReader::next_packet() noexcept {
+  uint8_t head = 0U;
+  int ret = next_byte(head);
+  if (ret < 0) {
+    return ret;
+  }
+
+  packet_left_ = static_cast<uint8_t>((head & 0x7FU) + 1U);
+  literal_ = (head & 0x80U) == 0U;
+  pending_nibble_ = -1;
+  if (literal_) {
+    return 0;
+  }
+
+  uint8_t lo = 0U;
+  ret = next_byte(lo);
+  if (ret < 0) {
+    return ret;
+  }
+  if (header_.format == static_cast<uint8_t>(ImageFormat::kIndexed4Rle)) {
+    run_color_ = palette_[lo & 0x0FU];
+    return 0;
+  }
+
+  uint8_t hi = 0U;
+  ret = next_byte(hi);
+  if (ret < 0) {
+    return ret;
+  }
+  run_color_ = static_cast<uint16_t>((hi << 8) | lo);
+  return 0;
+}
+
+/**
+ * @brief 输出或丢弃接下来的 count 个像素。
+ * @param dst 目标缓冲，可为 nullptr。
+ * @param count 像素数。
+ * @return 0 成功；负值失败。
+ * @note 重复包按字填充；RGB565 字面包在读缓冲内整段拷贝，只有跨块的像素逐字节拼接。
+ */
+int RleImageReader::emit(uint16_t* dst, size_t count) noexcept {
+  const bool indexed = header_.format == static_cast<uint8_t>(ImageFormat::kIndexed4Rle);
+  while (count > 0U) {
+    if (packet_left_ == 0U) {
+      const int ret = next_packet();
+      if (ret < 0) {
+        return ret;
+      }
+    }
+
+    size_t n = count < packet_left_ ? count : packet_left_;
+    if (!literal_) {
+      if (dst != nullptr) {
+        fill_rgb565_words(dst, n, run_color_);
+      }
+    } else if (!indexed) {
+      const size_t avail = (chunk_len_ - chunk_pos_) / sizeof(uint16_t);
+      if (avail == 0U) {
+        /* 读缓冲剩余不足一个像素：逐字节读取一个像素（可能跨块）。 */
+        uint8_t lo = 0U;
+        uint8_t hi = 0U;
+        int ret = next_byte(lo);
+        if (ret == 0) {
+          ret = next_byte(hi);
+        }
+        if (ret < 0) {
+          return ret;
+        }
+        n = 1U;
+        if (dst != nullptr) {
+          *dst = static_cast<uint16_t>((hi << 8) | lo);
+        }
+      } else {
+        n = n < avail ? n : avail;
+        if (dst != nullptr) {
+          (void)memcpy(dst, &chunk_[chunk_pos_], n * sizeof(uint16_t));
+        }
+        chunk_pos_ += n * sizeof(uint16_t);
+      }
+    } else {
+      for (size_t i = 0U; i < n; ++i) {
+        uint8_t index = 0U;
+        if (pending_nibble_ >= 0) {
+          index = static_cast<uint8_t>(pending_nibble_ & 0x0F);
+          pending_nibble_ = -1;
+        } else {
+          uint8_t packed = 0U;
+          const int ret = next_byte(packed);
+          if (ret < 0) {
+            return ret;
+          }
+          index = static_cast<uint8_t>(packed >> 4);
+          pending_nibble_ = static_cast<int16_t>(packed);
+        }
+        if (dst != nullptr) {
+          dst[i] = palette_[index];
+        }
+      }
+    }
+
+    if (dst != nullptr) {
+      dst += n;
+    }
+    count -= n;
+    packet_left_ = static_cast<uint8_t>(packet_left_ - n);
+  }
+
+  return 0;
+}
+
+/**
+ * @brief 按行解码矩形片段。
+ * @param dst 目标缓冲。
+ * @param pitch 行跨度（像素）。
+ * @param skip 每行左侧跳过的像素数。
+ * @param w 每行输出像素数。
+ * @param rows 行数。
+ * @return 0 成功；负值失败。
+ */
+int RleImageReader::read_rows(uint16_t* dst, size_t pitch, uint16_t skip, uint16_t w,
+                              uint16_t rows) noexcept {
+  if (flash_ == nullptr || static_cast<uint32_t>(skip) + w > header_.width) {
+    return -EINVAL;
+  }
+
+  const size_t tail = static_cast<size_t>(header_.width) - skip - w;
+  for (uint16_t row = 0U; row < rows; ++row) {
+    int ret = emit(nullptr, skip);
+    if (ret == 0) {
+      ret = emit(&dst[row * pitch], w);
+    }
+    if (ret == 0) {
+      ret = emit(nullptr, tail);
+    }
+    if (ret < 0) {
+      return ret;
+    }
+  }
+
+  return 0;
+}
+
+}  // namespace platform::raster
@@ -0,0 +1,237 @@
+/**
+ * @file screen_capture.cpp
+ * @brief 屏幕镜像捕获实现。
+ */
+
+#include "platform/screen_capture.hpp"
+
+#include <string.h>
+#include <zephyr/sys/ring_buffer.h>
+
+namespace {
+
+/** @brief RLE 包的最大像素数。 */
+constexpr size_t kPacketMax = 128U;
+
+/** @brief 保护环形缓冲与编码缓冲（面板写入可能来自多个线程）。 */
+K_MUTEX_DEFINE(g_capture_mutex);
+/** @brief 有新数据写入时唤醒镜像服务线程。 */
+K_SEM_DEFINE(g_capture_data, 0, 1);
+/** @brief 记录流环形缓冲（Kconfig 可调）。 */
+RING_BUF_DECLARE(g_capture_ring, CONFIG_SKY_BOARD_SCREEN_MIRROR_BUFFER);
+
+/** @brief 全局捕获器实例。 */
+platform::ScreenCapture g_screen_capture;
+
+/**
+ * @brief 把一行像素编码为 RGB565 RLE 包。
+ * @param row 行像素。
+ * @param w 像素数。
+ * @param out 输出缓冲，至少 kMirrorMaxRowBytes 字节。
+ * @return 编码字节数。
+ */
+size_t encode_row(const uint16_t* row, uint16_t w, uint8_t* out) noexcept {
+  size_t pos = 0U;
+  size_t i = 0U;
+  while (i < w) {
+    size_t run = 1U;
+    while (i + run < w && run < kPacketMax && row[i + run] == row[i]) {
+      ++run;
+    }
+    if (run >= 2U) {
+      out[pos++] = static_cast<uint8_t>(0x80U | (run - 1U));
+      (void)memcpy(&out[pos], &row[i], sizeof(row[i]));
+      pos += sizeof(row[i]);
+      i += run;
+      continue;
+    }
+
+    /* 字面包延伸到下一段游程之前。 */
+    const size_t head = pos++;
+    size_t count = 0U;
+    while (i < w && count < kPacketMax) {
+      if (count > 0U && i + 1U < w && row[i + 1U] == row[i]) {
+        break;
+      }
+      (void)memcpy(&out[pos], &row[i], sizeof(row[i]));
+      pos += sizeof(row[i]);
+      ++count;
+      ++i;
+    }
+    out[head] = static_cast<uint8_t>(count - 1U);
+  }
+  return pos;
+}
+
+}  // namespace
+
+namespace platform {
+
+/**
+ * @brief 开始捕获。
+ * @param width 屏幕宽度。
+ * @param height 屏幕高度。
+ */
+void ScreenCapture::begin(uint16_t width, uint16_t height) noexcept {
+  (void)k_mutex_lock(&g_capture_mutex, K_FOREVER);
+  ring_buf_reset(&g_capture_ring);
+  lost_ = false;
+  stats_ = {};
+  MirrorRecordHeader hello{};
+  hello.type = kMirrorHello;
+  hello.w = width;
+  hello.h = height;
+  (void)put_record(hello, nullptr);
+  atomic_set(&active_, 1);
+  (void)k_mutex_unlock(&g_capture_mutex);
+
+  atomic_set(&resync_, 1);
+}
+
+/**
+ * @brief 停止捕获。
+ */
+void ScreenCapture::end() noexcept {
+  atomic_set(&active_, 0);
+}
+
+/**
+ * @brief 把记录头与负载整体写入缓冲。
+ * @param header 记录头。
+ * @param payload 负载。
+ * @return true 写入成功；false 空间不足。
+ */
+bool ScreenCapture::put_record(const MirrorRecordHeader& header, const uint8_t* payload) noexcept {
+  const size_t total = sizeof(header) + header.payload_bytes;
+  if (ring_buf_space_get(&g_capture_ring) < total) {
+    return false;
+  }
+
+  (void)ring_buf_put(&g_capture_ring, reinterpret_cast<const uint8_t*>(&header), sizeof(header));
+  if (header.payload_bytes != 0U) {
+    (void)ring_buf_put(&g_capture_ring, payload, header.payload_bytes);
+  }
+  stats_.stream_bytes += total;
+  return true;
+}
+
+/**
+ * @brief 编码一条行段记录并写入缓冲。
+ * @param x 起始 X。
+ * @param y 起始 Y。
+ * @param w 宽度。
+ * @param rows 相同内容的行数。
+ * @param row 行像素。
+ */
+void ScreenCapture::put_rows(uint16_t x, uint16_t y, uint16_t w, uint16_t rows,
+                             const uint16_t* row) noexcept {
+  if (lost_) {
+    MirrorRecordHeader resync{};
+    resync.type = kMirrorResync;
+    if (!put_record(resync, nullptr)) {
+      ++stats_.dropped;
+      return;
+    }
+    lost_ = false;
+  }
+
+  MirrorRecordHeader header{};
+  header.type = kMirrorRows;
+  header.x = x;
+  header.y = y;
+  header.w = w;
+  header.h = rows;
+  header.payload_bytes = static_cast<uint16_t>(encode_row(row, w, row_buf_));
+  if (!put_record(header, row_buf_)) {
+    /* 客户端读取跟不上：丢弃并请求整屏重绘，远端画面随后重新收敛。 */
+    ++stats_.dropped;
+    lost_ = true;
+    atomic_set(&resync_, 1);
+    return;
+  }
+  ++stats_.records;
+}
+
+/**
+ * @brief 记录一次面板写入：块内连续相同的行合并为一条记录。
+ * @param x 左上角 X。
+ * @param y 左上角 Y。
+ * @param w 宽度。
+ * @param h 高度。
+ * @param pixels 行优先像素，行跨度为 w。
+ */
+void ScreenCapture::record(uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+                           const uint16_t* pixels) noexcept {
+  if (atomic_get(&active_) == 0 || w == 0U || h == 0U || w > kMirrorMaxWidth) {
+    return;
+  }
+
+  const size_t row_bytes = static_cast<size_t>(w) * sizeof(pixels[0]);
+  (void)k_mutex_lock(&g_capture_mutex, K_FOREVER);
+  stats_.raw_bytes += static_cast<uint32_t>(row_bytes * h);
+  uint16_t first = 0U;
+  for (uint16_t row = 1U; row <= h; ++row) {
+    if (row < h && memcmp(&pixels[static_cast<size_t>(row) * w],
+                          &pixels[static_cast<size_t>(first) * w], row_bytes) == 0) {
+      continue;
+    }
+    put_rows(x, static_cast<uint16_t>(y + first), w, static_cast<uint16_t>(row - first),
+             &pixels[static_cast<size_t>(first) * w]);
+    first = row;
+  }
+  (void)k_mutex_unlock(&g_capture_mutex);
+
+  k_sem_give(&g_capture_data);
+}
+
+/**
+ * @brief 取出记录流数据，缓冲为空时最多等待 timeout。
+ * @param out 输出缓冲。
+ * @param max_len 最多取出的字节数。
+ * @param timeout 等待时间。
+ * @return 取出的字节数。
+ */
+size_t ScreenCapture::read(uint8_t* out, size_t max_len, k_timeout_t timeout) noexcept {
+  for (int attempt = 0; attempt < 2; ++attempt) {
+    (void)k_mutex_lock(&g_capture_mutex, K_FOREVER);
+    const size_t len = ring_buf_get(&g_capture_ring, out, max_len);
+    (void)k_mutex_unlock(&g_capture_mutex);
+    if (len != 0U || attempt != 0) {
+      return len;
+    }
+    (void)k_sem_take(&g_capture_data, timeout);
+  }
+  return 0U;
+}
+
+/**
+ * @brief 查询并清除整屏重绘请求。
+ * @return true 表示需要整屏重绘。
+ */
+bool ScreenCapture::take_resync() noexcept {
+  return atomic_cas(&resync_, 1, 0);
+}
+
+/**
+ * @brief 读取统计信息。
+ * @param[out] out 统计快照。
+ * @param reset true 时读取后清零。
+ */
+void ScreenCapture::get_stats(ScreenCaptureStats& out, bool reset) noexcept {
+  (void)k_mutex_lock(&g_capture_mutex, K_FOREVER);
+  out = stats_;
+  if (reset) {
+    stats_ = {};
+  }
+  (void)k_mutex_unlock(&g_capture_mutex);
+}
+
+/**
+ * @brief 获取全局屏幕捕获器。
+ * @return ScreenCapture 引用。
+ */
+ScreenCapture& screen_capture() noexcept {
+  return g_screen_capture;
+}
+
+}  // namespace platform
@@ -0,0 +1,326 @@
+/**
+ * @file shape_raster.cpp
+ * @brief 二维图元光栅化实现。
+ */
+
+#include "platform/shape_raster.hpp"
+
+namespace {
+
+using platform::raster::Rect;
+using platform::raster::RectSink;
+
+/** @brief 同时保持可向下延伸的矩形个数：圆周与边框每行最多两个跨度，留有余量。 */
+constexpr size_t kMaxOpenRects = 4U;
+/** @brief 支持的最大半径，保证 (2r+1)^2 不超出 32 位。 */
+constexpr int32_t kMaxRadius = 0x7FFF;
+
+/**
+ * @brief 整数平方根（向下取整）。
+ * @param n 被开方数。
+ * @return floor(sqrt(n))。
+ */
+uint32_t isqrt(uint32_t n) noexcept {
+  uint32_t root = 0U;
+  uint32_t bit = 1UL << 30;
+  while (bit > n) {
+    bit >>= 2;
+  }
+  while (bit != 0U) {
+    if (n >= root + bit) {
+      n -= root + bit;
+      root = (root >> 1) + bit;
+    } else {
+      root >>= 1;
+    }
+    bit >>= 2;
+  }
+  return root;
+}
+
+/**
+ * @brief 跨度合并器：把按行递增顺序到来的水平跨度合并为尽量少的矩形。
+ * @note 与上一行某个矩形同列同宽的跨度并入该矩形（纵向延伸）；与同一行单行矩形相接或重叠的
+ *       跨度横向拼接。下边界已在当前行之上的矩形不可能再延伸，随即交给 sink 输出。
+ */
+class SpanMerger {
+ public:
+  /**
+   * @brief 构造合并器。
+   * @param clip 裁剪区域。
+   * @param sink 矩形输出回调。
+   * @param user 回调上下文。
+   */
+  SpanMerger(const Rect& clip, RectSink sink, void* user) noexcept
+      : clip_(clip), sink_(sink), user_(user) {}
+
+  /**
+   * @brief 加入一个跨度，要求 y 不小于此前加入的任何跨度。
+   * @param x0 左端 X（含）。
+   * @param x1 右端 X（含）。
+   * @param y 行号。
+   */
+  void add(int32_t x0, int32_t x1, int32_t y) noexcept {
+    if (error_ != 0 || y < clip_.y || y >= static_cast<int32_t>(clip_.y) + clip_.h) {
+      return;
+    }
+    if (x0 < clip_.x) {
+      x0 = clip_.x;
+    }
+    if (x1 >= static_cast<int32_t>(clip_.x) + clip_.w) {
+      x1 = static_cast<int32_t>(clip_.x) + clip_.w - 1;
+    }
+    if (x0 > x1) {
+      return;
+    }
+
+    const Rect span{static_cast<uint16_t>(x0), static_cast<uint16_t>(y),
+                    static_cast<uint16_t>(x1 - x0 + 1), 1U};
+    size_t i = 0U;
+    while (i < count_) {
+      if (static_cast<int32_t>(open_[i].y) + open_[i].h < y) {
+        emit(i);
+      } else {
+        ++i;
+      }
+    }
+
+    for (i = 0U; i < count_; ++i) {
+      Rect& rect = open_[i];
+      if (rect.y + rect.h > span.y && rect.x <= span.x && span.x + span.w <= rect.x + rect.w) {
+        /* 已被覆盖（如 1 像素宽边框的左右边重合）。 */
+        return;
+      }
+      if (rect.x == span.x && rect.w == span.w && rect.y + rect.h == span.y) {
+        ++rect.h;
+        return;
+      }
+      if (rect.h == 1U && rect.y == span.y && span.x <= rect.x + rect.w &&
+          rect.x <= span.x + span.w) {
+        const uint16_t right = static_cast<uint16_t>(
+            (rect.x + rect.w) > (span.x + span.w) ? (rect.x + rect.w) : (span.x + span.w));
+        rect.x = rect.x < span.x ? rect.x : span.x;
+        rect.w = static_cast<uint16_t>(right - rect.x);
+        return;
+      }
+    }
+
+    if (count_ == kMaxOpenRects) {
+      emit(0U);
+    }
+    if (error_ == 0) {
+      open_[count_++] = span;
+    }
+  }
+
+  /**
+   * @brief 获取裁剪区域。
+   * @return 裁剪区域。
+   */
+  const Rect& clip() const noexcept { return clip_; }
+
+  /**
+   * @brief 输出全部尚未输出的矩形。
+   * @return 0 表示成功；负值为 sink 返回的首个错误。
+   */
+  int finish() noexcept {
+    while (count_ != 0U && error_ == 0) {
+      emit(0U);
+    }
+    return error_;
+  }
+
+ private:
+  /**
+   * @brief 输出并移除第 i 个矩形。
+   * @param i 矩形下标。
+   */
+  void emit(size_t i) noexcept {
+    const int ret = sink_(open_[i], user_);
+    if (ret < 0) {
+      error_ = ret;
+    }
+    open_[i] = open_[--count_];
+  }
+
+  /** @brief 裁剪区域。 */
+  Rect clip_;
+  /** @brief 矩形输出回调。 */
+  RectSink sink_;
+  /** @brief 回调上下文。 */
+  void* user_;
+  /** @brief 仍可能向下延伸的矩形。 */
+  Rect open_[kMaxOpenRects]{};
+  /** @brief open_ 中的有效个数。 */
+  size_t count_ = 0U;
+  /** @brief sink 返回的首个错误。 */
+  int error_ = 0;
+};
+
+/**
+ * @brief 圆角矩形光栅化的公共实现（圆即边长 2r+1、圆角为 r 的圆角矩形）。
+ * @param x 左上角 X。
+ * @param y 左上角 Y。
+ * @param w 宽度。
+ * @param h 高度。
+ * @param r 圆角半径（已限制在短边一半以内）。
+ * @param filled true 为实心。
+ * @param merger 跨度合并器。
+ * @return 0 表示成功；负值为 sink 返回的错误。
+ * @note 圆角行的外沿取 4(dx^2 + dy^2) <= (2r+1)^2 的最大 dx，圆周内沿取 (2r-1)^2 对应的 dx，
+ *       两者之间即为该行的圆周像素，左右圆角共用同一组 dx。
+ */
+int rasterize_rounded(int32_t x, int32_t y, int32_t w, int32_t h, int32_t r, bool filled,
+                      SpanMerger& merger) noexcept {
+  const int32_t left_cx = x + r;
+  const int32_t right_cx = x + w - 1 - r;
+  const int32_t top_cy = y + r;
+  const int32_t bottom_cy = y + h - 1 - r;
+  const uint32_t diameter = 2U * static_cast<uint32_t>(r);
+  const uint32_t outer_sq = (diameter + 1U) * (diameter + 1U);
+  const uint32_t inner_sq = r > 0 ? (diameter - 1U) * (diameter - 1U) : 0U;
+
+  /* 只遍历裁剪区域内的行。 */
+  const int32_t first_row = y > merger.clip().y ? y : merger.clip().y;
+  const int32_t clip_bottom = static_cast<int32_t>(merger.clip().y) + merger.clip().h;
+  const int32_t end_row = (y + h) < clip_bottom ? (y + h) : clip_bottom;
+  for (int32_t row = first_row; row < end_row; ++row) {
+    int32_t dy = 0;
+    if (row < top_cy) {
+      dy = top_cy - row;
+    } else if (row > bottom_cy) {
+      dy = row - bottom_cy;
+    }
+    const uint32_t dy_sq4 = 4U * static_cast<uint32_t>(dy) * static_cast<uint32_t>(dy);
+    const int32_t outer = static_cast<int32_t>(isqrt(outer_sq - dy_sq4) >> 1);
+
+    if (filled || row == y || row == y + h - 1 || (dy != 0 && inner_sq < dy_sq4)) {
+      merger.add(left_cx - outer, right_cx + outer, row);
+    } else if (dy == 0) {
+      merger.add(x, x, row);
+      merger.add(x + w - 1, x + w - 1, row);
+    } else {
+      const int32_t inner = static_cast<int32_t>(isqrt(inner_sq - dy_sq4) >> 1);
+      merger.add(left_cx - outer, left_cx - inner - 1, row);
+      merger.add(right_cx + inner + 1, right_cx + outer, row);
+    }
+  }
+
+  return merger.finish();
+}
+
+}  // namespace
+
+namespace platform::raster {
+
+/**
+ * @brief 光栅化直线：Bresenham 逐像素推进，同一行的像素累积成一个跨度。
+ * @param x0 起点 X。
+ * @param y0 起点 Y。
+ * @param x1 终点 X。
+ * @param y1 终点 Y。
+ * @param clip 裁剪区域。
+ * @param sink 矩形输出回调。
+ * @param user 回调上下文。
+ * @return 0 表示成功；负值为 sink 返回的错误。
+ */
+int rasterize_line(int32_t x0, int32_t y0, int32_t x1, int32_t y1, const Rect& clip,
+                   RectSink sink, void* user) noexcept {
+  if (clip.w == 0U || clip.h == 0U) {
+    return 0;
+  }
+
+  /* 自上而下推进，保证跨度按行递增到达合并器。 */
+  if (y0 > y1) {
+    const int32_t tx = x0;
+    const int32_t ty = y0;
+    x0 = x1;
+    y0 = y1;
+    x1 = tx;
+    y1 = ty;
+  }
+
+  SpanMerger merger(clip, sink, user);
+  const int32_t clip_bottom = static_cast<int32_t>(clip.y) + clip.h;
+  const int32_t dx = x1 > x0 ? x1 - x0 : x0 - x1;
+  const int32_t dy = y0 - y1;
+  const int32_t step_x = x0 < x1 ? 1 : -1;
+  int32_t err = dx + dy;
+  int32_t x = x0;
+  int32_t y = y0;
+  int32_t run_start = x0;
+  int32_t run_y = y0;
+  while ((x != x1 || y != y1) && run_y < clip_bottom) {
+    const int32_t prev_x = x;
+    const int32_t e2 = 2 * err;
+    if (e2 >= dy) {
+      err += dy;
+      x += step_x;
+    }
+    if (e2 <= dx) {
+      err += dx;
+      ++y;
+    }
+    if (y != run_y) {
+      merger.add(run_start < prev_x ? run_start : prev_x, run_start < prev_x ? prev_x : run_start,
+                 run_y);
+      run_start = x;
+      run_y = y;
+    }
+  }
+  merger.add(run_start < x ? run_start : x, run_start < x ? x : run_start, run_y);
+  return merger.finish();
+}
+
+/**
+ * @brief 光栅化圆或实心圆。
+ * @param cx 圆心 X。
+ * @param cy 圆心 Y。
+ * @param r 半径。
+ * @param filled true 为实心。
+ * @param clip 裁剪区域。
+ * @param sink 矩形输出回调。
+ * @param user 回调上下文。
+ * @return 0 表示成功；负值为 sink 返回的错误。
+ */
+int rasterize_circle(int32_t cx, int32_t cy, uint16_t r, bool filled, const Rect& clip,
+                     RectSink sink, void* user) noexcept {
+  if (clip.w == 0U || clip.h == 0U) {
+    return 0;
+  }
+
+  SpanMerger merger(clip, sink, user);
+  const int32_t radius = r < kMaxRadius ? r : kMaxRadius;
+  return rasterize_rounded(cx - radius, cy - radius, 2 * radius + 1, 2 * radius + 1, radius,
+                           filled, merger);
+}
+
+/**
+ * @brief 光栅化圆角矩形或实心圆角矩形。
+ * @param x 左上角 X。
+ * @param y 左上角 Y。
+ * @param w 宽度。
+ * @param h 高度。
+ * @param r 圆角半径。
+ * @param filled true 为实心。
+ * @param clip 裁剪区域。
+ * @param sink 矩形输出回调。
+ * @param user 回调上下文。
+ * @return 0 表示成功；负值为 sink 返回的错误。
+ */
+int rasterize_round_rect(int32_t x, int32_t y, uint16_t w, uint16_t h, uint16_t r, bool filled,
+                         const Rect& clip, RectSink sink, void* user) noexcept {
+  if (w == 0U || h == 0U || clip.w == 0U || clip.h == 0U) {
+    return 0;
+  }
+
+  const uint16_t short_side = w < h ? w : h;
+  if (r > short_side / 2U) {
+    r = static_cast<uint16_t>(short_side / 2U);
+  }
+
+  SpanMerger merger(clip, sink, user);
+  return rasterize_rounded(x, y, w, h, r, filled, merger);
+}
+
+}  // namespace platform::raster
@@ -0,0 +1,147 @@
+/**
+ * @file sparkline.cpp
+ * @brief 环形扫描曲线控件实现。
+ */
+
+#include "platform/sparkline.hpp"
+
+#include <errno.h>
+
+namespace platform {
+
+/**
+ * @brief 设置图表区域、量程与配色。
+ * @param area 屏幕区域。
+ * @param min_value 量程下限。
+ * @param max_value 量程上限。
+ * @param style 配色。
+ * @return 0 成功；-EINVAL 参数非法。
+ */
+int SparklineChart::configure(const raster::Rect& area, int32_t min_value, int32_t max_value,
+                              const SparklineStyle& style) noexcept {
+  if (area.w < 2U || area.h == 0U || min_value >= max_value) {
+    return -EINVAL;
+  }
+
+  area_ = area;
+  min_value_ = min_value;
+  max_value_ = max_value;
+  style_ = style;
+  valid_ = false;
+  return 0;
+}
+
+/**
+ * @brief 清空图表区域并复位扫描位置。
+ * @param display 绘制目标。
+ * @return 0 成功；负值失败。
+ */
+int SparklineChart::reset(IDisplay& display) noexcept {
+  int ret = display.fill_rect(area_.x, area_.y, area_.w, area_.h, style_.bg_rgb565);
+  if (ret < 0) {
+    return ret;
+  }
+
+  cursor_ = 0U;
+  has_prev_ = false;
+  ret = fill_column(display, 0U, 0U, area_.h, style_.cursor_rgb565);
+  if (ret < 0) {
+    return ret;
+  }
+
+  valid_ = true;
+  return 0;
+}
+
+/**
+ * @brief 把样本值线性映射为行高。
+ * @param value 样本值。
+ * @return 行高（0 为底行，area_.h - 1 为顶行）。
+ */
+uint16_t SparklineChart::level_of(int32_t value) const noexcept {
+  if (value <= min_value_) {
+    return 0U;
+  }
+  if (value >= max_value_) {
+    return static_cast<uint16_t>(area_.h - 1U);
+  }
+
+  const int64_t span = static_cast<int64_t>(max_value_) - min_value_;
+  const int64_t offset = static_cast<int64_t>(value) - min_value_;
+  return static_cast<uint16_t>((offset * (area_.h - 1U) + span / 2) / span);
+}
+
+/**
+ * @brief 填充图表内的单列竖线。
+ * @param display 绘制目标。
+ * @param col 列。
+ * @param top 起始行。
+ * @param rows 行数。
+ * @param color_rgb565 颜色。
+ * @return 0 成功；负值失败。
+ */
+int SparklineChart::fill_column(IDisplay& display, uint16_t col, uint16_t top, uint16_t rows,
+                                uint16_t color_rgb565) noexcept {
+  if (rows == 0U) {
+    return 0;
+  }
+
+  return display.fill_rect(static_cast<uint16_t>(area_.x + col),
+                           static_cast<uint16_t>(area_.y + top), 1U, rows, color_rgb565);
+}
+
+/**
+ * @brief 追加样本：在光标处画出与上一样本相连的竖线段，光标右移一列。
+ * @param display 绘制目标。
+ * @param value 样本值。
+ * @return 0 成功；负值失败。
+ */
+int SparklineChart::push(IDisplay& display, int32_t value) noexcept {
+  if (area_.w == 0U) {
+    return -EINVAL;
+  }
+
+  int ret = 0;
+  if (!valid_) {
+    ret = reset(display);
+    if (ret < 0) {
+      return ret;
+    }
+  }
+
+  const uint16_t level = level_of(value);
+  uint16_t lo = level;
+  uint16_t hi = level;
+  if (has_prev_) {
+    lo = prev_level_ < level ? prev_level_ : level;
+    hi = prev_level_ > level ? prev_level_ : level;
+  }
+
+  /* 行高自底向上，屏幕行自顶向下：线段占据 [h-1-hi, h-1-lo]。 */
+  const uint16_t seg_top = static_cast<uint16_t>(area_.h - 1U - hi);
+  const uint16_t seg_rows = static_cast<uint16_t>(hi - lo + 1U);
+  const uint16_t below_top = static_cast<uint16_t>(seg_top + seg_rows);
+  const uint16_t next = static_cast<uint16_t>((cursor_ + 1U) % area_.w);
+  ret = fill_column(display, cursor_, 0U, seg_top, style_.bg_rgb565);
+  if (ret == 0) {
+    ret = fill_column(display, cursor_, seg_top, seg_rows, style_.fg_rgb565);
+  }
+  if (ret == 0) {
+    ret = fill_column(display, cursor_, below_top, static_cast<uint16_t>(area_.h - below_top),
+                      style_.bg_rgb565);
+  }
+  if (ret == 0) {
+    ret = fill_column(display, next, 0U, area_.h, style_.cursor_rgb565);
+  }
+  if (ret < 0) {
+    valid_ = false;
+    return ret;
+  }
+
+  cursor_ = next;
+  prev_level_ = level;
+  has_prev_ = true;
+  return 0;
+}
+
+}  // namespace platform
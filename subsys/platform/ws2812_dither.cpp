@@ -0,0 +1,90 @@
+/**
+ * @file ws2812_dither.cpp
+ * @brief WS2812 时间抖动实现.
+ */
+
+#include "platform/ws2812_dither.hpp"
+
+#include <string.h>
+
+namespace {
+
+/**
+ * @brief 8.8 定点通道值校正表.
+ */
+struct GammaTable16 {
+  /** @brief 各输入值对应的 8.8 输出值, 范围 0..kWs2812DitherLevelMax. */
+  uint16_t level[256];
+};
+
+/**
+ * @brief 在编译期生成 8.8 定点校正表.
+ * @return 校正表; 关闭 CONFIG_SKY_BOARD_WS2812_GAMMA 时为恒等映射.
+ * @note 与驱动中 8 bit 校正表同一条 CIE 1931 明度曲线, 只是保留了 8 bit 小数,
+ *       暗部相邻输入值不再被量化到同一级.
+ */
+constexpr GammaTable16 make_gamma_table16() {
+  GammaTable16 table{};
+  for (size_t i = 0U; i < 256U; ++i) {
+#if defined(CONFIG_SKY_BOARD_WS2812_GAMMA)
+    const double l = static_cast<double>(i) * 100.0 / 255.0;
+    const double t = (l + 16.0) / 116.0;
+    const double y = (l <= 8.0) ? (l / 903.3) : (t * t * t);
+    table.level[i] = static_cast<uint16_t>(y * platform::kWs2812DitherLevelMax + 0.5);
+#else
+    table.level[i] = static_cast<uint16_t>(i << 8);
+#endif
+  }
+  return table;
+}
+
+/** @brief 8.8 定点校正表 (512 字节, 常量区, 各实例共用). */
+constexpr GammaTable16 kGamma16 = make_gamma_table16();
+
+static_assert(kGamma16.level[255] == platform::kWs2812DitherLevelMax,
+              "full scale must map to 255.0");
+
+}  // namespace
+
+namespace platform {
+
+/**
+ * @brief 绑定残差存储并复位残差.
+ * @param residuals 残差缓冲.
+ * @param pixel_count 像素个数.
+ */
+Ws2812Dither::Ws2812Dither(uint8_t* residuals, const size_t pixel_count) noexcept
+    : residuals_(residuals), pixel_count_(pixel_count) {
+  reset();
+}
+
+/**
+ * @brief 按亮度重建 8.8 目标值表.
+ * @param brightness 全局亮度, 范围 0..255.
+ * @note 亮度不变时不重建, 每帧只剩查表与残差累加.
+ */
+void Ws2812Dither::set_brightness(const uint8_t brightness) noexcept {
+  if (target_valid_ && target_brightness_ == brightness) {
+    return;
+  }
+
+  for (size_t i = 0U; i < 256U; ++i) {
+    const uint32_t scaled =
+        static_cast<uint32_t>(kGamma16.level[i]) * static_cast<uint32_t>(brightness);
+    target_[i] = static_cast<uint16_t>((scaled + 127U) / 255U);
+  }
+  target_brightness_ = brightness;
+  target_valid_ = true;
+}
+
+/**
+ * @brief 把全部残差复位为 0.5.
+ */
+void Ws2812Dither::reset() noexcept {
+  if (residuals_ != nullptr) {
+    (void)memset(residuals_, 0x80, pixel_count_ * 3U);
+  }
+  fraction_ = 0U;
+}
+
+}  // namespace platform
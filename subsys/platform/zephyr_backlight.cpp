@@ -1,12 +1,13 @@
 /**
  * @file zephyr_backlight.cpp
- * @brief IBacklight 的 Zephyr PWM 后端实现。
+ * @brief IBacklight 的 Zephyr PWM 后端实现：感知亮度曲线、定时器渐变与空闲自动调暗。
  */
 
 #include <errno.h>
 #include <zephyr/device.h>
 #include <zephyr/devicetree.h>
 #include <zephyr/drivers/pwm.h>
+#include <zephyr/kernel.h>
 
 #include "platform/platform_backlight.hpp"
 
@@ -15,8 +16,69 @@ namespace {
 /** @brief 背光 PWM 节点（aliases: pwm-led0 -> backlight_pwm）。 */
 #define BACKLIGHT_PWM_NODE DT_ALIAS(pwm_led0)
 
+/** @brief 渐变步进周期（毫秒），100 Hz 下肉眼看不出台阶。 */
+constexpr uint32_t kFadeStepMs = 10U;
+/** @brief 内部亮度的定点小数位：以 1/256 % 为单位，慢速渐变也能逐步推进。 */
+constexpr uint32_t kLevelShift = 8U;
+/** @brief 感知亮度档位数（0~100 %）。 */
+constexpr size_t kGammaPoints = 101U;
+
+/**
+ * @brief 感知亮度到 PWM 占空比的查表。
+ */
+struct GammaTable {
+  /** @brief 各百分比档位对应的占空比，Q16（65535 为全亮）。 */
+  uint16_t duty[kGammaPoints];
+};
+
+/**
+ * @brief 按 CIE 1931 明度公式在编译期生成感知亮度表。
+ * @return 感知亮度表。
+ * @note 人眼对亮度近似呈立方根响应，线性占空比会让低亮度区间变化过快、高亮度区间几乎无感。
+ */
+constexpr GammaTable make_gamma_table() {
+  GammaTable table{};
+  for (size_t i = 0U; i < kGammaPoints; ++i) {
+    const double l = static_cast<double>(i);
+    const double t = (l + 16.0) / 116.0;
+    const double y = (l <= 8.0) ? (l / 903.3) : (t * t * t);
+    table.duty[i] = static_cast<uint16_t>(y * 65535.0 + 0.5);
+  }
+  return table;
+}
+
+/** @brief 感知亮度表（202 字节，常量区）。 */
+constexpr GammaTable kGamma = make_gamma_table();
+
+/**
+ * @brief 把定点感知亮度换算为 Q16 占空比，档位之间线性插值。
+ * @param level 感知亮度，单位 1/256 %。
+ * @return Q16 占空比。
+ */
+uint32_t level_to_duty(uint32_t level) noexcept {
+  const uint32_t idx = level >> kLevelShift;
+  if (idx >= kGammaPoints - 1U) {
+    return kGamma.duty[kGammaPoints - 1U];
+  }
+  const uint32_t frac = level & ((1U << kLevelShift) - 1U);
+  const uint32_t lo = kGamma.duty[idx];
+  const uint32_t hi = kGamma.duty[idx + 1U];
+  return lo + (((hi - lo) * frac) >> kLevelShift);
+}
+
+void on_fade_tick(struct k_timer* timer);
+void on_idle_expired(struct k_timer* timer);
+
+/** @brief 渐变步进定时器：仅在渐变进行中运行，结束后自行停止。 */
+K_TIMER_DEFINE(g_fade_timer, on_fade_tick, nullptr);
+/** @brief 空闲计时器：到期后把背光调暗。 */
+K_TIMER_DEFINE(g_idle_timer, on_idle_expired, nullptr);
+
 /**
  * @brief 基于 Zephyr PWM 的背光实现。
+ * @note 渐变与空闲策略都在 k_timer 到期回调（中断上下文）中推进，不占用线程；
+ *       状态由自旋锁保护，线程与回调都可以调用。
+ *       STM32 PWM 驱动的 set_cycles 只写定时器寄存器，可在中断上下文调用。
  */
 class ZephyrBacklight final : public platform::IBacklight {
  public:
@@ -28,34 +90,184 @@ class ZephyrBacklight final : public platform::IBacklight {
   int set_enabled(bool on) noexcept override { return set_brightness(on ? 100U : 0U); }
 
   /**
-   * @brief 设置背光亮度百分比。
-   * @param percent 亮度百分比（0~100）。
+   * @brief 立即设置背光亮度，取消进行中的渐变。
+   * @param percent 感知亮度百分比（0~100）。
    * @return 0 成功；负值失败。
    */
-  int set_brightness(uint8_t percent) noexcept override {
+  int set_brightness(uint8_t percent) noexcept override { return fade_to(percent, 0U); }
+
+  /**
+   * @brief 在 duration_ms 内渐变到目标亮度。
+   * @param percent 感知亮度百分比（0~100）。
+   * @param duration_ms 渐变时长，0 表示立即生效。
+   * @return 0 成功；负值失败。
+   */
+  int fade_to(uint8_t percent, uint32_t duration_ms) noexcept override {
     if (percent > 100U) {
       percent = 100U;
     }
 
 #if DT_NODE_HAS_STATUS(BACKLIGHT_PWM_NODE, okay)
-    static const struct pwm_dt_spec backlight_pwm = PWM_DT_SPEC_GET(BACKLIGHT_PWM_NODE);
-    if (!device_is_ready(backlight_pwm.dev)) {
+    if (!device_is_ready(pwm_.dev)) {
       return -ENODEV;
     }
 
-    /* period 与极性来自 DTS（含 PWM_POLARITY_INVERTED）。 */
-    const uint32_t pulse = (backlight_pwm.period * static_cast<uint32_t>(percent)) / 100U;
-    return pwm_set_dt(&backlight_pwm, backlight_pwm.period, pulse);
+    k_spinlock_key_t key = k_spin_lock(&lock_);
+    user_percent_ = percent;
+    dimmed_ = false;
+    const int ret = start_fade_locked(static_cast<uint32_t>(percent) << kLevelShift, duration_ms);
+    k_spin_unlock(&lock_, key);
+
+    restart_idle_timer();
+    return ret;
 #else
     (void)percent;
+    (void)duration_ms;
     return -ENOTSUP;
 #endif
   }
+
+  /**
+   * @brief 上报一次用户操作：已调暗时恢复亮度，并重新开始空闲计时。
+   */
+  void user_activity() noexcept {
+#if DT_NODE_HAS_STATUS(BACKLIGHT_PWM_NODE, okay)
+    k_spinlock_key_t key = k_spin_lock(&lock_);
+    if (dimmed_) {
+      dimmed_ = false;
+      (void)start_fade_locked(static_cast<uint32_t>(user_percent_) << kLevelShift,
+                              CONFIG_SKY_BOARD_BACKLIGHT_FADE_MS);
+    }
+    k_spin_unlock(&lock_, key);
+
+    restart_idle_timer();
+#endif
+  }
+
+  /**
+   * @brief 推进一步渐变（渐变定时器回调）。
+   */
+  void fade_tick() noexcept {
+    k_spinlock_key_t key = k_spin_lock(&lock_);
+    if (step_ < steps_) {
+      ++step_;
+      const int32_t span = static_cast<int32_t>(to_) - static_cast<int32_t>(from_);
+      level_ = static_cast<uint32_t>(static_cast<int32_t>(from_) +
+                                     (span * static_cast<int32_t>(step_)) /
+                                         static_cast<int32_t>(steps_));
+      (void)apply_locked();
+    }
+    if (step_ >= steps_) {
+      k_timer_stop(&g_fade_timer);
+    }
+    k_spin_unlock(&lock_, key);
+  }
+
+  /**
+   * @brief 空闲超时：渐变到调暗亮度（空闲定时器回调）。
+   */
+  void idle_expired() noexcept {
+    k_spinlock_key_t key = k_spin_lock(&lock_);
+    const uint8_t dim = CONFIG_SKY_BOARD_BACKLIGHT_IDLE_PERCENT;
+    if (!dimmed_ && user_percent_ > dim) {
+      dimmed_ = true;
+      (void)start_fade_locked(static_cast<uint32_t>(dim) << kLevelShift,
+                              CONFIG_SKY_BOARD_BACKLIGHT_IDLE_FADE_MS);
+    }
+    k_spin_unlock(&lock_, key);
+  }
+
+ private:
+  /**
+   * @brief 从当前亮度开始一段渐变；时长不足一步时立即写入目标亮度。
+   * @param target 目标亮度，单位 1/256 %。
+   * @param duration_ms 渐变时长。
+   * @return 0 成功；负值为立即写入时 PWM 的错误码。
+   * @note 调用方需持有 lock_。
+   */
+  int start_fade_locked(uint32_t target, uint32_t duration_ms) noexcept {
+    from_ = level_;
+    to_ = target;
+    step_ = 0U;
+    steps_ = duration_ms / kFadeStepMs;
+    if (steps_ == 0U || from_ == to_) {
+      k_timer_stop(&g_fade_timer);
+      steps_ = 0U;
+      level_ = to_;
+      return apply_locked();
+    }
+    k_timer_start(&g_fade_timer, K_MSEC(kFadeStepMs), K_MSEC(kFadeStepMs));
+    return 0;
+  }
+
+  /**
+   * @brief 把当前亮度写入 PWM。
+   * @return 0 成功；负值失败。
+   * @note 调用方需持有 lock_。
+   */
+  int apply_locked() noexcept {
+#if DT_NODE_HAS_STATUS(BACKLIGHT_PWM_NODE, okay)
+    /* period 与极性来自 DTS（含 PWM_POLARITY_INVERTED）。 */
+    const uint32_t pulse = static_cast<uint32_t>(
+        (static_cast<uint64_t>(pwm_.period) * level_to_duty(level_)) / 65535U);
+    return pwm_set_dt(&pwm_, pwm_.period, pulse);
+#else
+    return -ENOTSUP;
+#endif
+  }
+
+  /**
+   * @brief 重新开始空闲计时；CONFIG_SKY_BOARD_BACKLIGHT_IDLE_DIM_S 为 0 时不调暗。
+   */
+  static void restart_idle_timer() noexcept {
+    if (CONFIG_SKY_BOARD_BACKLIGHT_IDLE_DIM_S > 0) {
+      k_timer_start(&g_idle_timer, K_SECONDS(CONFIG_SKY_BOARD_BACKLIGHT_IDLE_DIM_S), K_NO_WAIT);
+    }
+  }
+
+#if DT_NODE_HAS_STATUS(BACKLIGHT_PWM_NODE, okay)
+  /** @brief 背光 PWM 规格。 */
+  const struct pwm_dt_spec pwm_ = PWM_DT_SPEC_GET(BACKLIGHT_PWM_NODE);
+#endif
+  /** @brief 保护以下渐变状态（线程与定时器回调共用）。 */
+  struct k_spinlock lock_ {};
+  /** @brief 当前输出亮度，单位 1/256 %。 */
+  uint32_t level_ = 0U;
+  /** @brief 渐变起点亮度。 */
+  uint32_t from_ = 0U;
+  /** @brief 渐变终点亮度。 */
+  uint32_t to_ = 0U;
+  /** @brief 已完成的渐变步数。 */
+  uint32_t step_ = 0U;
+  /** @brief 渐变总步数，0 表示没有进行中的渐变。 */
+  uint32_t steps_ = 0U;
+  /** @brief 应用设定的亮度百分比，空闲唤醒后恢复到该值。 */
+  uint8_t user_percent_ = 0U;
+  /** @brief 当前是否处于空闲调暗状态。 */
+  bool dimmed_ = false;
 };
 
 /** @brief 全局背光实例。 */
 ZephyrBacklight g_backlight;
 
+/**
+ * @brief 渐变定时器到期回调。
+ * @param timer 定时器，未使用。
+ */
+void on_fade_tick(struct k_timer* timer) {
+  (void)timer;
+  g_backlight.fade_tick();
+}
+
+/**
+ * @brief 空闲定时器到期回调。
+ * @param timer 定时器，未使用。
+ */
+void on_idle_expired(struct k_timer* timer) {
+  (void)timer;
+  g_backlight.idle_expired();
+}
+
 }  // namespace
 
 namespace platform {
@@ -66,4 +278,9 @@ namespace platform {
  */
 IBacklight& backlight() { return g_backlight; }
 
+/**
+ * @brief 上报用户操作，重置背光空闲计时。
+ */
+void backlight_user_activity() noexcept { g_backlight.user_activity(); }
+
 }  // namespace platform
@@ -0,0 +1,717 @@
+/**
+ * @file zephyr_benchmark.cpp
+ * @brief 显示与灯带相关热点路径的启动期微基准实现。
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+
+#include "platform/cjk_font.hpp"
+#include "platform/display_raster.hpp"
+#include "platform/font5x7.hpp"
+#include "platform/platform_benchmark.hpp"
+#include "platform/platform_spi_flash.hpp"
+#include "platform/rle_image.hpp"
+#include "platform/ws2812_dither.hpp"
+
+namespace {
+
+/** @brief 每种缩放倍数的计时轮数（每轮遍历全部可显示字符）。 */
+constexpr uint32_t kFontIterations = 20U;
+/** @brief 参与基准的最大缩放倍数。 */
+constexpr uint8_t kFontMaxScale = 3U;
+/** @brief 可显示 ASCII 字符个数（0x20~0x7E）。 */
+constexpr uint8_t kGlyphCount = 0x7EU - 0x20U + 1U;
+/** @brief 单个字符单元在最大缩放下的像素数。 */
+constexpr size_t kCellPixels = static_cast<size_t>(platform::raster::kCellWidth) * kFontMaxScale *
+                               platform::raster::kCellHeight * kFontMaxScale;
+
+/** @brief 旧实现输出缓冲。 */
+uint16_t g_legacy_cell[kCellPixels];
+/** @brief 新实现输出缓冲。 */
+uint16_t g_atlas_cell[kCellPixels];
+
+/**
+ * @brief 旧版字形行展开：按列读取列优先字模，每像素按位分支选择颜色。
+ * @param dst 目标行缓冲。
+ * @param c 字符。
+ * @param glyph_row 字形行号。
+ * @param fg_rgb565 前景色。
+ * @param bg_rgb565 背景色。
+ * @param scale 缩放倍数。
+ */
+void legacy_glyph_row(uint16_t* dst, char c, uint8_t glyph_row, uint16_t fg_rgb565,
+                      uint16_t bg_rgb565, uint8_t scale) noexcept {
+  const uint8_t* glyph = platform::font5x7::glyph(c);
+  uint16_t px = 0U;
+  for (uint8_t col = 0U; col < platform::raster::kCellWidth; ++col) {
+    const bool on = col < platform::font5x7::kWidth && ((glyph[col] >> glyph_row) & 0x01U) != 0U;
+    const uint16_t color = on ? fg_rgb565 : bg_rgb565;
+    for (uint8_t sub = 0U; sub < scale; ++sub) {
+      dst[px++] = color;
+    }
+  }
+}
+
+/**
+ * @brief 用指定实现把一个字符的全部字形行展开到单元缓冲。
+ * @param legacy true 使用旧实现，false 使用行掩码实现。
+ * @param dst 单元缓冲。
+ * @param c 字符。
+ * @param scale 缩放倍数。
+ */
+void render_cell(bool legacy, uint16_t* dst, char c, uint8_t scale) noexcept {
+  const uint16_t cell_px = static_cast<uint16_t>(platform::raster::kCellWidth * scale);
+  for (uint8_t row = 0U; row < platform::raster::kCellHeight; ++row) {
+    uint16_t* out = &dst[static_cast<size_t>(row) * cell_px];
+    if (legacy) {
+      legacy_glyph_row(out, c, row, 0xFFFFU, 0x0000U, scale);
+    } else {
+      platform::raster::rasterize_text_row(out, 0U, cell_px, &c, 1U, row, 0xFFFFU, 0x0000U,
+                                           scale);
+    }
+  }
+}
+
+/**
+ * @brief 计时：遍历全部字符 kFontIterations 轮，返回每字形平均周期数。
+ * @param legacy true 使用旧实现，false 使用行掩码实现。
+ * @param scale 缩放倍数。
+ * @return 每字形平均周期数。
+ */
+uint32_t time_cells(bool legacy, uint8_t scale) noexcept {
+  uint16_t* dst = legacy ? g_legacy_cell : g_atlas_cell;
+  k_sched_lock();
+  const uint32_t start = k_cycle_get_32();
+  for (uint32_t it = 0U; it < kFontIterations; ++it) {
+    for (uint8_t g = 0U; g < kGlyphCount; ++g) {
+      render_cell(legacy, dst, static_cast<char>(0x20U + g), scale);
+    }
+  }
+  const uint32_t cycles = k_cycle_get_32() - start;
+  k_sched_unlock();
+  return cycles / (kFontIterations * kGlyphCount);
+}
+
+/** @brief 合成图像宽度（像素）。 */
+constexpr uint16_t kImageWidth = 240U;
+/** @brief 合成图像高度（像素）。 */
+constexpr uint16_t kImageHeight = 8U;
+/** @brief 合成图像像素数。 */
+constexpr size_t kImagePixels = static_cast<size_t>(kImageWidth) * kImageHeight;
+/** @brief RLE 包的最大像素数。 */
+constexpr size_t kPacketMax = 128U;
+/** @brief 编码结果上限：文件头 + 全部为字面包时的像素与包头。 */
+constexpr size_t kImageMaxBytes = sizeof(platform::raster::ImageHeader) +
+                                  kImagePixels * sizeof(uint16_t) + kImagePixels / kPacketMax + 1U;
+/** @brief 图像解码计时轮数。 */
+constexpr uint32_t kImageIterations = 20U;
+
+/** @brief 编码后的图像资源。 */
+uint8_t g_image_blob[kImageMaxBytes];
+/** @brief 编码后的图像资源字节数。 */
+size_t g_image_bytes = 0U;
+/** @brief 解码输出缓冲。 */
+uint16_t g_image_out[kImagePixels];
+/** @brief 基准使用的解码器。 */
+platform::raster::RleImageReader g_image_reader;
+
+/**
+ * @brief 以 RAM 数组模拟只读 SPI Flash，使基准不依赖外置 Flash 内容。
+ */
+class RamFlash final : public platform::ISpiFlash {
+ public:
+  /**
+   * @brief 指定模拟 Flash 的内容。
+   * @param data 数据起点。
+   * @param size 字节数。
+   */
+  void assign(const uint8_t* data, size_t size) noexcept {
+    data_ = data;
+    size_ = size;
+  }
+
+  int init() noexcept override { return 0; }
+
+  int read(off_t offset, void* buffer, size_t len) noexcept override {
+    if (offset < 0 || static_cast<size_t>(offset) + len > size_) {
+      return -EINVAL;
+    }
+    (void)memcpy(buffer, &data_[offset], len);
+    return 0;
+  }
+
+  int write(off_t offset, const void* data, size_t len) noexcept override {
+    (void)offset;
+    (void)data;
+    (void)len;
+    return -ENOTSUP;
+  }
+
+  int erase(off_t offset, size_t len) noexcept override {
+    (void)offset;
+    (void)len;
+    return -ENOTSUP;
+  }
+
+  int get_size(uint64_t& out_size) noexcept override {
+    out_size = size_;
+    return 0;
+  }
+
+ private:
+  /** @brief 数据起点。 */
+  const uint8_t* data_ = nullptr;
+  /** @brief 字节数。 */
+  size_t size_ = 0U;
+};
+
+/** @brief RAM 模拟 Flash 实例。 */
+RamFlash g_ram_flash;
+
+/**
+ * @brief 合成图像像素：上下两块纯色背景，中间一条 32 像素宽的渐变带（产生字面包）。
+ * @param index 行优先像素下标。
+ * @return RGB565 像素值。
+ */
+uint16_t image_pixel(size_t index) noexcept {
+  const size_t x = index % kImageWidth;
+  const size_t y = index / kImageWidth;
+  if (x >= 96U && x < 128U) {
+    return static_cast<uint16_t>(x * 33U + y * 2048U);
+  }
+  return y < kImageHeight / 2U ? 0x001FU : 0xFFFFU;
+}
+
+/**
+ * @brief 按 rle_image.hpp 描述的格式把合成图像编码为 RGB565 RLE 资源。
+ * @return 资源字节数。
+ */
+size_t encode_image() noexcept {
+  platform::raster::ImageHeader header{};
+  header.magic = platform::raster::kImageMagic;
+  header.width = kImageWidth;
+  header.height = kImageHeight;
+  header.format = static_cast<uint8_t>(platform::raster::ImageFormat::kRgb565Rle);
+
+  size_t pos = sizeof(header);
+  size_t i = 0U;
+  while (i < kImagePixels) {
+    const uint16_t color = image_pixel(i);
+    size_t run = 1U;
+    while (i + run < kImagePixels && run < kPacketMax &&
+           image_pixel(i + run) == color) {
+      ++run;
+    }
+    if (run >= 2U) {
+      g_image_blob[pos++] = static_cast<uint8_t>(0x80U | (run - 1U));
+      (void)memcpy(&g_image_blob[pos], &color, sizeof(color));
+      pos += sizeof(color);
+      i += run;
+      continue;
+    }
+
+    const size_t head = pos++;
+    size_t count = 0U;
+    while (i < kImagePixels && count < kPacketMax) {
+      const uint16_t px = image_pixel(i);
+      if (count > 0U && i + 1U < kImagePixels && image_pixel(i + 1U) == px) {
+        break;
+      }
+      (void)memcpy(&g_image_blob[pos], &px, sizeof(px));
+      pos += sizeof(px);
+      ++count;
+      ++i;
+    }
+    g_image_blob[head] = static_cast<uint8_t>(count - 1U);
+  }
+
+  header.payload_bytes = static_cast<uint32_t>(pos - sizeof(header));
+  (void)memcpy(g_image_blob, &header, sizeof(header));
+  return pos;
+}
+
+/**
+ * @brief 从 RAM 模拟 Flash 解码整幅图像。
+ * @return 0 成功；负值失败。
+ */
+int decode_image() noexcept {
+  const int ret = g_image_reader.open(g_ram_flash, 0U);
+  if (ret < 0) {
+    return ret;
+  }
+  return g_image_reader.read_rows(g_image_out, kImageWidth, 0U, kImageWidth, kImageHeight);
+}
+
+#if defined(CONFIG_SKY_BOARD_CJK_FONT)
+/** @brief 合成字库字形数。 */
+constexpr uint32_t kCjkBenchGlyphs = 256U;
+/** @brief 合成字库首个码点；码点间隔 3，查找不能退化为按下标直接定位。 */
+constexpr uint32_t kCjkBenchFirstCodepoint = 0x4E00U;
+/** @brief 原始位图每行字节数。 */
+constexpr size_t kCjkRowBytes = (platform::raster::kCjkGlyphSize + 7U) / 8U;
+/** @brief 原始位图字节数。 */
+constexpr size_t kCjkRawBytes = kCjkRowBytes * platform::raster::kCjkGlyphSize;
+/** @brief 合成字库字节数上限。 */
+constexpr size_t kCjkFontMaxBytes =
+    sizeof(platform::raster::CjkFontHeader) +
+    kCjkBenchGlyphs * (sizeof(platform::raster::CjkIndexEntry) + 2U + kCjkRawBytes);
+/** @brief 未命中/命中计时使用的字形数：不超过缓存容量，未命中阶段不发生淘汰。 */
+constexpr uint32_t kCjkProbeGlyphs =
+    platform::raster::kCjkCacheSlots < kCjkBenchGlyphs
+        ? static_cast<uint32_t>(platform::raster::kCjkCacheSlots)
+        : kCjkBenchGlyphs;
+/** @brief 渲染计时的一行字形数（铺满 kImageWidth）。 */
+constexpr uint32_t kCjkLineGlyphs = kImageWidth / platform::raster::kCjkGlyphSize;
+/** @brief 字库基准计时轮数。 */
+constexpr uint32_t kCjkIterations = 20U;
+
+/** @brief 合成字库。 */
+uint8_t g_cjk_blob[kCjkFontMaxBytes];
+/** @brief 合成字库所在的 RAM 模拟 Flash。 */
+RamFlash g_cjk_flash;
+/** @brief 基准专用字库实例，不影响全局字库缓存。 */
+platform::raster::CjkFont g_cjk_bench_font;
+
+/**
+ * @brief 合成字库第 index 个字形的码点。
+ * @param index 字形序号。
+ * @return 码点。
+ */
+uint32_t cjk_codepoint(uint32_t index) noexcept {
+  return kCjkBenchFirstCodepoint + index * 3U;
+}
+
+/**
+ * @brief 合成字形行：两道横笔加一道竖笔，每 8 个字形夹一个棋盘格（走原始位图编码）。
+ * @param index 字形序号。
+ * @param row 行号。
+ * @return 行掩码，bit0 为最左像素。
+ */
+uint16_t cjk_glyph_row(uint32_t index, uint8_t row) noexcept {
+  constexpr uint8_t kSize = platform::raster::kCjkGlyphSize;
+  constexpr uint16_t kFull = static_cast<uint16_t>((1U << kSize) - 1U);
+  if (index % 8U == 0U) {
+    return static_cast<uint16_t>(((row & 1U) != 0U ? 0x5555U : 0xAAAAU) & kFull);
+  }
+
+  uint16_t mask = static_cast<uint16_t>(1U << (1U + index % (kSize - 2U)));
+  if (row == 1U + index % 4U || row == kSize - 2U) {
+    mask |= static_cast<uint16_t>(kFull & ~1U & ~(1U << (kSize - 1U)));
+  }
+  return mask;
+}
+
+/**
+ * @brief 读取合成字形行优先比特流中的一个像素。
+ * @param index 字形序号。
+ * @param pos 像素序号。
+ * @return true 为前景。
+ */
+bool cjk_glyph_bit(uint32_t index, uint32_t pos) noexcept {
+  constexpr uint8_t kSize = platform::raster::kCjkGlyphSize;
+  return ((cjk_glyph_row(index, static_cast<uint8_t>(pos / kSize)) >> (pos % kSize)) & 0x01U) !=
+         0U;
+}
+
+/**
+ * @brief 追加一个 4 bit 游程。
+ * @param payload 负载缓冲。
+ * @param count 已写入的游程数。
+ * @param run 游程长度（0~15）。
+ * @return false 表示超过原始位图长度，应改用原始编码。
+ */
+bool put_run(uint8_t* payload, size_t& count, uint32_t run) noexcept {
+  if (count >= kCjkRawBytes * 2U) {
+    return false;
+  }
+  uint8_t& byte = payload[count / 2U];
+  byte = (count & 1U) != 0U ? static_cast<uint8_t>(byte | run) : static_cast<uint8_t>(run << 4);
+  ++count;
+  return true;
+}
+
+/**
+ * @brief 按 cjk_font.hpp 描述的格式编码一个字形记录，取游程与原始位图中较短者。
+ * @param index 字形序号。
+ * @param out 记录输出。
+ * @return 记录字节数。
+ */
+size_t encode_cjk_glyph(uint32_t index, uint8_t* out) noexcept {
+  constexpr uint32_t kPixels =
+      static_cast<uint32_t>(platform::raster::kCjkGlyphSize) * platform::raster::kCjkGlyphSize;
+  uint32_t end = 0U;
+  for (uint32_t pos = 0U; pos < kPixels; ++pos) {
+    if (cjk_glyph_bit(index, pos)) {
+      end = pos + 1U;
+    }
+  }
+
+  size_t count = 0U;
+  bool fits = true;
+  bool ink = false;
+  uint32_t pos = 0U;
+  while (pos < end && fits) {
+    uint32_t run = 0U;
+    while (pos < end && cjk_glyph_bit(index, pos) == ink && run < 15U) {
+      ++run;
+      ++pos;
+    }
+    fits = put_run(&out[2], count, run);
+    if (run == 15U && pos < end && cjk_glyph_bit(index, pos) == ink) {
+      fits = fits && put_run(&out[2], count, 0U);
+    } else {
+      ink = !ink;
+    }
+  }
+  if (fits && (count & 1U) != 0U) {
+    fits = put_run(&out[2], count, 0U);
+  }
+  if (fits && count / 2U < kCjkRawBytes) {
+    out[0] = platform::raster::kCjkGlyphRuns;
+    out[1] = static_cast<uint8_t>(count / 2U);
+    return 2U + count / 2U;
+  }
+
+  out[0] = platform::raster::kCjkGlyphRaw;
+  out[1] = static_cast<uint8_t>(kCjkRawBytes);
+  for (uint8_t row = 0U; row < platform::raster::kCjkGlyphSize; ++row) {
+    const uint16_t mask = cjk_glyph_row(index, row);
+    for (size_t b = 0U; b < kCjkRowBytes; ++b) {
+      out[2U + row * kCjkRowBytes + b] = static_cast<uint8_t>(mask >> (8U * b));
+    }
+  }
+  return 2U + kCjkRawBytes;
+}
+
+/**
+ * @brief 生成合成字库：文件头、按码点升序的索引与字形记录。
+ * @return 字库字节数。
+ */
+size_t build_cjk_font() noexcept {
+  size_t pos = sizeof(platform::raster::CjkFontHeader) +
+               kCjkBenchGlyphs * sizeof(platform::raster::CjkIndexEntry);
+  for (uint32_t i = 0U; i < kCjkBenchGlyphs; ++i) {
+    const platform::raster::CjkIndexEntry entry{cjk_codepoint(i), static_cast<uint32_t>(pos)};
+    (void)memcpy(&g_cjk_blob[sizeof(platform::raster::CjkFontHeader) + i * sizeof(entry)], &entry,
+                 sizeof(entry));
+    pos += encode_cjk_glyph(i, &g_cjk_blob[pos]);
+  }
+
+  platform::raster::CjkFontHeader header{};
+  header.magic = platform::raster::kCjkFontMagic;
+  header.width = platform::raster::kCjkGlyphSize;
+  header.height = platform::raster::kCjkGlyphSize;
+  header.glyph_count = kCjkBenchGlyphs;
+  header.total_bytes = static_cast<uint32_t>(pos);
+  (void)memcpy(g_cjk_blob, &header, sizeof(header));
+  return pos;
+}
+
+/**
+ * @brief 逐个查找并比对全部合成字形，再确认缺字返回 -ENOENT。
+ * @return 0 一致；-EIO 不一致；其他负值为查找失败。
+ */
+int verify_cjk_font() noexcept {
+  int ret = 0;
+  platform::raster::CjkGlyph glyph{};
+  g_cjk_bench_font.lock();
+  for (uint32_t i = 0U; i < kCjkBenchGlyphs && ret == 0; ++i) {
+    ret = g_cjk_bench_font.get(cjk_codepoint(i), glyph);
+    for (uint8_t row = 0U; row < platform::raster::kCjkGlyphSize && ret == 0; ++row) {
+      if (glyph.rows[row] != cjk_glyph_row(i, row)) {
+        ret = -EIO;
+      }
+    }
+  }
+  if (ret == 0 && g_cjk_bench_font.get(cjk_codepoint(0U) + 1U, glyph) != -ENOENT) {
+    ret = -EIO;
+  }
+  g_cjk_bench_font.unlock();
+  return ret;
+}
+
+/**
+ * @brief 计时：查找 kCjkProbeGlyphs 个均匀分布的字形，返回总周期数。
+ * @return 周期数。
+ */
+uint32_t time_cjk_lookups() noexcept {
+  platform::raster::CjkGlyph glyph{};
+  g_cjk_bench_font.lock();
+  k_sched_lock();
+  const uint32_t start = k_cycle_get_32();
+  for (uint32_t i = 0U; i < kCjkProbeGlyphs; ++i) {
+    (void)g_cjk_bench_font.get(cjk_codepoint(i * (kCjkBenchGlyphs / kCjkProbeGlyphs)), glyph);
+  }
+  const uint32_t cycles = k_cycle_get_32() - start;
+  k_sched_unlock();
+  g_cjk_bench_font.unlock();
+  return cycles;
+}
+#endif
+
+#if defined(CONFIG_SKY_BOARD_WS2812_DITHER)
+/** @brief 抖动基准的像素数。 */
+constexpr size_t kDitherPixels = 256U;
+/** @brief 抖动基准的全局亮度：暗部只剩少数 8 bit 级的典型场景。 */
+constexpr uint8_t kDitherBrightness = 16U;
+/** @brief 抖动计时与校验的帧数：残差以 256 帧为周期回到初值。 */
+constexpr uint32_t kDitherFrames = 256U;
+
+/** @brief 合成像素：R 递增、G 递减、B 半速递增的渐变。 */
+platform::Ws2812Rgb g_dither_pixels[kDitherPixels];
+/** @brief 量化输出缓冲。 */
+platform::Ws2812Rgb g_dither_out[kDitherPixels];
+/** @brief 基准专用残差缓冲。 */
+uint8_t g_dither_residuals[kDitherPixels * 3U];
+/** @brief 各通道连续 kDitherFrames 帧的输出之和。 */
+uint16_t g_dither_sums[kDitherPixels * 3U];
+/** @brief 基准专用抖动器。 */
+platform::Ws2812Dither g_dither(g_dither_residuals, kDitherPixels);
+/** @brief 对照用 8 bit 亮度表：8.8 目标值四舍五入，与不抖动时驱动的查表等价。 */
+uint8_t g_dither_lut[256];
+
+/**
+ * @brief 量化一帧合成像素。
+ * @param dither true 使用时间抖动，false 使用 8 bit 亮度表。
+ */
+void quantize_frame(bool dither) noexcept {
+  if (dither) {
+    g_dither.begin_frame();
+    for (size_t i = 0U; i < kDitherPixels; ++i) {
+      g_dither_out[i] = g_dither.apply(i, g_dither_pixels[i]);
+    }
+    return;
+  }
+  for (size_t i = 0U; i < kDitherPixels; ++i) {
+    const platform::Ws2812Rgb& px = g_dither_pixels[i];
+    g_dither_out[i] = {g_dither_lut[px.r], g_dither_lut[px.g], g_dither_lut[px.b]};
+  }
+}
+
+/**
+ * @brief 计时：量化 kDitherFrames 帧，返回每帧平均周期数。
+ * @param dither true 使用时间抖动，false 使用 8 bit 亮度表。
+ * @return 每帧平均周期数。
+ */
+uint32_t time_dither(bool dither) noexcept {
+  k_sched_lock();
+  const uint32_t start = k_cycle_get_32();
+  for (uint32_t frame = 0U; frame < kDitherFrames; ++frame) {
+    quantize_frame(dither);
+  }
+  const uint32_t cycles = k_cycle_get_32() - start;
+  k_sched_unlock();
+  return cycles / kDitherFrames;
+}
+#endif
+
+}  // namespace
+
+namespace platform {
+
+/**
+ * @brief 5x7 字形行光栅化基准。
+ * @param log 日志接口。
+ * @return 0 表示输出一致；-EIO 表示输出不一致。
+ */
+int benchmark_font_raster(ILogger& log) noexcept {
+  int ret = 0;
+  for (uint8_t scale = 1U; scale <= kFontMaxScale; ++scale) {
+    /* 先逐字符比对两种实现的输出，保证计时对象等价。 */
+    const size_t cell_bytes = static_cast<size_t>(raster::kCellWidth) * scale *
+                              raster::kCellHeight * sizeof(g_legacy_cell[0]);
+    for (uint8_t g = 0U; g < kGlyphCount; ++g) {
+      const char c = static_cast<char>(0x20U + g);
+      render_cell(true, g_legacy_cell, c, scale);
+      render_cell(false, g_atlas_cell, c, scale);
+      if (memcmp(g_legacy_cell, g_atlas_cell, cell_bytes) != 0) {
+        log.errorf("[bench] font5x7 mismatch char=0x%02X scale=%u", static_cast<unsigned int>(c),
+                   static_cast<unsigned int>(scale));
+        ret = -EIO;
+        break;
+      }
+    }
+
+    const uint32_t legacy_cycles = time_cells(true, scale);
+    const uint32_t atlas_cycles = time_cells(false, scale);
+    log.infof("[bench] font5x7 scale=%u legacy=%lu atlas=%lu cycles/glyph",
+              static_cast<unsigned int>(scale), static_cast<unsigned long>(legacy_cycles),
+              static_cast<unsigned long>(atlas_cycles));
+  }
+  return ret;
+}
+
+/**
+ * @brief RLE 图像解码基准。
+ * @param log 日志接口。
+ * @return 0 表示解码结果一致；负值表示失败。
+ */
+int benchmark_rle_decode(ILogger& log) noexcept {
+  g_image_bytes = encode_image();
+  g_ram_flash.assign(g_image_blob, g_image_bytes);
+  int ret = decode_image();
+  if (ret < 0) {
+    log.error("[bench] rle decode failed", ret);
+    return ret;
+  }
+  for (size_t i = 0U; i < kImagePixels; ++i) {
+    if (g_image_out[i] != image_pixel(i)) {
+      log.errorf("[bench] rle mismatch pixel=%lu", static_cast<unsigned long>(i));
+      return -EIO;
+    }
+  }
+
+  k_sched_lock();
+  const uint32_t start = k_cycle_get_32();
+  for (uint32_t it = 0U; it < kImageIterations && ret == 0; ++it) {
+    ret = decode_image();
+  }
+  const uint32_t cycles = k_cycle_get_32() - start;
+  k_sched_unlock();
+
+  log.infof("[bench] rle image %ux%u bytes=%lu raw=%lu decode=%lu cycles/kpx",
+            static_cast<unsigned int>(kImageWidth), static_cast<unsigned int>(kImageHeight),
+            static_cast<unsigned long>(g_image_bytes),
+            static_cast<unsigned long>(kImagePixels * sizeof(uint16_t)),
+            static_cast<unsigned long>(cycles / (kImageIterations * kImagePixels / 1000U)));
+  return ret;
+}
+
+#if defined(CONFIG_SKY_BOARD_CJK_FONT)
+/**
+ * @brief 中文字库查找与渲染基准。
+ * @param log 日志接口。
+ * @return 0 表示查找结果一致；负值表示失败。
+ */
+int benchmark_cjk_font(ILogger& log) noexcept {
+  const size_t bytes = build_cjk_font();
+  g_cjk_flash.assign(g_cjk_blob, bytes);
+  g_cjk_bench_font.lock();
+  g_cjk_bench_font.attach(g_cjk_flash, 0U);
+  g_cjk_bench_font.unlock();
+
+  int ret = verify_cjk_font();
+  if (ret < 0) {
+    log.error("[bench] cjk font self-check failed", ret);
+    return ret;
+  }
+
+  /* 未命中：每轮先清空缓存；命中：沿用最后一轮未命中后填满的缓存。 */
+  uint32_t miss_cycles = 0U;
+  raster::CjkFontStats stats{};
+  for (uint32_t it = 0U; it < kCjkIterations; ++it) {
+    g_cjk_bench_font.clear();
+    miss_cycles += time_cjk_lookups();
+  }
+  g_cjk_bench_font.get_stats(stats);
+  uint32_t hit_cycles = 0U;
+  for (uint32_t it = 0U; it < kCjkIterations; ++it) {
+    hit_cycles += time_cjk_lookups();
+  }
+
+  /* 渲染：一行铺满 kImageWidth 的字形（缓存已预热），按 kImageHeight 行分块光栅化。 */
+  char line[kCjkLineGlyphs * 3U];
+  for (uint32_t i = 0U; i < kCjkLineGlyphs; ++i) {
+    const uint32_t cp = cjk_codepoint(i * (kCjkBenchGlyphs / kCjkProbeGlyphs));
+    line[i * 3U] = static_cast<char>(0xE0U | (cp >> 12));
+    line[i * 3U + 1U] = static_cast<char>(0x80U | ((cp >> 6) & 0x3FU));
+    line[i * 3U + 2U] = static_cast<char>(0x80U | (cp & 0x3FU));
+  }
+  constexpr uint16_t kLineHeight = raster::utf8_line_height(1U);
+  k_sched_lock();
+  const uint32_t start = k_cycle_get_32();
+  for (uint32_t it = 0U; it < kCjkIterations; ++it) {
+    for (uint16_t row = 0U; row < kLineHeight; row = static_cast<uint16_t>(row + kImageHeight)) {
+      const uint16_t rows = static_cast<uint16_t>(
+          (kLineHeight - row) < kImageHeight ? (kLineHeight - row) : kImageHeight);
+      raster::rasterize_utf8_block(g_cjk_bench_font, g_image_out, kImageWidth, 0U, kImageWidth,
+                                   row, rows, line, sizeof(line), 0xFFFFU, 0x0000U, 1U);
+    }
+  }
+  const uint32_t render_cycles = k_cycle_get_32() - start;
+  k_sched_unlock();
+
+  const uint32_t lookups = kCjkIterations * kCjkProbeGlyphs;
+  log.infof("[bench] cjk font %ux%u glyphs=%u bytes=%lu miss=%lu hit=%lu cycles/lookup",
+            static_cast<unsigned int>(raster::kCjkGlyphSize),
+            static_cast<unsigned int>(raster::kCjkGlyphSize),
+            static_cast<unsigned int>(kCjkBenchGlyphs), static_cast<unsigned long>(bytes),
+            static_cast<unsigned long>(miss_cycles / lookups),
+            static_cast<unsigned long>(hit_cycles / lookups));
+  log.infof("[bench] cjk font reads/miss=%lu render=%lu cycles/glyph",
+            static_cast<unsigned long>(stats.misses != 0U ? stats.flash_reads / stats.misses : 0U),
+            static_cast<unsigned long>(render_cycles / (kCjkIterations * kCjkLineGlyphs)));
+  return 0;
+}
+#endif
+
+#if defined(CONFIG_SKY_BOARD_WS2812_DITHER)
+/**
+ * @brief WS2812 时间抖动基准。
+ * @param log 日志接口。
+ * @return 0 表示抖动平均值一致；-EIO 表示不一致。
+ */
+int benchmark_ws2812_dither(ILogger& log) noexcept {
+  for (size_t i = 0U; i < kDitherPixels; ++i) {
+    g_dither_pixels[i] = {static_cast<uint8_t>(i), static_cast<uint8_t>(255U - i),
+                          static_cast<uint8_t>(i / 2U)};
+  }
+  g_dither.set_brightness(kDitherBrightness);
+  g_dither.reset();
+  uint32_t lut_levels = 0U;
+  uint32_t dither_levels = 0U;
+  for (size_t v = 0U; v < 256U; ++v) {
+    const uint16_t target = g_dither.target(static_cast<uint8_t>(v));
+    g_dither_lut[v] = static_cast<uint8_t>((target + 0x80U) >> 8);
+    if (v == 0U || g_dither_lut[v] != g_dither_lut[v - 1U]) {
+      ++lut_levels;
+    }
+    if (v == 0U || target != g_dither.target(static_cast<uint8_t>(v - 1U))) {
+      ++dither_levels;
+    }
+  }
+
+  /* 残差从 0.5 出发，256 帧后回到初值，因此输出之和恰好等于 8.8 目标值。 */
+  (void)memset(g_dither_sums, 0, sizeof(g_dither_sums));
+  for (uint32_t frame = 0U; frame < kDitherFrames; ++frame) {
+    quantize_frame(true);
+    for (size_t i = 0U; i < kDitherPixels; ++i) {
+      g_dither_sums[i * 3U] = static_cast<uint16_t>(g_dither_sums[i * 3U] + g_dither_out[i].r);
+      g_dither_sums[i * 3U + 1U] =
+          static_cast<uint16_t>(g_dither_sums[i * 3U + 1U] + g_dither_out[i].g);
+      g_dither_sums[i * 3U + 2U] =
+          static_cast<uint16_t>(g_dither_sums[i * 3U + 2U] + g_dither_out[i].b);
+    }
+  }
+  int ret = 0;
+  for (size_t i = 0U; i < kDitherPixels && ret == 0; ++i) {
+    const platform::Ws2812Rgb& px = g_dither_pixels[i];
+    if (g_dither_sums[i * 3U] != g_dither.target(px.r) ||
+        g_dither_sums[i * 3U + 1U] != g_dither.target(px.g) ||
+        g_dither_sums[i * 3U + 2U] != g_dither.target(px.b)) {
+      log.errorf("[bench] ws2812 dither average mismatch pixel=%lu",
+                 static_cast<unsigned long>(i));
+      ret = -EIO;
+    }
+  }
+
+  const uint32_t lut_cycles = time_dither(false);
+  const uint32_t dither_cycles = time_dither(true);
+  /* LED 帧周期内的 CPU 周期数，用于折算抖动开销所占比例。 */
+  const uint64_t budget_cycles = static_cast<uint64_t>(sys_clock_hw_cycles_per_sec()) *
+                                 CONFIG_SKY_BOARD_LED_EFFECT_PERIOD_MS / 1000U;
+  const uint64_t dither_ppm =
+      budget_cycles != 0U ? static_cast<uint64_t>(dither_cycles) * 1000000U / budget_cycles : 0U;
+  log.infof("[bench] ws2812 dither brightness=%u levels lut=%lu dither=%lu",
+            static_cast<unsigned int>(kDitherBrightness), static_cast<unsigned long>(lut_levels),
+            static_cast<unsigned long>(dither_levels));
+  log.infof("[bench] ws2812 dither px=%lu lut=%lu dither=%lu cycles/frame budget=%lu ppm",
+            static_cast<unsigned long>(kDitherPixels), static_cast<unsigned long>(lut_cycles),
+            static_cast<unsigned long>(dither_cycles), static_cast<unsigned long>(dither_ppm));
+  return ret;
+}
+#endif
+
+}  // namespace platform
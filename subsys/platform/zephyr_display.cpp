@@ -7,15 +7,182 @@
 #include <zephyr/device.h>
 #include <zephyr/devicetree.h>
 #include <zephyr/drivers/display.h>
-
+#include <zephyr/kernel.h>
+#if defined(CONFIG_SKY_BOARD_DISPLAY_CONSOLE)
+#include <zephyr/drivers/mipi_dbi.h>
+#endif
+#if defined(CONFIG_SKY_BOARD_DISPLAY_STATS)
+#include <stdio.h>
+#endif
+#if defined(CONFIG_SKY_BOARD_CJK_FONT)
+#include <string.h>
+#endif
+
+#include "platform/cjk_font.hpp"
+#include "platform/display_raster.hpp"
 #include "platform/font5x7.hpp"
+#include "platform/palette_framebuffer.hpp"
 #include "platform/platform_backlight.hpp"
 #include "platform/platform_display.hpp"
+#include "platform/platform_spi_flash.hpp"
+#include "platform/rle_image.hpp"
+#include "platform/screen_capture.hpp"
+#include "platform/shape_raster.hpp"
 
 namespace {
 
 /** @brief 静态行缓冲支持的最大屏幕宽度。 */
 constexpr uint16_t kMaxDisplayWidth = 320U;
+/** @brief 条带缓冲行数（Kconfig 可调），即单次 display_write 可覆盖的最大行数。 */
+constexpr uint16_t kStripRows = CONFIG_SKY_BOARD_DISPLAY_STRIP_ROWS;
+/** @brief 条带缓冲像素数：kMaxDisplayWidth 宽 x kStripRows 行。 */
+constexpr size_t kStripBufferPixels = static_cast<size_t>(kMaxDisplayWidth) * kStripRows;
+
+#if defined(CONFIG_SKY_BOARD_DISPLAY_CONSOLE)
+/** @brief 显示屏 devicetree 节点。 */
+#define SKY_DISPLAY_NODE DT_CHOSEN(zephyr_display)
+
+/** @brief ST7789 垂直滚动区定义命令（TFA/VSA/BFA）。 */
+constexpr uint8_t kCmdVscrdef = 0x33U;
+/** @brief ST7789 垂直滚动起始地址命令（VSP）。 */
+constexpr uint8_t kCmdVscsad = 0x37U;
+/** @brief ST7789 帧存储器行数，滚动区三段之和必须等于该值。 */
+constexpr uint16_t kFrameMemoryLines = 320U;
+/** @brief 控制台行高（字形 7 行 + 1 行间隔）。 */
+constexpr uint16_t kConsoleLineHeight = platform::raster::kCellHeight + platform::font5x7::kSpacing;
+/** @brief 控制台背景色。 */
+constexpr uint16_t kConsoleBg = 0x0000U;
+/** @brief 控制台信息级文本颜色（浅灰）。 */
+constexpr uint16_t kConsoleInfoFg = 0xC618U;
+/** @brief 控制台错误级文本颜色（红）。 */
+constexpr uint16_t kConsoleErrorFg = 0xF8C3U;
+
+/** @brief 面板所挂 MIPI-DBI 控制器，用于发送驱动未封装的滚动命令。 */
+const struct device* const g_mipi_dbi_dev = DEVICE_DT_GET(DT_PARENT(SKY_DISPLAY_NODE));
+/** @brief 与面板驱动一致的 MIPI-DBI 总线配置。 */
+const struct mipi_dbi_config g_mipi_dbi_config =
+    MIPI_DBI_CONFIG_DT(SKY_DISPLAY_NODE, SPI_OP_MODE_MASTER | SPI_WORD_SET(8), 0);
+
+/** @brief 串行化控制台写入与模式切换（日志可能来自任意线程）。 */
+K_MUTEX_DEFINE(g_console_mutex);
+#endif
+
+#if defined(CONFIG_SKY_BOARD_DISPLAY_STATS)
+/** @brief 操作名称，顺序与 platform::DisplayOp 一致。 */
+constexpr const char* kDisplayOpNames[] = {"clear", "fill",    "text", "blit",
+                                           "image", "flush",   "console", "shape"};
+static_assert(sizeof(kDisplayOpNames) / sizeof(kDisplayOpNames[0]) ==
+                  static_cast<size_t>(platform::DisplayOp::kCount),
+              "display op names must match platform::DisplayOp");
+
+/** @brief 保护 g_display_stats（绘制线程、控制台日志线程与读取方并发访问）。 */
+K_MUTEX_DEFINE(g_display_stats_mutex);
+/** @brief 显示统计累计值。 */
+platform::DisplayStats g_display_stats;
+
+/**
+ * @brief 计算耗时所属的直方图桶。
+ * @param us 耗时（微秒）。
+ * @return 桶下标。
+ */
+size_t stats_bucket(uint32_t us) noexcept {
+  size_t bucket = 0U;
+  uint32_t limit = platform::kDisplayStatsFirstBucketUs;
+  while (bucket + 1U < platform::kDisplayStatsBuckets && us >= limit) {
+    ++bucket;
+    limit <<= 1;
+  }
+  return bucket;
+}
+
+/**
+ * @brief 记录一次 display_write。
+ * @param pixels 像素数。
+ * @param bytes 字节数。
+ * @param cycles 耗时（硬件周期）。
+ */
+void stats_record_write(uint32_t pixels, uint32_t bytes, uint32_t cycles) noexcept {
+  const uint32_t us = k_cyc_to_us_floor32(cycles);
+  (void)k_mutex_lock(&g_display_stats_mutex, K_FOREVER);
+  ++g_display_stats.write_calls;
+  g_display_stats.write_pixels += pixels;
+  g_display_stats.write_bytes += bytes;
+  g_display_stats.write_us += us;
+  (void)k_mutex_unlock(&g_display_stats_mutex);
+}
+
+/**
+ * @brief 记录一次绘制操作。
+ * @param op 操作种类。
+ * @param cycles 耗时（硬件周期）。
+ */
+void stats_record_op(platform::DisplayOp op, uint32_t cycles) noexcept {
+  const uint32_t us = k_cyc_to_us_floor32(cycles);
+  (void)k_mutex_lock(&g_display_stats_mutex, K_FOREVER);
+  platform::DisplayOpStats& stats = g_display_stats.ops[static_cast<size_t>(op)];
+  ++stats.calls;
+  stats.total_us += us;
+  if (us > stats.max_us) {
+    stats.max_us = us;
+  }
+  ++stats.histogram[stats_bucket(us)];
+  (void)k_mutex_unlock(&g_display_stats_mutex);
+}
+
+/**
+ * @brief 绘制操作计时器：构造时读取周期计数，析构时把耗时计入对应操作。
+ */
+class OpTimer {
+ public:
+  explicit OpTimer(platform::DisplayOp op) noexcept : op_(op), start_(k_cycle_get_32()) {}
+  ~OpTimer() { stats_record_op(op_, k_cycle_get_32() - start_); }
+  OpTimer(const OpTimer&) = delete;
+  OpTimer& operator=(const OpTimer&) = delete;
+
+ private:
+  /** @brief 操作种类。 */
+  platform::DisplayOp op_;
+  /** @brief 起始周期计数。 */
+  uint32_t start_;
+};
+#else
+/**
+ * @brief 未启用统计时的空计时器。
+ */
+class OpTimer {
+ public:
+  explicit OpTimer(platform::DisplayOp op) noexcept { (void)op; }
+};
+#endif
+
+/**
+ * @brief display_write 包装：启用统计时记录调用次数、像素、字节与总线耗时，
+ *        启用屏幕镜像时把写入成功的像素交给捕获器。
+ * @param dev 显示设备。
+ * @param x 左上角 X。
+ * @param y 左上角 Y。
+ * @param desc 缓冲描述（pitch 等于 width）。
+ * @param buf 像素数据。
+ * @return display_write 的返回值。
+ */
+int panel_write(const struct device* dev, uint16_t x, uint16_t y,
+                const struct display_buffer_descriptor* desc, const void* buf) noexcept {
+#if defined(CONFIG_SKY_BOARD_DISPLAY_STATS)
+  const uint32_t start = k_cycle_get_32();
+  const int ret = display_write(dev, x, y, desc, buf);
+  stats_record_write(static_cast<uint32_t>(desc->width) * desc->height, desc->buf_size,
+                     k_cycle_get_32() - start);
+#else
+  const int ret = display_write(dev, x, y, desc, buf);
+#endif
+#if defined(CONFIG_SKY_BOARD_SCREEN_MIRROR)
+  if (ret == 0) {
+    platform::screen_capture().record(x, y, desc->width, desc->height,
+                                      static_cast<const uint16_t*>(buf));
+  }
+#endif
+  return ret;
+}
 /**
  * @brief 把 8-bit RGB 颜色转换为 RGB565。
  * @param r 红色分量。
@@ -26,6 +193,7 @@ constexpr uint16_t kMaxDisplayWidth = 320U;
 constexpr uint16_t rgb565(uint8_t r, uint8_t g, uint8_t b) {
   return static_cast<uint16_t>(((r & 0xF8U) << 8) | ((g & 0xFCU) << 3) | (b >> 3));
 }
+
 /**
  * @brief Zephyr Display API 的平台实现。
  */
@@ -68,6 +236,44 @@ class ZephyrDisplay final : public platform::IDisplay {
   int fill_rect(uint16_t x, uint16_t y, uint16_t w, uint16_t h,
                 uint16_t color_rgb565) noexcept override;
 
+  /**
+   * @brief 绘制 1 像素宽直线。
+   * @param x0 起点 X。
+   * @param y0 起点 Y。
+   * @param x1 终点 X。
+   * @param y1 终点 Y。
+   * @param color_rgb565 RGB565 颜色值。
+   * @return 0 成功；负值失败。
+   */
+  int draw_line(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                uint16_t color_rgb565) noexcept override;
+
+  /**
+   * @brief 绘制圆或实心圆。
+   * @param cx 圆心 X。
+   * @param cy 圆心 Y。
+   * @param r 半径。
+   * @param color_rgb565 RGB565 颜色值。
+   * @param filled true 为实心。
+   * @return 0 成功；负值失败。
+   */
+  int draw_circle(int16_t cx, int16_t cy, uint16_t r, uint16_t color_rgb565,
+                  bool filled) noexcept override;
+
+  /**
+   * @brief 绘制圆角矩形或实心圆角矩形。
+   * @param x 左上角 X。
+   * @param y 左上角 Y。
+   * @param w 宽度。
+   * @param h 高度。
+   * @param r 圆角半径。
+   * @param color_rgb565 RGB565 颜色值。
+   * @param filled true 为实心。
+   * @return 0 成功；负值失败。
+   */
+  int draw_round_rect(int16_t x, int16_t y, uint16_t w, uint16_t h, uint16_t r,
+                      uint16_t color_rgb565, bool filled) noexcept override;
+
   /**
    * @brief 绘制单个 5x7 字符（可缩放）。
    * @param x 左上角 X。
@@ -107,19 +313,110 @@ class ZephyrDisplay final : public platform::IDisplay {
   int draw_int(uint16_t x, uint16_t y, int32_t value, uint16_t fg_rgb565, uint16_t bg_rgb565,
                uint8_t scale) noexcept override;
 
+  /**
+   * @brief 写入预先光栅化的像素块。
+   * @param x 左上角 X。
+   * @param y 左上角 Y。
+   * @param w 宽度。
+   * @param h 高度。
+   * @param pixels 像素数据。
+   * @return 0 成功；负值失败。
+   */
+  int blit(uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+           const uint16_t* pixels) noexcept override;
+
+  /**
+   * @brief 从外置 SPI Flash 流式解码并绘制 RLE 图像。
+   * @param x 左上角 X。
+   * @param y 左上角 Y。
+   * @param flash_offset 图像资源偏移。
+   * @return 0 成功；负值失败。
+   */
+  int draw_image(uint16_t x, uint16_t y, uint32_t flash_offset) noexcept override;
+
   /**
    * @brief 绘制启动测试画面。
    * @return 0 成功；负值失败。
    */
   int show_boot_screen() noexcept override;
 
+  /**
+   * @brief 切换绘制模式。
+   * @param mode 目标模式。
+   * @return 0 成功；负值失败。
+   */
+  int set_mode(platform::DisplayMode mode) noexcept override;
+
+  /**
+   * @brief 获取当前绘制模式。
+   * @return 当前模式。
+   */
+  platform::DisplayMode mode() const noexcept override { return mode_; }
+
+  /**
+   * @brief 下发保留模式下记录的内容或帧缓冲脏区域。
+   * @return 0 成功；负值失败。
+   */
+  int flush() noexcept override;
+
   /**
    * @brief 获取显示关联的背光控制接口。
    * @return IBacklight 引用。
    */
   platform::IBacklight& backlight() noexcept override;
 
+#if defined(CONFIG_SKY_BOARD_DISPLAY_CONSOLE)
+  /**
+   * @brief 向滚动控制台追加文本。
+   * @param text 文本，超出屏宽或遇到 '\n' 时折行。
+   * @param error true 表示错误级。
+   * @return 0 成功；-ENODEV 未处于控制台模式；其他负值失败。
+   */
+  int console_write(const char* text, bool error) noexcept;
+#endif
+
  private:
+  /**
+   * @brief 图元光栅化输出目标，作为 RectSink 的上下文。
+   */
+  struct ShapeTarget {
+    /** @brief 所属显示实例。 */
+    ZephyrDisplay* display = nullptr;
+    /** @brief 图元颜色。 */
+    uint16_t color_rgb565 = 0U;
+    /** @brief 调色板帧缓冲模式下的颜色索引。 */
+    uint8_t color_index = 0U;
+  };
+
+  /**
+   * @brief 普通绘制入口的公共前置检查：确保已初始化且面板未被控制台独占。
+   * @return 0 可以绘制；-EBUSY 控制台模式；其他负值为初始化失败。
+   */
+  int prepare_draw() noexcept;
+
+  /**
+   * @brief 图元绘制的公共前置处理：检查状态、保留模式下先 flush，并准备输出目标。
+   * @param color_rgb565 图元颜色。
+   * @param[out] target 输出目标。
+   * @return 0 可以绘制；负值失败。
+   */
+  int begin_shape(uint16_t color_rgb565, ShapeTarget& target) noexcept;
+
+  /**
+   * @brief 图元光栅化的矩形输出：写入面板或调色板帧缓冲。
+   * @param rect 已裁剪到屏幕内的矩形。
+   * @param user ShapeTarget 指针。
+   * @return 0 成功；负值失败。
+   */
+  static int shape_sink(const platform::raster::Rect& rect, void* user);
+
+  /**
+   * @brief 获取整屏裁剪区域。
+   * @return 整屏矩形。
+   */
+  platform::raster::Rect screen_rect() const noexcept {
+    return {0U, 0U, caps_.x_resolution, caps_.y_resolution};
+  }
   /**
    * @brief 执行矩形区域写入（假设参数已完成校验/裁剪）。
    * @param x 左上角 X。
@@ -132,14 +429,110 @@ class ZephyrDisplay final : public platform::IDisplay {
   int write_solid_rect(uint16_t x, uint16_t y, uint16_t w, uint16_t h,
                        uint16_t color_rgb565) noexcept;
 
+  /**
+   * @brief 把连续 RGB565 像素块一次性写入矩形区域（假设参数已完成校验/裁剪）。
+   * @param x 左上角 X。
+   * @param y 左上角 Y。
+   * @param w 宽度（同时作为 pitch）。
+   * @param h 高度。
+   * @param pixels 按行连续存放的 w*h 个像素。
+   * @return 0 成功；负值失败。
+   */
+  int write_block(uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+                  const uint16_t* pixels) noexcept;
+
+  /**
+   * @brief 把单行文本（不含 '\n'）整体光栅化进条带缓冲并按条带下发。
+   * @param x 起始 X。
+   * @param y 起始 Y。
+   * @param text 文本指针。
+   * @param len 文本字符数。
+   * @param fg_rgb565 前景色。
+   * @param bg_rgb565 背景色。
+   * @param scale 缩放倍数（>= 1）。
+   * @return 0 成功；负值失败。
+   * @note 每个条带只产生一次 display_write；scale 较小时整行即一次传输。
+   */
+  int render_text_line(uint16_t x, uint16_t y, const char* text, size_t len, uint16_t fg_rgb565,
+                       uint16_t bg_rgb565, uint8_t scale) noexcept;
+
+#if defined(CONFIG_SKY_BOARD_CJK_FONT)
+  /**
+   * @brief 把含多字节字符的单行 UTF-8 文本（不含 '\n'）按条带光栅化并下发。
+   * @param x 起始 X。
+   * @param y 起始 Y。
+   * @param text 文本指针。
+   * @param len 文本字节数。
+   * @param fg_rgb565 前景色。
+   * @param bg_rgb565 背景色。
+   * @param scale 缩放倍数（>= 1）。
+   * @return 0 成功；负值失败。
+   * @note 保持模式下先提交已记录的命令再直接绘制；调色板模式写入帧缓冲。
+   */
+  int render_utf8_line(uint16_t x, uint16_t y, const char* text, size_t len, uint16_t fg_rgb565,
+                       uint16_t bg_rgb565, uint8_t scale) noexcept;
+#endif
+
+#if defined(CONFIG_SKY_BOARD_DISPLAY_PALETTE_FB)
+  /**
+   * @brief 把调色板帧缓冲的脏区域展开为 RGB565 并按条带下发。
+   * @return 0 成功；负值失败。
+   */
+  int flush_framebuffer() noexcept;
+#endif
+
+#if defined(CONFIG_SKY_BOARD_DISPLAY_CONSOLE)
+  /**
+   * @brief 进入控制台模式：定义全屏滚动区、复位滚动指针并清屏。
+   * @return 0 成功；负值失败（模式回退为立即模式）。
+   */
+  int console_begin() noexcept;
+
+  /**
+   * @brief 设置硬件滚动起始行。
+   * @param line 帧存储器行号。
+   * @return 0 成功；负值失败。
+   */
+  int console_scroll_to(uint16_t line) noexcept;
+
+  /**
+   * @brief 在控制台最新一行绘制文本并滚动。
+   * @param text 文本指针。
+   * @param len 字符数（不超过一行可容纳的字符数）。
+   * @param fg_rgb565 文本颜色。
+   * @return 0 成功；负值失败。
+   */
+  int console_put_line(const char* text, size_t len, uint16_t fg_rgb565) noexcept;
+#endif
+
   /** @brief 显示设备句柄。 */
   const struct device* display_dev_ = nullptr;
   /** @brief 显示能力缓存。 */
   struct display_capabilities caps_{};
   /** @brief 初始化状态标志。 */
   bool initialized_ = false;
-  /** @brief 单行 RGB565 缓冲。 */
-  uint16_t line_buf_[kMaxDisplayWidth]{};
+  /** @brief 当前绘制模式。 */
+  platform::DisplayMode mode_ = platform::DisplayMode::kImmediate;
+  /** @brief 保留模式显示列表。 */
+  platform::raster::DisplayList list_{};
+  /** @brief 多行 RGB565 条带缓冲，文本行与单色块填充共用；按字对齐以支持整字填充。 */
+  alignas(4) uint16_t strip_buf_[kStripBufferPixels]{};
+  /** @brief 图像资源流式解码器。 */
+  platform::raster::RleImageReader image_reader_{};
+#if defined(CONFIG_SKY_BOARD_DISPLAY_PALETTE_FB)
+  /** @brief 4bpp 调色板离屏帧缓冲（kPaletteFramebuffer 模式）。 */
+  platform::raster::PaletteFramebuffer fb_{};
+#endif
+#if defined(CONFIG_SKY_BOARD_DISPLAY_CONSOLE)
+  /** @brief 控制台行数（屏高 / 行高）。 */
+  uint16_t console_rows_ = 0U;
+  /** @brief 下一行写入的控制台行号。 */
+  uint16_t console_head_ = 0U;
+  /** @brief 控制台是否已写满一屏（此后每行都需要滚动）。 */
+  bool console_full_ = false;
+  /** @brief 当前硬件滚动起始行。 */
+  uint16_t console_scroll_ = 0U;
+#endif
 };
 
 /** @brief 全局显示实例。 */
@@ -187,19 +580,22 @@ int ZephyrDisplay::write_solid_rect(uint16_t x, uint16_t y, uint16_t w, uint16_t
     return -ENOMEM;
   }
 
-  for (uint16_t i = 0U; i < w; ++i) {
-    line_buf_[i] = color_rgb565;
-  }
+  /* 单色块只需填充一次条带缓冲，随后每个 display_write 覆盖 block_rows 行。 */
+  const uint16_t max_rows = static_cast<uint16_t>(kStripBufferPixels / w);
+  const uint16_t block_rows = h < max_rows ? h : max_rows;
+  platform::raster::fill_rgb565_words(strip_buf_, static_cast<size_t>(w) * block_rows,
+                                      color_rgb565);
 
   struct display_buffer_descriptor desc{};
   desc.width = w;
-  desc.height = 1U;
   desc.pitch = w;
-  desc.buf_size = static_cast<uint32_t>(w) * sizeof(line_buf_[0]);
 
-  for (uint16_t row = 0U; row < h; ++row) {
-    desc.frame_incomplete = (row + 1U) < h;
-    int ret = display_write(display_dev_, x, y + row, &desc, line_buf_);
+  for (uint16_t row = 0U; row < h; row = static_cast<uint16_t>(row + block_rows)) {
+    const uint16_t rows = static_cast<uint16_t>((h - row) < block_rows ? (h - row) : block_rows);
+    desc.height = rows;
+    desc.buf_size = static_cast<uint32_t>(w) * rows * sizeof(strip_buf_[0]);
+    desc.frame_incomplete = (row + rows) < h;
+    int ret = panel_write(display_dev_, x, static_cast<uint16_t>(y + row), &desc, strip_buf_);
     if (ret < 0) {
       return ret;
     }
@@ -208,6 +604,30 @@ int ZephyrDisplay::write_solid_rect(uint16_t x, uint16_t y, uint16_t w, uint16_t
   return 0;
 }
 
+/**
+ * @brief 以单次 display_write 推送连续像素块。
+ * @param x 左上角 X。
+ * @param y 左上角 Y。
+ * @param w 宽度。
+ * @param h 高度。
+ * @param pixels 像素数据。
+ * @return 0 成功；负值失败。
+ */
+int ZephyrDisplay::write_block(uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+                               const uint16_t* pixels) noexcept {
+  if (w == 0U || h == 0U) {
+    return 0;
+  }
+
+  struct display_buffer_descriptor desc{};
+  desc.width = w;
+  desc.height = h;
+  desc.pitch = w;
+  desc.buf_size = static_cast<uint32_t>(w) * h * sizeof(pixels[0]);
+  desc.frame_incomplete = false;
+  return panel_write(display_dev_, x, y, &desc, pixels);
+}
+
 /**
  * @brief 初始化显示设备。
  * @return 0 成功；负值失败。
@@ -257,18 +677,49 @@ int ZephyrDisplay::init() noexcept {
   return 0;
 }
 
+/**
+ * @brief 普通绘制入口的公共前置检查。
+ * @return 0 可以绘制；-EBUSY 控制台模式；其他负值为初始化失败。
+ */
+int ZephyrDisplay::prepare_draw() noexcept {
+  const int ret = init();
+  if (ret < 0) {
+    return ret;
+  }
+
+  /* 控制台模式下帧存储器按滚动环形使用，普通坐标绘制会被卷走，直接拒绝。 */
+  if (mode_ == platform::DisplayMode::kConsole) {
+    return -EBUSY;
+  }
+
+  return 0;
+}
+
 /**
  * @brief 全屏填充单色。
  * @param color_rgb565 RGB565 颜色值。
  * @return 0 成功；负值失败。
  */
 int ZephyrDisplay::clear(uint16_t color_rgb565) noexcept {
-  int ret = init();
+  const OpTimer timer(platform::DisplayOp::kClear);
+  int ret = prepare_draw();
   if (ret < 0) {
     return ret;
   }
 
-  return write_solid_rect(0U, 0U, caps_.x_resolution, caps_.y_resolution, color_rgb565);
+  if (mode_ == platform::DisplayMode::kRetained) {
+    /* 全屏填充会覆盖此前记录的全部命令，直接丢弃后再记录。 */
+    list_.reset();
+  }
+
+#if defined(CONFIG_SKY_BOARD_DISPLAY_PALETTE_FB)
+  if (mode_ == platform::DisplayMode::kPaletteFramebuffer) {
+    /* 整屏即将被覆盖，借此回收调色板：新一帧从单一背景色重新分配。 */
+    fb_.reset_palette(color_rgb565);
+  }
+#endif
+
+  return fill_rect(0U, 0U, caps_.x_resolution, caps_.y_resolution, color_rgb565);
 }
 
 /**
@@ -282,7 +733,8 @@ int ZephyrDisplay::clear(uint16_t color_rgb565) noexcept {
  */
 int ZephyrDisplay::fill_rect(uint16_t x, uint16_t y, uint16_t w, uint16_t h,
                              uint16_t color_rgb565) noexcept {
-  int ret = init();
+  const OpTimer timer(platform::DisplayOp::kFillRect);
+  int ret = prepare_draw();
   if (ret < 0) {
     return ret;
   }
@@ -304,9 +756,141 @@ int ZephyrDisplay::fill_rect(uint16_t x, uint16_t y, uint16_t w, uint16_t h,
     h = max_h;
   }
 
+  if (mode_ == platform::DisplayMode::kRetained) {
+    const platform::raster::Rect bounds{x, y, w, h};
+    ret = list_.add_fill(bounds, color_rgb565);
+    if (ret == -ENOMEM) {
+      /* 显示列表已满：先下发已记录内容再重新记录。 */
+      ret = flush();
+      if (ret < 0) {
+        return ret;
+      }
+      ret = list_.add_fill(bounds, color_rgb565);
+    }
+    return ret;
+  }
+
+#if defined(CONFIG_SKY_BOARD_DISPLAY_PALETTE_FB)
+  if (mode_ == platform::DisplayMode::kPaletteFramebuffer) {
+    fb_.fill({x, y, w, h}, fb_.color_index(color_rgb565));
+    return 0;
+  }
+#endif
+
   return write_solid_rect(x, y, w, h, color_rgb565);
 }
 
+/**
+ * @brief 图元绘制的公共前置处理。
+ * @param color_rgb565 图元颜色。
+ * @param[out] target 输出目标。
+ * @return 0 可以绘制；负值失败。
+ * @note 图元由大量小矩形组成，不进入保留模式的显示列表（会迅速占满），而是先 flush 已记录的
+ *       内容再直接写入面板，保持与之前绘制的先后顺序；调色板帧缓冲模式下写入帧缓冲。
+ */
+int ZephyrDisplay::begin_shape(uint16_t color_rgb565, ShapeTarget& target) noexcept {
+  int ret = prepare_draw();
+  if (ret < 0) {
+    return ret;
+  }
+
+  target.display = this;
+  target.color_rgb565 = color_rgb565;
+#if defined(CONFIG_SKY_BOARD_DISPLAY_PALETTE_FB)
+  if (mode_ == platform::DisplayMode::kPaletteFramebuffer) {
+    target.color_index = fb_.color_index(color_rgb565);
+    return 0;
+  }
+#endif
+
+  return flush();
+}
+
+/**
+ * @brief 图元光栅化的矩形输出。
+ * @param rect 已裁剪的矩形。
+ * @param user ShapeTarget 指针。
+ * @return 0 成功；负值失败。
+ * @note 每个矩形在立即/保留模式下只产生一次 display_write（超过条带缓冲时按条带拆分）。
+ */
+int ZephyrDisplay::shape_sink(const platform::raster::Rect& rect, void* user) {
+  const ShapeTarget& target = *static_cast<const ShapeTarget*>(user);
+#if defined(CONFIG_SKY_BOARD_DISPLAY_PALETTE_FB)
+  if (target.display->mode_ == platform::DisplayMode::kPaletteFramebuffer) {
+    target.display->fb_.fill(rect, target.color_index);
+    return 0;
+  }
+#endif
+  return target.display->write_solid_rect(rect.x, rect.y, rect.w, rect.h, target.color_rgb565);
+}
+
+/**
+ * @brief 绘制 1 像素宽直线。
+ * @param x0 起点 X。
+ * @param y0 起点 Y。
+ * @param x1 终点 X。
+ * @param y1 终点 Y。
+ * @param color_rgb565 RGB565 颜色值。
+ * @return 0 成功；负值失败。
+ */
+int ZephyrDisplay::draw_line(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                             uint16_t color_rgb565) noexcept {
+  const OpTimer timer(platform::DisplayOp::kDrawShape);
+  ShapeTarget target{};
+  const int ret = begin_shape(color_rgb565, target);
+  if (ret < 0) {
+    return ret;
+  }
+
+  return platform::raster::rasterize_line(x0, y0, x1, y1, screen_rect(), shape_sink, &target);
+}
+
+/**
+ * @brief 绘制圆或实心圆。
+ * @param cx 圆心 X。
+ * @param cy 圆心 Y。
+ * @param r 半径。
+ * @param color_rgb565 RGB565 颜色值。
+ * @param filled true 为实心。
+ * @return 0 成功；负值失败。
+ */
+int ZephyrDisplay::draw_circle(int16_t cx, int16_t cy, uint16_t r, uint16_t color_rgb565,
+                               bool filled) noexcept {
+  const OpTimer timer(platform::DisplayOp::kDrawShape);
+  ShapeTarget target{};
+  const int ret = begin_shape(color_rgb565, target);
+  if (ret < 0) {
+    return ret;
+  }
+
+  return platform::raster::rasterize_circle(cx, cy, r, filled, screen_rect(), shape_sink,
+                                            &target);
+}
+
+/**
+ * @brief 绘制圆角矩形或实心圆角矩形。
+ * @param x 左上角 X。
+ * @param y 左上角 Y。
+ * @param w 宽度。
+ * @param h 高度。
+ * @param r 圆角半径。
+ * @param color_rgb565 RGB565 颜色值。
+ * @param filled true 为实心。
+ * @return 0 成功；负值失败。
+ */
+int ZephyrDisplay::draw_round_rect(int16_t x, int16_t y, uint16_t w, uint16_t h, uint16_t r,
+                                   uint16_t color_rgb565, bool filled) noexcept {
+  const OpTimer timer(platform::DisplayOp::kDrawShape);
+  ShapeTarget target{};
+  const int ret = begin_shape(color_rgb565, target);
+  if (ret < 0) {
+    return ret;
+  }
+
+  return platform::raster::rasterize_round_rect(x, y, w, h, r, filled, screen_rect(), shape_sink,
+                                                &target);
+}
+
 /**
  * @brief 绘制单个 5x7 字符（可缩放）。
  * @param x 左上角 X。
@@ -319,7 +903,8 @@ int ZephyrDisplay::fill_rect(uint16_t x, uint16_t y, uint16_t w, uint16_t h,
  */
 int ZephyrDisplay::draw_char(uint16_t x, uint16_t y, char c, uint16_t fg_rgb565, uint16_t bg_rgb565,
                              uint8_t scale) noexcept {
-  int ret = init();
+  const OpTimer timer(platform::DisplayOp::kDrawText);
+  int ret = prepare_draw();
   if (ret < 0) {
     return ret;
   }
@@ -332,49 +917,133 @@ int ZephyrDisplay::draw_char(uint16_t x, uint16_t y, char c, uint16_t fg_rgb565,
     return 0;
   }
 
-  const uint8_t* glyph = platform::font5x7::glyph(c);
+  return render_text_line(x, y, &c, 1U, fg_rgb565, bg_rgb565, scale);
+}
 
-  for (uint8_t col = 0U; col < platform::font5x7::kWidth; ++col) {
-    const uint8_t line = glyph[col];
-    for (uint8_t row = 0U; row < platform::font5x7::kHeight; ++row) {
-      const uint32_t px = static_cast<uint32_t>(x) + static_cast<uint32_t>(col) * scale;
-      const uint32_t py = static_cast<uint32_t>(y) + static_cast<uint32_t>(row) * scale;
-      if (px >= caps_.x_resolution || py >= caps_.y_resolution) {
-        continue;
-      }
+/**
+ * @brief 单行文本条带渲染：整行字形按行展开，每个条带一次 display_write。
+ * @param x 起始 X。
+ * @param y 起始 Y。
+ * @param text 文本指针。
+ * @param len 文本字符数。
+ * @param fg_rgb565 前景色。
+ * @param bg_rgb565 背景色。
+ * @param scale 缩放倍数（>= 1）。
+ * @return 0 成功；负值失败。
+ */
+int ZephyrDisplay::render_text_line(uint16_t x, uint16_t y, const char* text, size_t len,
+                                    uint16_t fg_rgb565, uint16_t bg_rgb565,
+                                    uint8_t scale) noexcept {
+  if (len == 0U || x >= caps_.x_resolution || y >= caps_.y_resolution) {
+    return 0;
+  }
 
-      const uint16_t color = ((line >> row) & 0x01U) != 0U ? fg_rgb565 : bg_rgb565;
-      uint16_t w = scale;
-      uint16_t h = scale;
-      if (px + w > caps_.x_resolution) {
-        w = static_cast<uint16_t>(caps_.x_resolution - px);
-      }
-      if (py + h > caps_.y_resolution) {
-        h = static_cast<uint16_t>(caps_.y_resolution - py);
-      }
+  /* 行宽 = 字符数 x 字符单元宽（含间隔列），整体裁剪到屏幕内。 */
+  const uint32_t line_w = static_cast<uint32_t>(len) * platform::raster::kCellWidth * scale;
+  const uint32_t line_h = static_cast<uint32_t>(platform::font5x7::kHeight) * scale;
+  const uint16_t w = static_cast<uint16_t>(
+      line_w < static_cast<uint32_t>(caps_.x_resolution - x) ? line_w : caps_.x_resolution - x);
+  const uint16_t h = static_cast<uint16_t>(
+      line_h < static_cast<uint32_t>(caps_.y_resolution - y) ? line_h : caps_.y_resolution - y);
+  if (w > kMaxDisplayWidth) {
+    return -ENOMEM;
+  }
 
-      ret = write_solid_rect(static_cast<uint16_t>(px), static_cast<uint16_t>(py), w, h, color);
-      if (ret < 0) {
-        return ret;
-      }
+  if (mode_ == platform::DisplayMode::kRetained) {
+    const platform::raster::Rect bounds{x, y, w, h};
+    int ret = list_.add_text(x, y, bounds, text, len, fg_rgb565, bg_rgb565, scale);
+    if (ret != -ENOMEM) {
+      return ret;
     }
+    ret = flush();
+    if (ret < 0) {
+      return ret;
+    }
+    ret = list_.add_text(x, y, bounds, text, len, fg_rgb565, bg_rgb565, scale);
+    if (ret != -ENOMEM) {
+      return ret;
+    }
+    /* 单行文本超过文本池容量：列表已清空，直接按立即模式绘制。 */
+  }
+
+#if defined(CONFIG_SKY_BOARD_DISPLAY_PALETTE_FB)
+  if (mode_ == platform::DisplayMode::kPaletteFramebuffer) {
+    const uint8_t fg_index = fb_.color_index(fg_rgb565);
+    fb_.draw_text({x, y, w, h}, text, len, fg_index, fb_.color_index(bg_rgb565), scale);
+    return 0;
   }
+#endif
 
-  /* 额外绘制 1 列字符间隔，避免字符粘连。 */
-  const uint32_t gap_x =
-      static_cast<uint32_t>(x) + static_cast<uint32_t>(platform::font5x7::kWidth) * scale;
-  if (gap_x < caps_.x_resolution) {
-    uint16_t gap_w = scale;
-    uint16_t gap_h =
-        static_cast<uint16_t>(static_cast<uint32_t>(platform::font5x7::kHeight) * scale);
-    if (gap_x + gap_w > caps_.x_resolution) {
-      gap_w = static_cast<uint16_t>(caps_.x_resolution - gap_x);
+  const uint16_t strip_rows = static_cast<uint16_t>(kStripBufferPixels / w);
+  for (uint16_t strip_y = 0U; strip_y < h; strip_y = static_cast<uint16_t>(strip_y + strip_rows)) {
+    const uint16_t strip_h =
+        static_cast<uint16_t>((h - strip_y) < strip_rows ? (h - strip_y) : strip_rows);
+
+    platform::raster::rasterize_text_block(strip_buf_, w, 0U, w, strip_y, strip_h, text, len,
+                                           fg_rgb565, bg_rgb565, scale);
+
+    const int ret = write_block(x, static_cast<uint16_t>(y + strip_y), w, strip_h, strip_buf_);
+    if (ret < 0) {
+      return ret;
     }
-    if (static_cast<uint32_t>(y) + gap_h > caps_.y_resolution) {
-      gap_h = static_cast<uint16_t>(caps_.y_resolution - y);
+  }
+
+  return 0;
+}
+
+#if defined(CONFIG_SKY_BOARD_CJK_FONT)
+/**
+ * @brief 单行 UTF-8 文本条带渲染：ASCII 使用 5x7 字模，其余字符查 Flash 字库。
+ * @param x 起始 X。
+ * @param y 起始 Y。
+ * @param text 文本指针。
+ * @param len 文本字节数。
+ * @param fg_rgb565 前景色。
+ * @param bg_rgb565 背景色。
+ * @param scale 缩放倍数（>= 1）。
+ * @return 0 成功；负值失败。
+ */
+int ZephyrDisplay::render_utf8_line(uint16_t x, uint16_t y, const char* text, size_t len,
+                                    uint16_t fg_rgb565, uint16_t bg_rgb565,
+                                    uint8_t scale) noexcept {
+  if (len == 0U || x >= caps_.x_resolution || y >= caps_.y_resolution) {
+    return 0;
+  }
+
+  const uint32_t line_w = platform::raster::utf8_line_width(text, len, scale);
+  const uint32_t line_h = platform::raster::utf8_line_height(scale);
+  const uint16_t w = static_cast<uint16_t>(
+      line_w < static_cast<uint32_t>(caps_.x_resolution - x) ? line_w : caps_.x_resolution - x);
+  const uint16_t h = static_cast<uint16_t>(
+      line_h < static_cast<uint32_t>(caps_.y_resolution - y) ? line_h : caps_.y_resolution - y);
+  if (w > kMaxDisplayWidth) {
+    return -ENOMEM;
+  }
+
+  /* 显示列表只记录 5x7 文本：先提交已记录的命令，保持绘制顺序。 */
+  if (mode_ == platform::DisplayMode::kRetained) {
+    const int ret = flush();
+    if (ret < 0) {
+      return ret;
     }
+  }
+
+  const uint16_t strip_rows = static_cast<uint16_t>(kStripBufferPixels / w);
+  for (uint16_t strip_y = 0U; strip_y < h; strip_y = static_cast<uint16_t>(strip_y + strip_rows)) {
+    const uint16_t strip_h =
+        static_cast<uint16_t>((h - strip_y) < strip_rows ? (h - strip_y) : strip_rows);
 
-    ret = write_solid_rect(static_cast<uint16_t>(gap_x), y, gap_w, gap_h, bg_rgb565);
+    platform::raster::rasterize_utf8_block(platform::raster::cjk_font(), strip_buf_, w, 0U, w,
+                                           strip_y, strip_h, text, len, fg_rgb565, bg_rgb565,
+                                           scale);
+
+#if defined(CONFIG_SKY_BOARD_DISPLAY_PALETTE_FB)
+    if (mode_ == platform::DisplayMode::kPaletteFramebuffer) {
+      fb_.blit({x, static_cast<uint16_t>(y + strip_y), w, strip_h}, strip_buf_);
+      continue;
+    }
+#endif
+    const int ret = write_block(x, static_cast<uint16_t>(y + strip_y), w, strip_h, strip_buf_);
     if (ret < 0) {
       return ret;
     }
@@ -382,6 +1051,7 @@ int ZephyrDisplay::draw_char(uint16_t x, uint16_t y, char c, uint16_t fg_rgb565,
 
   return 0;
 }
+#endif
 
 /**
  * @brief 绘制字符串（支持 '\n'）。
@@ -395,11 +1065,12 @@ int ZephyrDisplay::draw_char(uint16_t x, uint16_t y, char c, uint16_t fg_rgb565,
  */
 int ZephyrDisplay::draw_text(uint16_t x, uint16_t y, const char* text, uint16_t fg_rgb565,
                              uint16_t bg_rgb565, uint8_t scale) noexcept {
+  const OpTimer timer(platform::DisplayOp::kDrawText);
   if (text == nullptr) {
     return -EINVAL;
   }
 
-  int ret = init();
+  int ret = prepare_draw();
   if (ret < 0) {
     return ret;
   }
@@ -408,25 +1079,44 @@ int ZephyrDisplay::draw_text(uint16_t x, uint16_t y, const char* text, uint16_t
     scale = 1U;
   }
 
-  uint16_t cursor_x = x;
-  uint16_t cursor_y = y;
-  const uint16_t step_x =
-      static_cast<uint16_t>((platform::font5x7::kWidth + platform::font5x7::kSpacing) * scale);
-  const uint16_t step_y =
+  uint16_t step_y =
       static_cast<uint16_t>((platform::font5x7::kHeight + platform::font5x7::kSpacing) * scale);
-
-  for (const char* p = text; *p != '\0'; ++p) {
-    if (*p == '\n') {
-      cursor_x = x;
-      cursor_y = static_cast<uint16_t>(cursor_y + step_y);
-      continue;
+#if defined(CONFIG_SKY_BOARD_CJK_FONT)
+  /* 含多字节字符的文本整体使用 UTF-8 行高，纯 ASCII 文本保持原有排版。 */
+  const bool utf8 = platform::raster::utf8_has_multibyte(text, strlen(text));
+  if (utf8) {
+    step_y = static_cast<uint16_t>(platform::raster::utf8_line_height(scale) +
+                                   platform::font5x7::kSpacing * scale);
+  }
+#endif
+
+  /* 按 '\n' 切分为若干行，每行整体交给条带渲染器。 */
+  uint32_t cursor_y = y;
+  const char* line = text;
+  while (cursor_y < caps_.y_resolution) {
+    size_t len = 0U;
+    while (line[len] != '\0' && line[len] != '\n') {
+      ++len;
     }
 
-    ret = draw_char(cursor_x, cursor_y, *p, fg_rgb565, bg_rgb565, scale);
+#if defined(CONFIG_SKY_BOARD_CJK_FONT)
+    ret = utf8 ? render_utf8_line(x, static_cast<uint16_t>(cursor_y), line, len, fg_rgb565,
+                                  bg_rgb565, scale)
+               : render_text_line(x, static_cast<uint16_t>(cursor_y), line, len, fg_rgb565,
+                                  bg_rgb565, scale);
+#else
+    ret = render_text_line(x, static_cast<uint16_t>(cursor_y), line, len, fg_rgb565, bg_rgb565,
+                           scale);
+#endif
     if (ret < 0) {
       return ret;
     }
-    cursor_x = static_cast<uint16_t>(cursor_x + step_x);
+
+    if (line[len] == '\0') {
+      break;
+    }
+    line += len + 1U;
+    cursor_y += step_y;
   }
 
   return 0;
@@ -445,30 +1135,117 @@ int ZephyrDisplay::draw_text(uint16_t x, uint16_t y, const char* text, uint16_t
 int ZephyrDisplay::draw_int(uint16_t x, uint16_t y, int32_t value, uint16_t fg_rgb565,
                             uint16_t bg_rgb565, uint8_t scale) noexcept {
   char buf[16]{};
-  uint8_t len = 0U;
+  (void)platform::raster::format_int(value, buf, sizeof(buf));
+
+  return draw_text(x, y, buf, fg_rgb565, bg_rgb565, scale);
+}
 
-  uint32_t abs_value = 0U;
-  if (value < 0) {
-    buf[len++] = '-';
-    /* 兼容 INT32_MIN：先 +1 再取反并补 1。 */
-    abs_value = static_cast<uint32_t>(-(value + 1)) + 1U;
-  } else {
-    abs_value = static_cast<uint32_t>(value);
+/**
+ * @brief 写入预先光栅化的像素块。
+ * @param x 左上角 X。
+ * @param y 左上角 Y。
+ * @param w 宽度。
+ * @param h 高度。
+ * @param pixels 像素数据。
+ * @return 0 成功；-EINVAL 区域越界；其他负值失败。
+ * @note 保留模式下先 flush 已记录内容，保证与之前的绘制顺序一致；
+ *       调色板帧缓冲模式下像素被量化进帧缓冲。
+ */
+int ZephyrDisplay::blit(uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+                        const uint16_t* pixels) noexcept {
+  const OpTimer timer(platform::DisplayOp::kBlit);
+  if (pixels == nullptr) {
+    return -EINVAL;
   }
 
-  char digits[11]{};
-  uint8_t dlen = 0U;
-  do {
-    digits[dlen++] = static_cast<char>('0' + (abs_value % 10U));
-    abs_value /= 10U;
-  } while (abs_value != 0U && dlen < sizeof(digits));
+  int ret = prepare_draw();
+  if (ret < 0) {
+    return ret;
+  }
+
+  if (static_cast<uint32_t>(x) + w > caps_.x_resolution ||
+      static_cast<uint32_t>(y) + h > caps_.y_resolution) {
+    return -EINVAL;
+  }
 
-  while (dlen > 0U) {
-    buf[len++] = digits[--dlen];
+#if defined(CONFIG_SKY_BOARD_DISPLAY_PALETTE_FB)
+  if (mode_ == platform::DisplayMode::kPaletteFramebuffer) {
+    fb_.blit({x, y, w, h}, pixels);
+    return 0;
   }
-  buf[len] = '\0';
+#endif
 
-  return draw_text(x, y, buf, fg_rgb565, bg_rgb565, scale);
+  ret = flush();
+  if (ret < 0) {
+    return ret;
+  }
+
+  return write_block(x, y, w, h, pixels);
+}
+
+/**
+ * @brief 从外置 SPI Flash 流式解码 RLE 图像：每解码一个条带即下发一次，整幅图像不落 RAM。
+ * @param x 左上角 X。
+ * @param y 左上角 Y。
+ * @param flash_offset 图像资源偏移。
+ * @return 0 成功；-EINVAL 资源头非法或起点越界；其他负值失败。
+ * @note 超出屏幕的列在解码时跳过，超出屏幕的行不再解码；保留模式下先 flush 已记录内容，
+ *       调色板帧缓冲模式下解码结果经 blit 量化进帧缓冲。
+ */
+int ZephyrDisplay::draw_image(uint16_t x, uint16_t y, uint32_t flash_offset) noexcept {
+  const OpTimer timer(platform::DisplayOp::kDrawImage);
+  int ret = prepare_draw();
+  if (ret < 0) {
+    return ret;
+  }
+
+  if (x >= caps_.x_resolution || y >= caps_.y_resolution) {
+    return -EINVAL;
+  }
+
+  ret = image_reader_.open(platform::spi_flash_ext(), flash_offset);
+  if (ret < 0) {
+    return ret;
+  }
+
+#if defined(CONFIG_SKY_BOARD_DISPLAY_PALETTE_FB)
+  const bool to_framebuffer = mode_ == platform::DisplayMode::kPaletteFramebuffer;
+#else
+  const bool to_framebuffer = false;
+#endif
+  if (!to_framebuffer) {
+    ret = flush();
+    if (ret < 0) {
+      return ret;
+    }
+  }
+
+  const uint16_t max_w = static_cast<uint16_t>(caps_.x_resolution - x);
+  const uint16_t max_h = static_cast<uint16_t>(caps_.y_resolution - y);
+  const uint16_t w = image_reader_.width() < max_w ? image_reader_.width() : max_w;
+  const uint16_t h = image_reader_.height() < max_h ? image_reader_.height() : max_h;
+  const uint16_t strip_rows = static_cast<uint16_t>(kStripBufferPixels / w);
+  for (uint16_t row = 0U; row < h; row = static_cast<uint16_t>(row + strip_rows)) {
+    const uint16_t rows = static_cast<uint16_t>((h - row) < strip_rows ? (h - row) : strip_rows);
+    ret = image_reader_.read_rows(strip_buf_, w, 0U, w, rows);
+    if (ret < 0) {
+      return ret;
+    }
+
+    const uint16_t strip_y = static_cast<uint16_t>(y + row);
+#if defined(CONFIG_SKY_BOARD_DISPLAY_PALETTE_FB)
+    if (to_framebuffer) {
+      fb_.blit({x, strip_y, w, rows}, strip_buf_);
+      continue;
+    }
+#endif
+    ret = write_block(x, strip_y, w, rows, strip_buf_);
+    if (ret < 0) {
+      return ret;
+    }
+  }
+
+  return 0;
 }
 
 /**
@@ -476,7 +1253,7 @@ int ZephyrDisplay::draw_int(uint16_t x, uint16_t y, int32_t value, uint16_t fg_r
  * @return 0 成功；负值失败。
  */
 int ZephyrDisplay::show_boot_screen() noexcept {
-  int ret = init();
+  int ret = prepare_draw();
   if (ret < 0) {
     return ret;
   }
@@ -526,9 +1303,286 @@ int ZephyrDisplay::show_boot_screen() noexcept {
     return ret;
   }
 
+  return flush();
+}
+
+/**
+ * @brief 切换绘制模式。
+ * @param mode 目标模式。
+ * @return 0 成功；负值失败。
+ */
+int ZephyrDisplay::set_mode(platform::DisplayMode mode) noexcept {
+  if (mode == mode_) {
+    return 0;
+  }
+
+  if (mode == platform::DisplayMode::kPaletteFramebuffer) {
+#if defined(CONFIG_SKY_BOARD_DISPLAY_PALETTE_FB)
+    int ret = init();
+    if (ret < 0) {
+      return ret;
+    }
+    ret = fb_.configure(caps_.x_resolution, caps_.y_resolution);
+    if (ret < 0) {
+      return ret;
+    }
+#else
+    return -ENOTSUP;
+#endif
+  }
+
+#if !defined(CONFIG_SKY_BOARD_DISPLAY_CONSOLE)
+  if (mode == platform::DisplayMode::kConsole) {
+    return -ENOTSUP;
+  }
+#endif
+
+  if (mode_ == platform::DisplayMode::kConsole) {
+#if defined(CONFIG_SKY_BOARD_DISPLAY_CONSOLE)
+    /* 离开控制台：滚动指针归零，帧存储器恢复与屏幕坐标一一对应。 */
+    (void)k_mutex_lock(&g_console_mutex, K_FOREVER);
+    const int ret = console_scroll_to(0U);
+    if (ret == 0) {
+      mode_ = platform::DisplayMode::kImmediate;
+    }
+    (void)k_mutex_unlock(&g_console_mutex);
+    if (ret < 0) {
+      return ret;
+    }
+#endif
+  } else if (mode_ != platform::DisplayMode::kImmediate) {
+    const int ret = flush();
+    if (ret < 0) {
+      return ret;
+    }
+  }
+
+#if defined(CONFIG_SKY_BOARD_DISPLAY_CONSOLE)
+  if (mode == platform::DisplayMode::kConsole) {
+    return console_begin();
+  }
+#endif
+
+  mode_ = mode;
   return 0;
 }
 
+/**
+ * @brief 按脏矩形下发显示列表：每个脏矩形按条带合成，每条带一次 display_write。
+ * @return 0 成功；负值失败。
+ * @note 失败时仍清空显示列表，避免同一批命令反复失败。
+ */
+int ZephyrDisplay::flush() noexcept {
+#if defined(CONFIG_SKY_BOARD_DISPLAY_PALETTE_FB)
+  if (mode_ == platform::DisplayMode::kPaletteFramebuffer) {
+    return flush_framebuffer();
+  }
+#endif
+
+  if (list_.empty()) {
+    return 0;
+  }
+
+  const OpTimer timer(platform::DisplayOp::kFlush);
+  int ret = 0;
+  for (size_t i = 0U; i < list_.dirty_count() && ret == 0; ++i) {
+    const platform::raster::Rect& rect = list_.dirty_at(i);
+    const uint16_t strip_rows = static_cast<uint16_t>(kStripBufferPixels / rect.w);
+    for (uint16_t row = 0U; row < rect.h; row = static_cast<uint16_t>(row + strip_rows)) {
+      const uint16_t rows =
+          static_cast<uint16_t>((rect.h - row) < strip_rows ? (rect.h - row) : strip_rows);
+      const platform::raster::Rect region{rect.x, static_cast<uint16_t>(rect.y + row), rect.w,
+                                          rows};
+      list_.render(region, strip_buf_);
+      ret = write_block(region.x, region.y, region.w, region.h, strip_buf_);
+      if (ret < 0) {
+        break;
+      }
+    }
+  }
+
+  list_.reset();
+  return ret;
+}
+
+#if defined(CONFIG_SKY_BOARD_DISPLAY_PALETTE_FB)
+/**
+ * @brief 调色板帧缓冲下发：脏区域包围盒按条带展开为 RGB565，每条带一次 display_write。
+ * @return 0 成功；负值失败。
+ * @note 两次 flush 之间的全部绘制只存在于帧缓冲，面板上不会出现半帧内容。
+ */
+int ZephyrDisplay::flush_framebuffer() noexcept {
+  platform::raster::Rect rect{};
+  if (!fb_.take_dirty(rect)) {
+    return 0;
+  }
+
+  const OpTimer timer(platform::DisplayOp::kFlush);
+  const uint16_t strip_rows = static_cast<uint16_t>(kStripBufferPixels / rect.w);
+  for (uint16_t row = 0U; row < rect.h; row = static_cast<uint16_t>(row + strip_rows)) {
+    const uint16_t rows =
+        static_cast<uint16_t>((rect.h - row) < strip_rows ? (rect.h - row) : strip_rows);
+    const platform::raster::Rect region{rect.x, static_cast<uint16_t>(rect.y + row), rect.w, rows};
+    fb_.expand(region, strip_buf_);
+    const int ret = write_block(region.x, region.y, region.w, region.h, strip_buf_);
+    if (ret < 0) {
+      return ret;
+    }
+  }
+
+  return 0;
+}
+#endif
+
+#if defined(CONFIG_SKY_BOARD_DISPLAY_CONSOLE)
+/**
+ * @brief 进入控制台模式。
+ * @return 0 成功；负值失败。
+ */
+int ZephyrDisplay::console_begin() noexcept {
+  int ret = init();
+  if (ret < 0) {
+    return ret;
+  }
+  if (!device_is_ready(g_mipi_dbi_dev)) {
+    return -ENODEV;
+  }
+
+  (void)k_mutex_lock(&g_console_mutex, K_FOREVER);
+  /* 先切换模式，其他线程随后的普通绘制立即被拒绝，不会写进滚动区。 */
+  mode_ = platform::DisplayMode::kConsole;
+  console_rows_ = static_cast<uint16_t>(caps_.y_resolution / kConsoleLineHeight);
+  console_head_ = 0U;
+  console_full_ = false;
+
+  /* 顶部固定区为 0，滚动区取整行，余下帧存储器行作为底部固定区。 */
+  const uint16_t vsa = static_cast<uint16_t>(console_rows_ * kConsoleLineHeight);
+  const uint16_t bfa = static_cast<uint16_t>(kFrameMemoryLines - vsa);
+  const uint8_t vscrdef[6] = {0U,
+                              0U,
+                              static_cast<uint8_t>(vsa >> 8),
+                              static_cast<uint8_t>(vsa),
+                              static_cast<uint8_t>(bfa >> 8),
+                              static_cast<uint8_t>(bfa)};
+  ret = mipi_dbi_command_write(g_mipi_dbi_dev, &g_mipi_dbi_config, kCmdVscrdef, vscrdef,
+                               sizeof(vscrdef));
+  if (ret == 0) {
+    console_scroll_ = UINT16_MAX;
+    ret = console_scroll_to(0U);
+  }
+  if (ret == 0) {
+    ret = write_solid_rect(0U, 0U, caps_.x_resolution, caps_.y_resolution, kConsoleBg);
+  }
+  if (ret < 0) {
+    mode_ = platform::DisplayMode::kImmediate;
+  }
+  (void)k_mutex_unlock(&g_console_mutex);
+  return ret;
+}
+
+/**
+ * @brief 设置硬件滚动起始行。
+ * @param line 帧存储器行号。
+ * @return 0 成功；负值失败。
+ * @note 与当前值相同时不发命令；调用方持有控制台锁。
+ */
+int ZephyrDisplay::console_scroll_to(uint16_t line) noexcept {
+  if (line == console_scroll_) {
+    return 0;
+  }
+
+  const uint8_t vsp[2] = {static_cast<uint8_t>(line >> 8), static_cast<uint8_t>(line)};
+  const int ret =
+      mipi_dbi_command_write(g_mipi_dbi_dev, &g_mipi_dbi_config, kCmdVscsad, vsp, sizeof(vsp));
+  if (ret == 0) {
+    console_scroll_ = line;
+  }
+  return ret;
+}
+
+/**
+ * @brief 在控制台最新一行绘制文本并滚动。
+ * @param text 文本指针。
+ * @param len 字符数。
+ * @param fg_rgb565 文本颜色。
+ * @return 0 成功；负值失败。
+ * @note 只重绘新的一行：写入环形中最旧的一行，再把滚动起点移到它之后，
+ *       使新行出现在屏幕底部；未写满一屏前不滚动。调用方持有控制台锁。
+ */
+int ZephyrDisplay::console_put_line(const char* text, size_t len, uint16_t fg_rgb565) noexcept {
+  const uint16_t w = caps_.x_resolution;
+  const uint16_t y = static_cast<uint16_t>(console_head_ * kConsoleLineHeight);
+  const uint16_t text_w = static_cast<uint16_t>(len * platform::raster::kCellWidth);
+  const uint16_t strip_rows = static_cast<uint16_t>(kStripBufferPixels / w);
+
+  for (uint16_t row = 0U; row < kConsoleLineHeight; row = static_cast<uint16_t>(row + strip_rows)) {
+    const uint16_t rows = static_cast<uint16_t>(
+        (kConsoleLineHeight - row) < strip_rows ? (kConsoleLineHeight - row) : strip_rows);
+    platform::raster::fill_rgb565_words(strip_buf_, static_cast<size_t>(w) * rows, kConsoleBg);
+    if (row < platform::raster::kCellHeight && text_w > 0U) {
+      const uint16_t glyph_rows = static_cast<uint16_t>(
+          (platform::raster::kCellHeight - row) < rows ? (platform::raster::kCellHeight - row)
+                                                       : rows);
+      platform::raster::rasterize_text_block(strip_buf_, w, 0U, text_w, row, glyph_rows, text, len,
+                                             fg_rgb565, kConsoleBg, 1U);
+    }
+    const int ret = write_block(0U, static_cast<uint16_t>(y + row), w, rows, strip_buf_);
+    if (ret < 0) {
+      return ret;
+    }
+  }
+
+  console_head_ = static_cast<uint16_t>(console_head_ + 1U);
+  if (console_head_ == console_rows_) {
+    console_head_ = 0U;
+    console_full_ = true;
+  }
+
+  return console_scroll_to(
+      console_full_ ? static_cast<uint16_t>(console_head_ * kConsoleLineHeight) : 0U);
+}
+
+/**
+ * @brief 向滚动控制台追加文本。
+ * @param text 文本。
+ * @param error true 表示错误级。
+ * @return 0 成功；-ENODEV 未处于控制台模式；其他负值失败。
+ */
+int ZephyrDisplay::console_write(const char* text, bool error) noexcept {
+  if (text == nullptr) {
+    return -EINVAL;
+  }
+
+  (void)k_mutex_lock(&g_console_mutex, K_FOREVER);
+  if (mode_ != platform::DisplayMode::kConsole) {
+    (void)k_mutex_unlock(&g_console_mutex);
+    return -ENODEV;
+  }
+
+  const OpTimer timer(platform::DisplayOp::kConsole);
+  int ret = 0;
+  const size_t cols = caps_.x_resolution / platform::raster::kCellWidth;
+  const char* line = text;
+  while (ret == 0) {
+    size_t len = 0U;
+    while (len < cols && line[len] != '\0' && line[len] != '\n') {
+      ++len;
+    }
+
+    ret = console_put_line(line, len, error ? kConsoleErrorFg : kConsoleInfoFg);
+    line += len;
+    if (*line == '\n') {
+      ++line;
+    }
+    if (*line == '\0') {
+      break;
+    }
+  }
+  (void)k_mutex_unlock(&g_console_mutex);
+  return ret;
+}
+#endif
+
 /**
  * @brief 获取显示关联的背光控制接口。
  * @return IBacklight 引用。
@@ -544,4 +1598,87 @@ namespace platform {
  */
 IDisplay& display() { return g_display; }
 
+/**
+ * @brief 向显示控制台追加日志文本。
+ * @param text 文本。
+ * @param error true 表示错误级。
+ * @return 0 成功；-ENODEV 未处于控制台模式；-ENOTSUP 未启用控制台。
+ */
+int display_console_write(const char* text, bool error) noexcept {
+#if defined(CONFIG_SKY_BOARD_DISPLAY_CONSOLE)
+  return g_display.console_write(text, error);
+#else
+  (void)text;
+  (void)error;
+  return -ENOTSUP;
+#endif
+}
+
+/**
+ * @brief 读取显示统计快照。
+ * @param[out] out 统计快照。
+ * @param reset true 表示读取后清零。
+ * @return 0 成功；-ENOTSUP 未启用统计。
+ */
+int display_stats(DisplayStats& out, bool reset) noexcept {
+#if defined(CONFIG_SKY_BOARD_DISPLAY_STATS)
+  (void)k_mutex_lock(&g_display_stats_mutex, K_FOREVER);
+  out = g_display_stats;
+  if (reset) {
+    g_display_stats = {};
+  }
+  (void)k_mutex_unlock(&g_display_stats_mutex);
+  return 0;
+#else
+  (void)out;
+  (void)reset;
+  return -ENOTSUP;
+#endif
+}
+
+/**
+ * @brief 通过日志输出显示统计。
+ * @param log 日志接口。
+ * @param reset true 表示输出后清零。
+ * @return 0 成功；-ENOTSUP 未启用统计。
+ * @note 先取快照再输出，日志落到显示控制台时不会与统计互锁。
+ */
+int display_stats_log(ILogger& log, bool reset) noexcept {
+#if defined(CONFIG_SKY_BOARD_DISPLAY_STATS)
+  DisplayStats stats{};
+  (void)display_stats(stats, reset);
+  log.infof("[disp] writes=%lu px=%lu bytes=%lu bus=%lu us",
+            static_cast<unsigned long>(stats.write_calls),
+            static_cast<unsigned long>(stats.write_pixels),
+            static_cast<unsigned long>(stats.write_bytes),
+            static_cast<unsigned long>(stats.write_us));
+  for (size_t i = 0U; i < static_cast<size_t>(DisplayOp::kCount); ++i) {
+    const DisplayOpStats& op = stats.ops[i];
+    if (op.calls == 0U) {
+      continue;
+    }
+    /* 直方图按桶输出为 "a/b/c/..."，每桶上界见 kDisplayStatsFirstBucketUs。 */
+    char hist[kDisplayStatsBuckets * 11U] = {};
+    size_t pos = 0U;
+    for (size_t b = 0U; b < kDisplayStatsBuckets && pos < sizeof(hist); ++b) {
+      const int n = snprintf(&hist[pos], sizeof(hist) - pos, b == 0U ? "%lu" : "/%lu",
+                             static_cast<unsigned long>(op.histogram[b]));
+      if (n < 0) {
+        break;
+      }
+      pos += static_cast<size_t>(n);
+    }
+    log.infof("[disp] %s n=%lu avg=%lu max=%lu us hist=%s", kDisplayOpNames[i],
+              static_cast<unsigned long>(op.calls),
+              static_cast<unsigned long>(op.total_us / op.calls),
+              static_cast<unsigned long>(op.max_us), hist);
+  }
+  return 0;
+#else
+  (void)log;
+  (void)reset;
+  return -ENOTSUP;
+#endif
+}
+
 }  // namespace platform
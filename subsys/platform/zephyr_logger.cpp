@@ -11,6 +11,7 @@
 #include <zephyr/logging/log.h>
 #include <zephyr/logging/log_ctrl.h>
 
+#include "platform/platform_display.hpp"
 #include "platform/platform_logger.hpp"
 #include "platform/platform_rtc.hpp"
 
@@ -21,6 +22,21 @@ namespace {
 /** @brief 格式化日志临时缓冲区长度. */
 constexpr size_t kLogFormatBufferSize = 192U;
 
+/**
+ * @brief 把日志行转发到显示控制台.
+ * @param msg 日志文本.
+ * @param error true 表示错误级.
+ * @note 显示未处于控制台模式时写入直接返回 -ENODEV, 这里忽略.
+ */
+void console_tee(const char* msg, bool error) {
+#if defined(CONFIG_SKY_BOARD_DISPLAY_CONSOLE)
+  (void)platform::display_console_write(msg, error);
+#else
+  (void)msg;
+  (void)error;
+#endif
+}
+
 /**
  * @brief 基于 Zephyr LOG 宏的日志实现。
  */
@@ -30,14 +46,24 @@ class ZephyrLogger final : public platform::ILogger {
    * @brief 输出信息级日志。
    * @param msg 日志消息字符串。
    */
-  void info(const char* msg) override { LOG_INF("%s", msg); }
+  void info(const char* msg) override {
+    LOG_INF("%s", msg);
+    console_tee(msg, false);
+  }
 
   /**
    * @brief 输出错误级日志。
    * @param msg 错误消息字符串。
    * @param err 错误码。
    */
-  void error(const char* msg, int err) override { LOG_ERR("%s err=%d", msg, err); }
+  void error(const char* msg, int err) override {
+    LOG_ERR("%s err=%d", msg, err);
+#if defined(CONFIG_SKY_BOARD_DISPLAY_CONSOLE)
+    char line[kLogFormatBufferSize] = {};
+    (void)snprintf(line, sizeof(line), "%s err=%d", msg, err);
+    console_tee(line, true);
+#endif
+  }
 
   /**
    * @brief 输出 va_list 形式的信息级日志.
@@ -61,6 +87,7 @@ class ZephyrLogger final : public platform::ILogger {
       return;
     }
     LOG_INF("%s", msg);
+    console_tee(msg, false);
   }
 
   /**
@@ -85,6 +112,7 @@ class ZephyrLogger final : public platform::ILogger {
       return;
     }
     LOG_ERR("%s", msg);
+    console_tee(msg, true);
   }
 };
 
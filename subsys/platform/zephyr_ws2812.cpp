@@ -1,21 +1,27 @@
 /**
  * @file zephyr_ws2812.cpp
- * @brief 基于 STM32 TIM5 CH4 + DMA 的 WS2812 平台驱动实现.
+ * @brief 基于 STM32 定时器 PWM 通道 + DMA 的 WS2812 平台驱动实现, 每个设备树节点一个实例.
  */
 
 #include <errno.h>
 #include <stm32f4xx_hal.h>
 #include <string.h>
+#include <zephyr/device.h>
 #include <zephyr/devicetree.h>
+#include <zephyr/drivers/clock_control/stm32_clock_control.h>
+#include <zephyr/drivers/dma.h>
+#include <zephyr/drivers/dma/dma_stm32.h>
+#include <zephyr/drivers/pwm.h>
 #include <zephyr/kernel.h>
 
 #include <cstdint>
 
 #include "platform/platform_ws2812.hpp"
+#include "platform/ws2812_dither.hpp"
 
 namespace {
 
-#define WS2812_NODE DT_ALIAS(ws2812_0)
+#define DT_DRV_COMPAT lckfb_ws2812_tim5_dma
 
 enum class ColorOrder : uint8_t {
   kGrb = 0,
@@ -23,88 +29,268 @@ enum class ColorOrder : uint8_t {
   kBrg = 2,
 };
 
-constexpr uint32_t kDefaultResetUs = 80U;
-
-/* WS2812 位时序: 周期 1.25us, 0 码高电平约 0.4us, 1 码高电平约 0.8us. */
-constexpr uint32_t kWs2812SymbolHz = 800000U;
+/* WS2812 位时序: 周期由 pwms 的周期给出 (1.25us), 0 码高电平约 0.4us, 1 码高电平约 0.8us. */
 constexpr uint32_t kDuty0Permille = 320U;
 constexpr uint32_t kDuty1Permille = 640U;
 
-/* STM32F407 固定映射: TIM5 CH4 -> PA3, DMA1 Stream1 Channel6. */
-constexpr uint16_t kDataPin = GPIO_PIN_3;
-constexpr uint32_t kTimerChannel = TIM_CHANNEL_4;
+/*
+ * 定时器与引脚复用由 pwms 引用的 PWM 节点提供 (Zephyr PWM 驱动在启动时打开定时器时钟
+ * 并应用 pinctrl), DMA stream 与请求号由 dmas 给出. DMA 控制器由 Zephyr DMA 驱动接管,
+ * 其中断服务统一处理所有 stream, 因此经 Zephyr DMA API 配置 stream.
+ */
 constexpr uint32_t kDmaTimeoutMs = 50U;
 constexpr uint32_t kDmaRecoverWaitUs = 1000U;
 constexpr size_t kBitsPerPixel = 24U;
 
-#if DT_NODE_HAS_STATUS(WS2812_NODE, okay)
-constexpr size_t kChainLength = DT_PROP(WS2812_NODE, chain_length);
-constexpr uint32_t kResetUs = DT_PROP_OR(WS2812_NODE, reset_us, kDefaultResetUs);
-constexpr int32_t kPixelOffset = DT_PROP_OR(WS2812_NODE, pixel_offset, 0);
-constexpr char kColorOrderString[] = DT_PROP(WS2812_NODE, color_order);
-constexpr size_t kPixelStorage = (kChainLength == 0U) ? 1U : kChainLength;
+/*
+ * 复位低电平不再以 0 符号存放在脉冲缓冲区中: 帧前的低电平由上一帧结束后的等待保证,
+ * 帧后的低电平由停机后的复位锁存计时产生. 帧尾只保留 2 个 0 符号: CCR 开启了
+ * 预装载, DMA 搬运第二个 0 符号 (触发 TC) 时最后一个数据位已完整输出, 此时停机不会截断.
+ */
+constexpr size_t kTailSymbolCount = 2U;
+
+#if defined(CONFIG_SKY_BOARD_WS2812_STREAMING)
+/*
+ * 流式编码: 脉冲缓冲区是一个两半的环形缓冲区, DMA 以循环模式反复搬运,
+ * 半传输/传输完成中断把刚搬运完的那一半重新编码为后续像素. 内存与灯带长度无关.
+ * 数据编码完毕后以 0 符号填充, DMA 搬运完一整半的 0 符号时停机.
+ */
+constexpr bool kStreaming = true;
+constexpr size_t kStreamHalfPixels = CONFIG_SKY_BOARD_WS2812_STREAM_PIXELS;
+constexpr size_t kStreamHalfSymbols = kStreamHalfPixels * kBitsPerPixel;
+/* 流式发送期间该帧像素仍在被读取, 需要另一份帧缓冲接收下一帧. */
+constexpr size_t kFrameBufferCount = 2U;
+#else
+constexpr bool kStreaming = false;
+constexpr size_t kStreamHalfPixels = 0U;
+constexpr size_t kStreamHalfSymbols = 0U;
+constexpr size_t kFrameBufferCount = 1U;
+#endif
+
+/* 内容未变化的帧不再发送; 保活周期内没有任何发送时重发最后一帧, 0 表示不保活. */
+#if defined(CONFIG_SKY_BOARD_WS2812_REFRESH_MS)
+constexpr uint32_t kRefreshMs = CONFIG_SKY_BOARD_WS2812_REFRESH_MS;
 #else
-constexpr size_t kChainLength = 0U;
-constexpr uint32_t kResetUs = kDefaultResetUs;
-constexpr int32_t kPixelOffset = 0;
-constexpr char kColorOrderString[] = "grb";
-constexpr size_t kPixelStorage = 1U;
+constexpr uint32_t kRefreshMs = 0U;
 #endif
 
-constexpr size_t kResetSymbolCount = ((kResetUs * 100U) / 125U) + 1U;
-constexpr size_t kDataSymbolCount = ((kChainLength == 0U) ? 1U : (kChainLength * kBitsPerPixel));
-constexpr size_t kPulseBufferSize = kResetSymbolCount + kDataSymbolCount + kResetSymbolCount;
-static_assert(kPulseBufferSize > 0U, "WS2812 pulse buffer size must be non-zero");
+/**
+ * @brief 计算脉冲缓冲区的符号个数.
+ * @param chain_length 灯珠数量.
+ * @return 整帧模式为全部数据符号加帧尾, 流式模式为环形缓冲区大小.
+ */
+constexpr size_t pulse_buffer_size(const size_t chain_length) {
+  return kStreaming ? (2U * kStreamHalfSymbols)
+                    : ((chain_length * kBitsPerPixel) + kTailSymbolCount);
+}
+
+/**
+ * @brief 计算同步 show() 的等待上限.
+ * @param chain_length 灯珠数量.
+ * @param reset_us 复位锁存时间.
+ * @return 当前帧与排队帧两帧的线上时间加 DMA 超时余量, 单位毫秒.
+ */
+constexpr int32_t show_timeout_ms(const size_t chain_length, const uint32_t reset_us) {
+  const size_t wire_symbols =
+      kStreaming ? ((chain_length * kBitsPerPixel) + pulse_buffer_size(chain_length))
+                 : pulse_buffer_size(chain_length);
+  const uint32_t frame_us = static_cast<uint32_t>((wire_symbols * 125U) / 100U) + reset_us;
+  return static_cast<int32_t>(kDmaTimeoutMs + (2U * frame_us) / 1000U);
+}
+
+/**
+ * @brief 编译期字符串比较.
+ * @param a 字符串 a.
+ * @param b 字符串 b.
+ * @return 两者相等返回 true.
+ */
+constexpr bool str_equal(const char* a, const char* b) {
+  while (*a != '\0' && *a == *b) {
+    ++a;
+    ++b;
+  }
+  return *a == *b;
+}
 
 /**
- * @brief 解析设备树中的颜色顺序字符串.
- * @return 颜色顺序枚举.
+ * @brief 在编译期解析设备树中的颜色顺序字符串.
+ * @param order 颜色顺序字符串.
+ * @return 颜色顺序枚举, 无法识别时按 grb 处理.
  */
-ColorOrder parse_color_order() noexcept {
-  if (strcmp(kColorOrderString, "rgb") == 0) {
+constexpr ColorOrder parse_color_order(const char* order) {
+  if (str_equal(order, "rgb")) {
     return ColorOrder::kRgb;
   }
-  if (strcmp(kColorOrderString, "brg") == 0) {
+  if (str_equal(order, "brg")) {
     return ColorOrder::kBrg;
   }
   return ColorOrder::kGrb;
 }
 
 /**
- * @brief 计算 TIM5 实际输入时钟频率.
- * @return TIM5 时钟频率, 单位 Hz.
+ * @brief 线上字节顺序, 元素为 Ws2812Rgb 中 {r, g, b} 的下标.
  */
-uint32_t timer5_clock_hz() noexcept {
-  const uint32_t pclk1 = HAL_RCC_GetPCLK1Freq();
-  if ((RCC->CFGR & RCC_CFGR_PPRE1) == RCC_HCLK_DIV1) {
-    return pclk1;
+struct WireOrder {
+  size_t channel[3];
+};
+
+/**
+ * @brief 按颜色顺序生成线上字节顺序.
+ * @param order 颜色顺序.
+ * @return 线上字节顺序.
+ */
+constexpr WireOrder make_wire_order(const ColorOrder order) {
+  switch (order) {
+    case ColorOrder::kRgb:
+      return {{0U, 1U, 2U}};
+    case ColorOrder::kBrg:
+      return {{2U, 0U, 1U}};
+    case ColorOrder::kGrb:
+    default:
+      return {{1U, 0U, 2U}};
   }
-  return pclk1 * 2U;
 }
 
 /**
- * @brief 将逻辑像素索引映射到物理索引.
- * @param logical_index 逻辑索引.
- * @return 物理索引.
- * @note 支持设备树中 pixel-offset 的正负偏移.
+ * @brief 把设备树中可正可负的 pixel-offset 归一化到 [0, chain_length).
+ * @param offset 像素偏移.
+ * @param chain_length 灯珠数量 (非 0).
+ * @return 归一化后的偏移.
  */
-size_t map_logical_to_physical(const size_t logical_index) noexcept {
-  if (kChainLength == 0U) {
-    return 0U;
+constexpr size_t normalize_offset(const int32_t offset, const size_t chain_length) {
+  const int32_t n = static_cast<int32_t>(chain_length);
+  const int32_t normalized = offset % n;
+  return static_cast<size_t>((normalized < 0) ? (normalized + n) : normalized);
+}
+
+/**
+ * @brief 通道值校正表.
+ */
+struct GammaTable {
+  /** @brief 各输入值对应的输出值. */
+  uint8_t level[256];
+};
+
+/**
+ * @brief 在编译期生成通道值校正表.
+ * @return 校正表; 关闭 CONFIG_SKY_BOARD_WS2812_GAMMA 时为恒等映射.
+ * @note 按 CIE 1931 明度公式把感知亮度换算为 PWM 占空比, 与背光亮度曲线一致.
+ */
+constexpr GammaTable make_gamma_table() {
+  GammaTable table{};
+  for (size_t i = 0U; i < 256U; ++i) {
+#if defined(CONFIG_SKY_BOARD_WS2812_GAMMA)
+    const double l = static_cast<double>(i) * 100.0 / 255.0;
+    const double t = (l + 16.0) / 116.0;
+    const double y = (l <= 8.0) ? (l / 903.3) : (t * t * t);
+    table.level[i] = static_cast<uint8_t>(y * 255.0 + 0.5);
+#else
+    table.level[i] = static_cast<uint8_t>(i);
+#endif
   }
+  return table;
+}
+
+/** @brief 通道值校正表 (256 字节, 常量区, 各实例共用). */
+constexpr GammaTable kGamma = make_gamma_table();
+
+/**
+ * @brief 单个实例的硬件资源与存储, 由设备树节点在编译期生成.
+ */
+struct Ws2812Config {
+  /** @brief 设备树依赖序号, 用于匹配 ws2812-0 别名. */
+  uint32_t dep_ord;
+  /** @brief 定时器寄存器基地址. */
+  uintptr_t timer_base;
+  /** @brief 定时器挂在 APB2 上 (否则为 APB1). */
+  bool timer_on_apb2;
+  /** @brief 定时器通道, 1..4. */
+  uint32_t channel;
+  /** @brief 单个位的周期, 单位纳秒. */
+  uint32_t period_ns;
+  /** @brief 输出反相 (经反相电平转换器驱动灯带时使用). */
+  bool inverted;
+  /** @brief DMA 控制器, 为空表示没有可用的硬件. */
+  const struct device* dma_dev;
+  /** @brief DMA stream. */
+  uint32_t dma_stream;
+  /** @brief DMA 请求通道 (slot). */
+  uint32_t dma_slot;
+  /** @brief DMA 优先级. */
+  uint32_t dma_priority;
+  /** @brief 灯珠数量. */
+  size_t chain_length;
+  /** @brief 复位锁存时间, 单位微秒. */
+  uint32_t reset_us;
+  /** @brief 逻辑到物理的像素偏移, 已归一化. */
+  size_t pixel_offset;
+  /** @brief 线上字节顺序. */
+  WireOrder wire_order;
+  /** @brief 应用侧像素缓冲, chain_length 个. */
+  platform::Ws2812Rgb* pixels;
+  /** @brief 帧缓冲, kFrameBufferCount * chain_length 个. */
+  platform::Ws2812Rgb* frame_pixels;
+  /** @brief 时间抖动残差, 3 * chain_length 字节; 未启用抖动时为空. */
+  uint8_t* dither_residuals;
+  /** @brief DMA 脉冲缓冲区. */
+  uint32_t* pulse_buffer;
+  /** @brief 脉冲缓冲区符号个数. */
+  size_t pulse_buffer_size;
+};
+
+class ZephyrWs2812;
 
-  const int32_t n = static_cast<int32_t>(kChainLength);
-  int32_t normalized_offset = kPixelOffset % n;
-  if (normalized_offset < 0) {
-    normalized_offset += n;
+/**
+ * @brief 帧启动工作项及其所属实例 (标准布局, 供回调经 CONTAINER_OF 找回实例).
+ */
+struct StartWork {
+  struct k_work work;
+  ZephyrWs2812* owner;
+};
+
+void on_dma_done(const struct device* dev, void* user_data, uint32_t channel, int status);
+void on_latch_expired(struct k_timer* timer);
+void on_start_work(struct k_work* work);
+void on_refresh_expired(struct k_timer* timer);
+
+/**
+ * @brief 计算定时器实际输入时钟频率.
+ * @param apb2 定时器挂在 APB2 上.
+ * @return 定时器时钟频率, 单位 Hz.
+ * @note APB 分频不为 1 时定时器时钟为 PCLK 的两倍.
+ */
+uint32_t timer_clock_hz(const bool apb2) noexcept {
+  if (apb2) {
+    const uint32_t pclk2 = HAL_RCC_GetPCLK2Freq();
+    return ((RCC->CFGR & RCC_CFGR_PPRE2) == (RCC_HCLK_DIV1 << 3)) ? pclk2 : (pclk2 * 2U);
   }
+  const uint32_t pclk1 = HAL_RCC_GetPCLK1Freq();
+  return ((RCC->CFGR & RCC_CFGR_PPRE1) == RCC_HCLK_DIV1) ? pclk1 : (pclk1 * 2U);
+}
 
-  const size_t offset = static_cast<size_t>(normalized_offset);
-  return (logical_index + offset) % kChainLength;
+/**
+ * @brief 比较两个颜色是否相同.
+ * @param a 颜色 a.
+ * @param b 颜色 b.
+ * @return 三个通道都相等返回 true.
+ */
+bool same_color(const platform::Ws2812Rgb& a, const platform::Ws2812Rgb& b) noexcept {
+  return a.r == b.r && a.g == b.g && a.b == b.b;
 }
 
 class ZephyrWs2812 final : public platform::IWs2812 {
  public:
+  /**
+   * @brief 绑定实例的硬件资源与存储.
+   * @param cfg 实例配置, 须在实例生命周期内有效.
+   * @note 只记录配置, 内核对象与外设在 init 中初始化.
+   */
+  explicit ZephyrWs2812(const Ws2812Config& cfg) noexcept : cfg_(cfg) {
+    for (size_t i = 0U; i < kFrameBufferCount; ++i) {
+      frames_[i].pixels = &cfg.frame_pixels[i * cfg.chain_length];
+    }
+  }
+
   /**
    * @brief 初始化驱动资源.
    * @return 0 表示成功, 负值表示失败.
@@ -114,7 +300,7 @@ class ZephyrWs2812 final : public platform::IWs2812 {
    * @brief 获取灯珠数量.
    * @return 灯珠数量.
    */
-  size_t size() const noexcept override { return kChainLength; }
+  size_t size() const noexcept override { return cfg_.chain_length; }
   /**
    * @brief 设置单个像素颜色.
    * @param index 像素索引.
@@ -129,10 +315,21 @@ class ZephyrWs2812 final : public platform::IWs2812 {
    */
   int fill(const platform::Ws2812Rgb& color) noexcept override;
   /**
-   * @brief 下发一帧数据到灯带.
+   * @brief 下发一帧数据到灯带并等待发送完成.
    * @return 0 表示成功, 负值表示失败.
    */
   int show() noexcept override;
+  /**
+   * @brief 提交一帧数据后立即返回.
+   * @return 0 表示已提交, 负值表示失败.
+   */
+  int show_async() noexcept override;
+  /**
+   * @brief 等待已提交的帧全部发送完成.
+   * @param timeout_ms 总超时毫秒 (排队帧与在途帧合计), 小于 0 表示永久等待.
+   * @return 0 表示成功, -EAGAIN 表示超时, 其他负值为发送错误.
+   */
+  int wait_idle(int32_t timeout_ms) noexcept override;
   /**
    * @brief 清屏并立即下发.
    * @return 0 表示成功, 负值表示失败.
@@ -145,49 +342,181 @@ class ZephyrWs2812 final : public platform::IWs2812 {
    */
   int set_global_brightness(uint8_t level) noexcept override;
 
+  /**
+   * @brief 获取设备树依赖序号.
+   * @return 依赖序号.
+   */
+  uint32_t dep_ord() const noexcept { return cfg_.dep_ord; }
+  /**
+   * @brief 获取同步发送的等待上限.
+   * @return 毫秒.
+   */
+  int32_t show_timeout() const noexcept {
+    return show_timeout_ms(cfg_.chain_length, cfg_.reset_us);
+  }
+  /**
+   * @brief 等待已提交的帧发送完成, 到截止时间仍未完成则放弃在途帧.
+   * @param deadline_ms 截止时间 (k_uptime_get 时间轴).
+   * @return 0 表示成功, -ETIMEDOUT 表示超时, 其他负值为发送错误.
+   */
+  int finish_show(int64_t deadline_ms) noexcept;
+
+  /**
+   * @brief 编码排队帧并启动 DMA (工作队列上下文).
+   */
+  void start_pending() noexcept;
+  /**
+   * @brief DMA 传输结束: 停止 PWM 并开始复位锁存计时 (中断上下文).
+   * @param status DMA 驱动回报的状态, 负值表示传输错误.
+   */
+  void dma_done(int status) noexcept;
+  /**
+   * @brief 复位锁存结束: 标记空闲, 有排队帧时调度下一帧 (中断上下文).
+   */
+  void latch_done() noexcept;
+  /**
+   * @brief 保活到期: 空闲时把最后一帧重新排队 (中断上下文).
+   */
+  void refresh_due() noexcept;
+
  private:
   /**
-   * @brief 初始化底层 TIM, GPIO, DMA.
+   * @brief 初始化底层 TIM, DMA 与内核对象.
    * @return 0 表示成功, 负值表示失败.
    */
   int init_impl() noexcept;
   /**
-   * @brief 启动 DMA 并等待本帧发送完成.
+   * @brief 启动 DMA 与 PWM, 不等待发送完成.
    * @param symbol_count 本次发送的符号个数.
    * @return 0 表示成功, 负值表示失败.
    */
-  int start_dma_and_wait_impl(size_t symbol_count) noexcept;
+  int start_dma_impl(size_t symbol_count) noexcept;
+  /**
+   * @brief 把下一批像素编码到环形脉冲缓冲区的一半, 像素用完后以 0 符号填充.
+   * @param half 半区编号, 0 或 1.
+   */
+  void refill_half_impl(size_t half) noexcept;
+  /**
+   * @brief 停止输出并开始复位锁存计时.
+   * @param error 本帧的错误码, 0 表示正常结束.
+   */
+  void finish_frame_impl(int error) noexcept;
   /**
    * @brief 强制停止 PWM DMA 输出.
    */
   void force_stop_impl() noexcept;
   /**
-   * @brief 应用全局亮度到单通道值.
-   * @param value 原始通道值.
-   * @return 亮度缩放后的通道值.
+   * @brief 放弃在途与排队的帧, 恢复空闲状态.
+   */
+  void abort_impl() noexcept;
+  /**
+   * @brief 判断自某个放弃代号以来是否发生过 abort_impl.
+   * @param epoch start_pending 接手帧时记录的 abort_epoch_.
+   * @return true 表示帧已被放弃, 调用方不得再启动或停止发送.
+   */
+  bool aborted_since(uint32_t epoch) noexcept;
+  /**
+   * @brief 按亮度重建通道值查找表 (启用抖动时为 8.8 目标值表), 亮度未变化时直接返回.
+   * @param brightness 全局亮度, 范围 0..255.
    */
-  uint8_t apply_brightness(uint8_t value) const noexcept;
+  void update_level_lut_impl(uint8_t brightness) noexcept;
   /**
    * @brief 将一个像素编码到脉冲缓冲区.
    * @param out_index 输出写指针.
+   * @param pixel_index 物理像素下标, 用于定位抖动残差.
    * @param color 待编码 RGB 颜色.
    */
-  void encode_pixel_impl(size_t& out_index, const platform::Ws2812Rgb& color) noexcept;
+  void encode_pixel_impl(size_t& out_index, size_t pixel_index,
+                         const platform::Ws2812Rgb& color) noexcept;
+  /**
+   * @brief 将逻辑像素索引映射到物理索引.
+   * @param logical_index 逻辑索引, 小于 chain_length.
+   * @return 物理索引.
+   */
+  size_t map_logical_to_physical(const size_t logical_index) const noexcept {
+    return (logical_index + cfg_.pixel_offset) % cfg_.chain_length;
+  }
 
+  const Ws2812Config& cfg_;
   bool initialized_ = false;
 
-  ColorOrder color_order_ = ColorOrder::kGrb;
   uint8_t brightness_ = 255U;
   uint32_t timer_period_ticks_ = 104U;
   uint32_t pulse_0_ticks_ = 34U;
   uint32_t pulse_1_ticks_ = 67U;
 
-  TIM_HandleTypeDef htim5_{};
-  DMA_HandleTypeDef hdma_tim5_ch4_{};
-  bool dma_linked_ = false;
+  /* 编码查找表: 通道值 -> 校正并缩放后的值; 4 bit -> 4 个脉冲比较值 (高位在前). */
+#if defined(CONFIG_SKY_BOARD_WS2812_DITHER)
+  platform::Ws2812Dither dither_{cfg_.dither_residuals, cfg_.chain_length};
+#else
+  bool level_lut_valid_ = false;
+  uint8_t level_lut_brightness_ = 255U;
+  uint8_t level_lut_[256] = {};
+#endif
+  uint32_t nibble_pulses_[16][4] = {};
+
+  /* HAL 通道号与 DIER 中对应的 DMA 请求位, 由 cfg_.channel 换算. */
+  TIM_HandleTypeDef htim_{};
+  uint32_t hal_channel_ = 0U;
+  uint32_t hal_dma_request_ = 0U;
+  struct dma_block_config dma_block_{};
+  struct dma_config dma_cfg_{};
+
+  /* 复位锁存定时器: 帧尾停机后计时 reset-us, 到期才允许下一帧上线. */
+  struct k_timer latch_timer_ {};
+  /* 保活定时器: 每帧锁存结束后重新计时, 到期时重发最后一帧. */
+  struct k_timer refresh_timer_ {};
+  /* 帧启动工作项: 在系统工作队列中编码排队帧并启动 DMA. */
+  StartWork start_work_{{}, this};
+  /* 帧完成信号, 供 wait_idle 等待. */
+  struct k_sem done_sem_ {};
+
+  /**
+   * @brief 提交给发送路径的一帧.
+   */
+  struct Frame {
+    uint8_t brightness = 255U;
+    platform::Ws2812Rgb* pixels = nullptr;
+  };
+
+  /* 帧状态: busy_ 为 DMA 在途或复位锁存中, pending_ 为 frames_ 中有待发送的帧. */
+  struct k_spinlock lock_ {};
+  bool busy_ = false;
+  bool pending_ = false;
+  int last_error_ = 0;
+  /*
+   * 放弃代号: abort_impl 每次递增. finish_show 超时可能发生在 start_pending 已置 busy_ 并释放
+   * lock_ 之后, start_pending 在启动 DMA 前后比对代号, 被放弃的帧不再启动或立即停机.
+   */
+  uint32_t abort_epoch_ = 0U;
 
-  platform::Ws2812Rgb pixels_[kPixelStorage] = {};
-  uint32_t pulse_buffer_[kPulseBufferSize] = {};
+  /*
+   * 变化检测: generation_ 在像素或亮度真正改变时递增 (仅应用线程访问).
+   * submitted_generation_ 为最后提交的帧对应的代号, submitted_valid_ 在该帧发送失败
+   * 或被放弃时清除, 下次 show 必然重发. resend_ 表示排队的是保活重发而不是新帧.
+   * has_frame_ 表示已有可供保活重发的帧.
+   */
+  uint32_t generation_ = 0U;
+  uint32_t submitted_generation_ = 0U;
+  bool submitted_valid_ = false;
+  bool resend_ = false;
+  bool has_frame_ = false;
+#if defined(CONFIG_SKY_BOARD_WS2812_DITHER)
+  /* 最后正常结束的帧没有小数级, 重发不会改变输出. */
+  bool dither_settled_ = false;
+#endif
+
+  /*
+   * 双缓冲: 应用始终改写 cfg_.pixels, show_async 把它复制到 frames_[queued_frame_]
+   * 后交给发送路径. 流式模式下正在发送的帧仍被中断读取, 因此轮换使用两份帧缓冲.
+   * active_frame_ 为最近一次上线的帧, 保活重发直接使用它.
+   */
+  struct k_mutex frame_lock_ {};
+  size_t queued_frame_ = 0U;
+  size_t active_frame_ = 0U;
+  size_t stream_cursor_ = 0U;
+  bool half_idle_[2] = {};
+  Frame frames_[kFrameBufferCount] = {};
 };
 
 /**
@@ -199,96 +528,122 @@ int ZephyrWs2812::init() noexcept { return init_impl(); }
 /**
  * @brief 初始化 WS2812 底层外设资源.
  * @return 0 表示成功, 负值表示失败.
+ * @note 引脚复用与定时器时钟已由 PWM 节点的驱动完成, 这里只重新配置定时器通道与 DMA.
  */
 int ZephyrWs2812::init_impl() noexcept {
   if (initialized_) {
     return 0;
   }
-
-#if !DT_NODE_HAS_STATUS(WS2812_NODE, okay)
-  return -ENODEV;
-#else
-  if (kChainLength == 0U) {
-    return -EINVAL;
+  if (cfg_.chain_length == 0U || cfg_.dma_dev == nullptr) {
+    return -ENODEV;
   }
 
-  color_order_ = parse_color_order();
-
-  __HAL_RCC_GPIOA_CLK_ENABLE();
-  __HAL_RCC_TIM5_CLK_ENABLE();
-  __HAL_RCC_DMA1_CLK_ENABLE();
-
-  GPIO_InitTypeDef gpio_init{};
-  gpio_init.Pin = kDataPin;
-  gpio_init.Mode = GPIO_MODE_AF_PP;
-  gpio_init.Pull = GPIO_NOPULL;
-  gpio_init.Speed = GPIO_SPEED_FREQ_VERY_HIGH;
-  gpio_init.Alternate = GPIO_AF2_TIM5;
-  HAL_GPIO_Init(GPIOA, &gpio_init);
-
-  const uint32_t tim_clk = timer5_clock_hz();
-  if (tim_clk < kWs2812SymbolHz) {
+  const uint32_t tim_clk = timer_clock_hz(cfg_.timer_on_apb2);
+  const uint64_t period_ticks =
+      (static_cast<uint64_t>(tim_clk) * cfg_.period_ns + 500000000ULL) / 1000000000ULL;
+  if (period_ticks < 2U) {
     return -EINVAL;
   }
-  timer_period_ticks_ = (tim_clk / kWs2812SymbolHz) - 1U;
+  timer_period_ticks_ = static_cast<uint32_t>(period_ticks) - 1U;
   pulse_0_ticks_ = ((timer_period_ticks_ + 1U) * kDuty0Permille) / 1000U;
   pulse_1_ticks_ = ((timer_period_ticks_ + 1U) * kDuty1Permille) / 1000U;
+  /* 比较值取决于运行时的定时器时钟, 展开表在此生成. */
+  for (uint32_t nibble = 0U; nibble < 16U; ++nibble) {
+    for (uint32_t bit = 0U; bit < 4U; ++bit) {
+      nibble_pulses_[nibble][bit] =
+          ((nibble & (0x8U >> bit)) != 0U) ? pulse_1_ticks_ : pulse_0_ticks_;
+    }
+  }
+
+  /* HAL 的 TIM_CHANNEL_1..4 为 0x0/0x4/0x8/0xC, TIM_DMA_CC1..4 为 DIER 中相邻的 4 位. */
+  hal_channel_ = (cfg_.channel - 1U) * 4U;
+  hal_dma_request_ = TIM_DMA_CC1 << (cfg_.channel - 1U);
+  TIM_TypeDef* const tim = reinterpret_cast<TIM_TypeDef*>(cfg_.timer_base);
 
-  htim5_ = {};
-  htim5_.Instance = TIM5;
-  htim5_.Init.Prescaler = 0U;
-  htim5_.Init.CounterMode = TIM_COUNTERMODE_UP;
-  htim5_.Init.Period = timer_period_ticks_;
-  htim5_.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
-  htim5_.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_DISABLE;
-  if (HAL_TIM_PWM_Init(&htim5_) != HAL_OK) {
+  htim_ = {};
+  htim_.Instance = tim;
+  htim_.Init.Prescaler = 0U;
+  htim_.Init.CounterMode = TIM_COUNTERMODE_UP;
+  htim_.Init.Period = timer_period_ticks_;
+  htim_.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
+  htim_.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_DISABLE;
+  if (HAL_TIM_PWM_Init(&htim_) != HAL_OK) {
     return -EIO;
   }
 
   TIM_OC_InitTypeDef oc{};
   oc.OCMode = TIM_OCMODE_PWM1;
   oc.Pulse = 0U;
-  oc.OCPolarity = TIM_OCPOLARITY_HIGH;
+  oc.OCPolarity = cfg_.inverted ? TIM_OCPOLARITY_LOW : TIM_OCPOLARITY_HIGH;
   oc.OCFastMode = TIM_OCFAST_DISABLE;
-  if (HAL_TIM_PWM_ConfigChannel(&htim5_, &oc, kTimerChannel) != HAL_OK) {
+  if (HAL_TIM_PWM_ConfigChannel(&htim_, &oc, hal_channel_) != HAL_OK) {
     return -EIO;
   }
 
-  hdma_tim5_ch4_ = {};
-  hdma_tim5_ch4_.Instance = DMA1_Stream1;
-  hdma_tim5_ch4_.Init.Channel = DMA_CHANNEL_6;
-  hdma_tim5_ch4_.Init.Direction = DMA_MEMORY_TO_PERIPH;
-  hdma_tim5_ch4_.Init.PeriphInc = DMA_PINC_DISABLE;
-  hdma_tim5_ch4_.Init.MemInc = DMA_MINC_ENABLE;
-  hdma_tim5_ch4_.Init.PeriphDataAlignment = DMA_PDATAALIGN_WORD;
-  hdma_tim5_ch4_.Init.MemDataAlignment = DMA_MDATAALIGN_WORD;
-  hdma_tim5_ch4_.Init.Mode = DMA_NORMAL;
-  hdma_tim5_ch4_.Init.Priority = DMA_PRIORITY_HIGH;
-  hdma_tim5_ch4_.Init.FIFOMode = DMA_FIFOMODE_ENABLE;
-  hdma_tim5_ch4_.Init.FIFOThreshold = DMA_FIFO_THRESHOLD_FULL;
-  hdma_tim5_ch4_.Init.MemBurst = DMA_MBURST_SINGLE;
-  hdma_tim5_ch4_.Init.PeriphBurst = DMA_PBURST_SINGLE;
-  /* 重新初始化 DMA 流, 避免上次运行后残留状态影响当前帧发送. */
-  (void)HAL_DMA_DeInit(&hdma_tim5_ch4_);
-  if (HAL_DMA_Init(&hdma_tim5_ch4_) != HAL_OK) {
-    return -EIO;
+  if (!device_is_ready(cfg_.dma_dev)) {
+    return -ENODEV;
   }
 
-  __HAL_LINKDMA(&htim5_, hdma[TIM_DMA_ID_CC4], hdma_tim5_ch4_);
-  dma_linked_ = true;
+  /*
+   * 比较值虽然只有 8 位, 但 CCRx 按 32 位寄存器访问: APB 桥会把半字/字节写入复制到
+   * 32 位总线的各个通道 (半字 v 写成 v | v << 16), FIFO 打包则会把相邻的两个半字拼成一个字,
+   * 两者都得不到正确的比较值, 因此存储端与外设端都保持字宽.
+   */
+  volatile uint32_t* const ccr = &tim->CCR1 + (cfg_.channel - 1U);
+  dma_block_ = {};
+  dma_block_.source_address =
+      static_cast<uint32_t>(reinterpret_cast<uintptr_t>(cfg_.pulse_buffer));
+  dma_block_.dest_address = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(ccr));
+  dma_block_.source_addr_adj = DMA_ADDR_ADJ_INCREMENT;
+  dma_block_.dest_addr_adj = DMA_ADDR_ADJ_NO_CHANGE;
+  /* 流式模式使用循环 DMA, Zephyr STM32 DMA 驱动随之打开半传输中断. */
+  dma_block_.source_reload_en = kStreaming ? 1U : 0U;
+
+  dma_cfg_ = {};
+  dma_cfg_.dma_slot = cfg_.dma_slot;
+  dma_cfg_.channel_direction = MEMORY_TO_PERIPHERAL;
+  dma_cfg_.channel_priority = cfg_.dma_priority;
+  dma_cfg_.source_data_size = sizeof(uint32_t);
+  dma_cfg_.dest_data_size = sizeof(uint32_t);
+  dma_cfg_.source_burst_length = 1U;
+  dma_cfg_.dest_burst_length = 1U;
+  dma_cfg_.block_count = 1U;
+  dma_cfg_.head_block = &dma_block_;
+  dma_cfg_.dma_callback = on_dma_done;
+  dma_cfg_.user_data = this;
+
+  k_timer_init(&latch_timer_, on_latch_expired, nullptr);
+  k_timer_user_data_set(&latch_timer_, this);
+  k_timer_init(&refresh_timer_, on_refresh_expired, nullptr);
+  k_timer_user_data_set(&refresh_timer_, this);
+  k_work_init(&start_work_.work, on_start_work);
+  (void)k_sem_init(&done_sem_, 0U, 1U);
+  (void)k_mutex_init(&frame_lock_);
   initialized_ = true;
   return 0;
-#endif
 }
 
 /**
- * @brief 对单通道值执行全局亮度缩放.
- * @param value 原始值, 范围 0..255.
- * @return 缩放后值.
+ * @brief 按亮度重建通道值查找表.
+ * @param brightness 全局亮度, 范围 0..255.
+ * @note 亮度不变时不重建, 每帧编码只剩查表.
  */
-uint8_t ZephyrWs2812::apply_brightness(const uint8_t value) const noexcept {
-  const uint16_t scaled = static_cast<uint16_t>(value) * static_cast<uint16_t>(brightness_);
-  return static_cast<uint8_t>((scaled + 127U) / 255U);
+void ZephyrWs2812::update_level_lut_impl(const uint8_t brightness) noexcept {
+#if defined(CONFIG_SKY_BOARD_WS2812_DITHER)
+  dither_.set_brightness(brightness);
+#else
+  if (level_lut_valid_ && level_lut_brightness_ == brightness) {
+    return;
+  }
+
+  for (size_t i = 0U; i < 256U; ++i) {
+    const uint16_t scaled =
+        static_cast<uint16_t>(kGamma.level[i]) * static_cast<uint16_t>(brightness);
+    level_lut_[i] = static_cast<uint8_t>((scaled + 127U) / 255U);
+  }
+  level_lut_brightness_ = brightness;
+  level_lut_valid_ = true;
+#endif
 }
 
 /**
@@ -298,11 +653,15 @@ uint8_t ZephyrWs2812::apply_brightness(const uint8_t value) const noexcept {
  * @return 0 表示成功, 负值表示失败.
  */
 int ZephyrWs2812::set_pixel(const size_t index, const platform::Ws2812Rgb& color) noexcept {
-  if (index >= kChainLength) {
+  if (index >= cfg_.chain_length) {
     return -EINVAL;
   }
 
-  pixels_[map_logical_to_physical(index)] = color;
+  platform::Ws2812Rgb& pixel = cfg_.pixels[map_logical_to_physical(index)];
+  if (!same_color(pixel, color)) {
+    pixel = color;
+    ++generation_;
+  }
   return 0;
 }
 
@@ -312,8 +671,15 @@ int ZephyrWs2812::set_pixel(const size_t index, const platform::Ws2812Rgb& color
  * @return 0 表示成功.
  */
 int ZephyrWs2812::fill(const platform::Ws2812Rgb& color) noexcept {
-  for (size_t i = 0U; i < kChainLength; ++i) {
-    pixels_[i] = color;
+  bool changed = false;
+  for (size_t i = 0U; i < cfg_.chain_length; ++i) {
+    if (!same_color(cfg_.pixels[i], color)) {
+      cfg_.pixels[i] = color;
+      changed = true;
+    }
+  }
+  if (changed) {
+    ++generation_;
   }
   return 0;
 }
@@ -321,119 +687,386 @@ int ZephyrWs2812::fill(const platform::Ws2812Rgb& color) noexcept {
 /**
  * @brief 按配置颜色顺序把一个像素编码为 24bit 脉冲序列.
  * @param out_index 脉冲缓冲区当前写入位置.
+ * @param pixel_index 物理像素下标.
  * @param color 待编码颜色.
+ * @note 每个通道查一次亮度表 (或抖动一步), 再按高低 4 bit 各拷贝 4 个比较值, 无逐位分支.
  */
-void ZephyrWs2812::encode_pixel_impl(size_t& out_index, const platform::Ws2812Rgb& color) noexcept {
-  const uint8_t r = apply_brightness(color.r);
-  const uint8_t g = apply_brightness(color.g);
-  const uint8_t b = apply_brightness(color.b);
-
-  uint8_t channels[3] = {};
-  switch (color_order_) {
-    case ColorOrder::kRgb:
-      channels[0] = r;
-      channels[1] = g;
-      channels[2] = b;
-      break;
-    case ColorOrder::kBrg:
-      channels[0] = b;
-      channels[1] = r;
-      channels[2] = g;
-      break;
-    case ColorOrder::kGrb:
-    default:
-      channels[0] = g;
-      channels[1] = r;
-      channels[2] = b;
-      break;
-  }
-
+void ZephyrWs2812::encode_pixel_impl(size_t& out_index, const size_t pixel_index,
+                                     const platform::Ws2812Rgb& color) noexcept {
+#if defined(CONFIG_SKY_BOARD_WS2812_DITHER)
+  const platform::Ws2812Rgb scaled = dither_.apply(pixel_index, color);
+  const uint8_t rgb[3] = {scaled.r, scaled.g, scaled.b};
+#else
+  (void)pixel_index;
+  const uint8_t rgb[3] = {level_lut_[color.r], level_lut_[color.g], level_lut_[color.b]};
+#endif
+  uint32_t* out = &cfg_.pulse_buffer[out_index];
   for (size_t ch = 0U; ch < 3U; ++ch) {
-    for (int bit = 7; bit >= 0; --bit) {
-      pulse_buffer_[out_index++] =
-          ((channels[ch] & (1U << bit)) != 0U) ? pulse_1_ticks_ : pulse_0_ticks_;
-    }
+    const uint8_t level = rgb[cfg_.wire_order.channel[ch]];
+    memcpy(out, nibble_pulses_[level >> 4], sizeof(nibble_pulses_[0]));
+    memcpy(out + 4, nibble_pulses_[level & 0x0FU], sizeof(nibble_pulses_[0]));
+    out += 8;
   }
+  out_index += kBitsPerPixel;
 }
 
 /**
- * @brief 启动 TIM5 PWM DMA 并等待整帧发送结束.
+ * @brief 配置并启动 DMA, 再开启定时器通道的 DMA 请求与 PWM 输出.
  * @param symbol_count 要发送的符号数量.
  * @return 0 表示成功, 负值表示失败.
+ * @note 完成后由 DMA 回调 on_dma_done 通知, 本函数不等待.
  */
-int ZephyrWs2812::start_dma_and_wait_impl(const size_t symbol_count) noexcept {
-  if (!dma_linked_) {
-    return -ENODEV;
-  }
+int ZephyrWs2812::start_dma_impl(const size_t symbol_count) noexcept {
   if (symbol_count == 0U) {
     return -EINVAL;
   }
 
-  HAL_StatusTypeDef st = HAL_TIM_PWM_Start_DMA(&htim5_, kTimerChannel, pulse_buffer_,
-                                               static_cast<uint16_t>(symbol_count));
-  if (st != HAL_OK) {
-    /* 遇到 HAL 忙或异常时先强制停机, 再做一次短延迟重试. */
+  dma_block_.block_size = static_cast<uint32_t>(symbol_count * sizeof(uint32_t));
+  int ret = dma_config(cfg_.dma_dev, cfg_.dma_stream, &dma_cfg_);
+  if (ret < 0) {
+    return ret;
+  }
+  ret = dma_start(cfg_.dma_dev, cfg_.dma_stream);
+  if (ret < 0) {
+    return ret;
+  }
+
+  /* 首个周期输出原比较值 0, DMA 搬运的第一个符号在下一周期生效. */
+  __HAL_TIM_SET_COMPARE(&htim_, hal_channel_, 0U);
+  __HAL_TIM_ENABLE_DMA(&htim_, hal_dma_request_);
+  if (HAL_TIM_PWM_Start(&htim_, hal_channel_) != HAL_OK) {
     force_stop_impl();
-    k_busy_wait(kDmaRecoverWaitUs);
-    st = HAL_TIM_PWM_Start_DMA(&htim5_, kTimerChannel, pulse_buffer_,
-                               static_cast<uint16_t>(symbol_count));
-    if (st != HAL_OK) {
-      return (st == HAL_BUSY) ? -EBUSY : -EIO;
+    return -EIO;
+  }
+  return 0;
+}
+
+/**
+ * @brief 强制停止 PWM DMA 并拉低输出比较值.
+ */
+void ZephyrWs2812::force_stop_impl() noexcept {
+  __HAL_TIM_DISABLE_DMA(&htim_, hal_dma_request_);
+  (void)HAL_TIM_PWM_Stop(&htim_, hal_channel_);
+  __HAL_TIM_SET_COMPARE(&htim_, hal_channel_, 0U);
+  (void)dma_stop(cfg_.dma_dev, cfg_.dma_stream);
+}
+
+/**
+ * @brief 放弃在途与排队的帧, 拉低数据线并等待复位时间.
+ */
+void ZephyrWs2812::abort_impl() noexcept {
+  k_timer_stop(&latch_timer_);
+  force_stop_impl();
+  k_busy_wait(cfg_.reset_us);
+
+  k_spinlock_key_t key = k_spin_lock(&lock_);
+  busy_ = false;
+  pending_ = false;
+  resend_ = false;
+  submitted_valid_ = false;
+  ++abort_epoch_;
+  k_spin_unlock(&lock_, key);
+}
+
+/**
+ * @brief 判断自 epoch 以来是否发生过放弃.
+ * @param epoch 接手帧时记录的放弃代号.
+ * @return true 表示帧已被放弃.
+ */
+bool ZephyrWs2812::aborted_since(const uint32_t epoch) noexcept {
+  k_spinlock_key_t key = k_spin_lock(&lock_);
+  const bool aborted = abort_epoch_ != epoch;
+  k_spin_unlock(&lock_, key);
+  return aborted;
+}
+
+/**
+ * @brief 编码排队帧并启动发送, 启动失败时强制停机后重试一次.
+ * @note 编码与启动期间 finish_show 可能超时并放弃本帧: 启动前发现已放弃则不再启动,
+ *       启动后才发现则立即停机. 状态已由 abort_impl 复位, 这里不再改动 busy_.
+ */
+void ZephyrWs2812::start_pending() noexcept {
+  k_spinlock_key_t key = k_spin_lock(&lock_);
+  if (busy_ || !pending_) {
+    k_spin_unlock(&lock_, key);
+    return;
+  }
+  busy_ = true;
+  pending_ = false;
+  const bool resend = resend_;
+  resend_ = false;
+  const uint32_t epoch = abort_epoch_;
+  k_spin_unlock(&lock_, key);
+
+  (void)k_mutex_lock(&frame_lock_, K_FOREVER);
+  /* 保活重发沿用上次发送的帧缓冲, 新帧则轮换到下一份帧缓冲. */
+  if (!resend) {
+    active_frame_ = queued_frame_;
+    queued_frame_ = (queued_frame_ + 1U) % kFrameBufferCount;
+  }
+  const Frame& frame = frames_[active_frame_];
+  update_level_lut_impl(frame.brightness);
+#if defined(CONFIG_SKY_BOARD_WS2812_DITHER)
+  dither_.begin_frame();
+#endif
+  if (kStreaming) {
+    /* 预填环形缓冲区的两半, 其余像素由 DMA 中断边发送边编码. */
+    stream_cursor_ = 0U;
+    refill_half_impl(0U);
+    refill_half_impl(1U);
+  } else {
+    /* 组帧: 像素编码数据 + 帧尾 0 符号, 复位低电平由锁存定时器产生. */
+    size_t out_idx = 0U;
+    for (size_t i = 0U; i < cfg_.chain_length; ++i) {
+      encode_pixel_impl(out_idx, i, frame.pixels[i]);
+    }
+    while (out_idx < cfg_.pulse_buffer_size) {
+      cfg_.pulse_buffer[out_idx++] = 0U;
     }
   }
+  (void)k_mutex_unlock(&frame_lock_);
 
-  st = HAL_DMA_PollForTransfer(&hdma_tim5_ch4_, HAL_DMA_FULL_TRANSFER, kDmaTimeoutMs);
-  if (st != HAL_OK) {
+  if (aborted_since(epoch)) {
+    return;
+  }
+  int ret = start_dma_impl(cfg_.pulse_buffer_size);
+  if (ret < 0 && !aborted_since(epoch)) {
+    /* 针对瞬时 busy 或 IO 异常, 强制停机后仅重试一帧. */
+    force_stop_impl();
+    k_busy_wait(kDmaRecoverWaitUs);
+    ret = start_dma_impl(cfg_.pulse_buffer_size);
+  }
+  if (aborted_since(epoch)) {
+    /* abort_impl 的停机可能早于上面的启动, 补一次停机, 不留无人跟踪的 DMA. */
     force_stop_impl();
-    return (st == HAL_TIMEOUT) ? -ETIMEDOUT : -EIO;
+    return;
   }
+  if (ret < 0) {
+    force_stop_impl();
+    key = k_spin_lock(&lock_);
+    busy_ = false;
+    last_error_ = ret;
+    submitted_valid_ = false;
+    k_spin_unlock(&lock_, key);
+    k_sem_give(&done_sem_);
+  }
+}
+
+/**
+ * @brief 编码环形脉冲缓冲区的一半.
+ * @param half 半区编号, 0 或 1.
+ * @note 在中断上下文运行, 必须在 DMA 绕回该半区之前完成, 即不超过
+ *       kStreamHalfPixels 个像素的线上时间 (每像素 30us).
+ */
+void ZephyrWs2812::refill_half_impl(const size_t half) noexcept {
+  const Frame& frame = frames_[active_frame_];
+  size_t out_idx = half * kStreamHalfSymbols;
+  const size_t end_idx = out_idx + kStreamHalfSymbols;
+  size_t encoded = 0U;
+  while (encoded < kStreamHalfPixels && stream_cursor_ < cfg_.chain_length) {
+    encode_pixel_impl(out_idx, stream_cursor_, frame.pixels[stream_cursor_]);
+    ++stream_cursor_;
+    ++encoded;
+  }
+  while (out_idx < end_idx) {
+    cfg_.pulse_buffer[out_idx++] = 0U;
+  }
+  half_idle_[half] = (encoded == 0U);
+}
 
+/**
+ * @brief 停止输出并开始复位锁存计时.
+ * @param error 本帧的错误码, 0 表示正常结束.
+ */
+void ZephyrWs2812::finish_frame_impl(const int error) noexcept {
   force_stop_impl();
-  __HAL_TIM_SET_COMPARE(&htim5_, kTimerChannel, 0U);
-  k_busy_wait(kResetUs);
-  return 0;
+  k_spinlock_key_t key = k_spin_lock(&lock_);
+  if (error < 0) {
+    last_error_ = error;
+    submitted_valid_ = false;
+  }
+#if defined(CONFIG_SKY_BOARD_WS2812_DITHER)
+  /* 到这里整帧都已编码完毕 (流式模式亦然), 本帧的小数标记已完整. */
+  dither_settled_ = (error == 0) && dither_.frame_exact();
+#endif
+  k_spin_unlock(&lock_, key);
+  k_timer_start(&latch_timer_, K_USEC(cfg_.reset_us), K_NO_WAIT);
 }
 
 /**
- * @brief 强制停止 PWM DMA 并拉低输出比较值.
+ * @brief DMA 传输结束回调处理.
+ * @param status DMA 驱动回报的状态.
+ * @note 整帧模式: 帧尾有 2 个 0 符号, 传输完成时最后一个数据位已输出完毕, 可以立即停机.
+ *       流式模式: 半传输中断对应前半区搬运完毕, 传输完成中断对应后半区搬运完毕;
+ *       搬运完的半区全为 0 符号时最后一个数据位早已输出完毕, 停机, 否则重新编码该半区.
  */
-void ZephyrWs2812::force_stop_impl() noexcept {
-  /* 停止路径统一使用 HAL_TIM_PWM_Stop_DMA, 并拉低比较值. */
-  (void)HAL_TIM_PWM_Stop_DMA(&htim5_, kTimerChannel);
-  __HAL_TIM_SET_COMPARE(&htim5_, kTimerChannel, 0U);
+void ZephyrWs2812::dma_done(const int status) noexcept {
+  if (status < 0) {
+    finish_frame_impl(-EIO);
+    return;
+  }
+
+  if (!kStreaming) {
+    if (status != DMA_STATUS_BLOCK) {
+      finish_frame_impl(0);
+    }
+    return;
+  }
+
+  const size_t half = (status == DMA_STATUS_BLOCK) ? 0U : 1U;
+  if (half_idle_[half]) {
+    finish_frame_impl(0);
+  } else {
+    refill_half_impl(half);
+  }
 }
 
 /**
- * @brief 组帧并发送当前像素缓冲.
- * @return 0 表示成功, 负值表示失败.
+ * @brief 复位锁存结束回调处理.
  */
-int ZephyrWs2812::show() noexcept {
+void ZephyrWs2812::latch_done() noexcept {
+  k_spinlock_key_t key = k_spin_lock(&lock_);
+  busy_ = false;
+  const bool pending = pending_;
+  k_spin_unlock(&lock_, key);
+
+  if (pending) {
+    (void)k_work_submit(&start_work_.work);
+  } else if (kRefreshMs > 0U) {
+    k_timer_start(&refresh_timer_, K_MSEC(kRefreshMs), K_NO_WAIT);
+  }
+  k_sem_give(&done_sem_);
+}
+
+/**
+ * @brief 保活定时器到期处理.
+ * @note 只在完全空闲时重发; 期间有新帧提交或发送时, 该帧结束后会重新计时.
+ */
+void ZephyrWs2812::refresh_due() noexcept {
+  k_spinlock_key_t key = k_spin_lock(&lock_);
+  const bool resend = has_frame_ && !busy_ && !pending_;
+  if (resend) {
+    pending_ = true;
+    resend_ = true;
+  }
+  k_spin_unlock(&lock_, key);
+
+  if (resend) {
+    (void)k_work_submit(&start_work_.work);
+  }
+}
+
+/**
+ * @brief 提交当前像素缓冲: 复制到发送缓冲后立即返回.
+ * @return 0 表示已提交或内容未变化, 负值表示失败.
+ * @note 上一帧仍在线上时新帧排队, 排队期间再次提交只保留最新一帧.
+ *       像素与亮度自上次成功提交后没有变化时直接返回, 不复制, 不编码, 不占用 DMA;
+ *       启用时间抖动且该帧仍有小数级时改为排队重发同一帧, 让残差继续推进.
+ */
+int ZephyrWs2812::show_async() noexcept {
   const int init_ret = init_impl();
   if (init_ret < 0) {
     return init_ret;
   }
 
-  /* 组帧: 前置复位低电平 + 像素编码数据 + 尾部复位低电平. */
-  size_t out_idx = 0U;
-  for (size_t i = 0U; i < kResetSymbolCount; ++i) {
-    pulse_buffer_[out_idx++] = 0U;
+  k_spinlock_key_t key = k_spin_lock(&lock_);
+  const bool unchanged = submitted_valid_ && submitted_generation_ == generation_;
+#if defined(CONFIG_SKY_BOARD_WS2812_DITHER)
+  /* 小数级亮度靠帧间平均得到, 画面静止时也要按 show() 的节奏持续重发. */
+  const bool redither = unchanged && !dither_settled_ && !pending_;
+  if (redither) {
+    pending_ = true;
+    resend_ = true;
+  }
+  const bool redither_now = redither && !busy_;
+#endif
+  k_spin_unlock(&lock_, key);
+  if (unchanged) {
+#if defined(CONFIG_SKY_BOARD_WS2812_DITHER)
+    if (redither_now) {
+      (void)k_work_submit(&start_work_.work);
+    }
+#endif
+    return 0;
+  }
+
+  (void)k_mutex_lock(&frame_lock_, K_FOREVER);
+  Frame& frame = frames_[queued_frame_];
+  memcpy(frame.pixels, cfg_.pixels, cfg_.chain_length * sizeof(cfg_.pixels[0]));
+  frame.brightness = brightness_;
+  (void)k_mutex_unlock(&frame_lock_);
+
+  key = k_spin_lock(&lock_);
+  pending_ = true;
+  resend_ = false;
+  submitted_generation_ = generation_;
+  submitted_valid_ = true;
+  has_frame_ = true;
+  const bool busy = busy_;
+  k_spin_unlock(&lock_, key);
+
+  if (!busy) {
+    (void)k_work_submit(&start_work_.work);
   }
-  for (size_t i = 0U; i < kChainLength; ++i) {
-    encode_pixel_impl(out_idx, pixels_[i]);
+  return 0;
+}
+
+/**
+ * @brief 等待排队帧与在途帧全部完成 (含复位锁存).
+ * @param timeout_ms 总超时毫秒, 小于 0 表示永久等待.
+ * @return 0 表示成功, -EAGAIN 表示超时, 其他负值为期间发生的发送错误.
+ * @note 截止时间只在入口计算一次, 每轮只等剩余时间, 排队帧与在途帧合计不超过 timeout_ms.
+ */
+int ZephyrWs2812::wait_idle(const int32_t timeout_ms) noexcept {
+  const int64_t deadline_ms = k_uptime_get() + timeout_ms;
+  while (true) {
+    k_spinlock_key_t key = k_spin_lock(&lock_);
+    const bool idle = !busy_ && !pending_;
+    const int err = last_error_;
+    if (idle) {
+      last_error_ = 0;
+    }
+    k_spin_unlock(&lock_, key);
+
+    if (idle) {
+      return err;
+    }
+    k_timeout_t timeout = K_FOREVER;
+    if (timeout_ms >= 0) {
+      const int64_t remaining_ms = deadline_ms - k_uptime_get();
+      timeout = (remaining_ms > 0) ? K_MSEC(remaining_ms) : K_NO_WAIT;
+    }
+    if (k_sem_take(&done_sem_, timeout) != 0) {
+      return -EAGAIN;
+    }
   }
-  while (out_idx < kPulseBufferSize) {
-    pulse_buffer_[out_idx++] = 0U;
+}
+
+/**
+ * @brief 等待到截止时间, 超时则放弃在途帧.
+ * @param deadline_ms 截止时间 (k_uptime_get 时间轴).
+ * @return 0 表示成功, -ETIMEDOUT 表示超时, 其他负值为发送错误.
+ */
+int ZephyrWs2812::finish_show(const int64_t deadline_ms) noexcept {
+  const int64_t remaining = deadline_ms - k_uptime_get();
+  const int wait_ret = wait_idle(static_cast<int32_t>((remaining > 0) ? remaining : 0));
+  if (wait_ret == -EAGAIN) {
+    abort_impl();
+    return -ETIMEDOUT;
   }
+  return wait_ret;
+}
 
-  /* 发送整帧, 若遇到瞬时 HAL 异常则执行一次恢复重试. */
-  int ret = start_dma_and_wait_impl(kPulseBufferSize);
-  if (ret == -EBUSY || ret == -EIO) {
-    /* 针对瞬时 busy 或 IO 异常, 强制停机后仅重试一帧. */
-    force_stop_impl();
-    k_sleep(K_MSEC(1));
-    ret = start_dma_and_wait_impl(kPulseBufferSize);
+/**
+ * @brief 组帧并发送当前像素缓冲, 阻塞直到发送完成.
+ * @return 0 表示成功, 负值表示失败.
+ */
+int ZephyrWs2812::show() noexcept {
+  const int ret = show_async();
+  if (ret < 0) {
+    return ret;
   }
-  return ret;
+  return finish_show(k_uptime_get() + show_timeout());
 }
 
 /**
@@ -441,9 +1074,7 @@ int ZephyrWs2812::show() noexcept {
  * @return 0 表示成功, 负值表示失败.
  */
 int ZephyrWs2812::clear_and_show() noexcept {
-  for (size_t i = 0U; i < kChainLength; ++i) {
-    pixels_[i] = {};
-  }
+  (void)fill({});
   return show();
 }
 
@@ -453,19 +1084,202 @@ int ZephyrWs2812::clear_and_show() noexcept {
  * @return 0 表示成功.
  */
 int ZephyrWs2812::set_global_brightness(const uint8_t level) noexcept {
-  brightness_ = level;
+  if (brightness_ != level) {
+    brightness_ = level;
+    ++generation_;
+  }
   return 0;
 }
 
-ZephyrWs2812 g_ws2812;
+/* pwms 引用的 PWM 节点的父节点即定时器节点, 提供寄存器基地址与所在总线. */
+#define WS2812_TIMER_NODE(n) DT_PARENT(DT_INST_PWMS_CTLR(n))
+#define WS2812_CHAIN_LENGTH(n) DT_INST_PROP(n, chain_length)
+
+/*
+ * 时间抖动: 编码时以 platform::Ws2812Dither 的 8.8 定点目标值代替 8 bit 亮度表,
+ * 每像素 3 字节残差把舍入误差带到后续帧. 帧仍含小数级时, 内容不变的 show() 也重新编码发送.
+ */
+#if defined(CONFIG_SKY_BOARD_WS2812_DITHER)
+#define WS2812_DITHER_DEFINE(n) uint8_t g_ws2812_residuals_##n[3U * WS2812_CHAIN_LENGTH(n)];
+#define WS2812_DITHER_BUFFER(n) g_ws2812_residuals_##n
+#else
+#define WS2812_DITHER_DEFINE(n)
+#define WS2812_DITHER_BUFFER(n) nullptr
+#endif
+
+/* 为第 n 个设备树实例生成像素/帧/脉冲缓冲, 抖动残差, 配置与驱动对象. */
+#define WS2812_DEFINE(n)                                                                       \
+  static_assert(WS2812_CHAIN_LENGTH(n) > 0, "WS2812 chain-length must be positive");         \
+  static_assert(DT_INST_PWMS_CHANNEL(n) >= 1 && DT_INST_PWMS_CHANNEL(n) <= 4,                 \
+                "WS2812 timer channel must be 1..4");                                         \
+  static_assert(pulse_buffer_size(WS2812_CHAIN_LENGTH(n)) <= UINT16_MAX,                       \
+                "WS2812 frame exceeds one DMA transfer");                                     \
+  platform::Ws2812Rgb g_ws2812_pixels_##n[WS2812_CHAIN_LENGTH(n)];                             \
+  platform::Ws2812Rgb g_ws2812_frames_##n[kFrameBufferCount * WS2812_CHAIN_LENGTH(n)];         \
+  uint32_t g_ws2812_pulses_##n[pulse_buffer_size(WS2812_CHAIN_LENGTH(n))];                     \
+  WS2812_DITHER_DEFINE(n)                                                                      \
+  const Ws2812Config g_ws2812_config_##n = {                                                   \
+      DT_INST_DEP_ORD(n),                                                                      \
+      DT_REG_ADDR(WS2812_TIMER_NODE(n)),                                                       \
+      DT_CLOCKS_CELL(WS2812_TIMER_NODE(n), bus) == STM32_CLOCK_BUS_APB2,                       \
+      DT_INST_PWMS_CHANNEL(n),                                                                 \
+      DT_INST_PWMS_PERIOD(n),                                                                  \
+      (DT_INST_PWMS_FLAGS(n) & PWM_POLARITY_INVERTED) != 0,                                    \
+      DEVICE_DT_GET(DT_INST_DMAS_CTLR_BY_NAME(n, tx)),                                         \
+      DT_INST_DMAS_CELL_BY_NAME(n, tx, channel),                                               \
+      DT_INST_DMAS_CELL_BY_NAME(n, tx, slot),                                                  \
+      STM32_DMA_CONFIG_PRIORITY(DT_INST_DMAS_CELL_BY_NAME(n, tx, channel_config)),             \
+      WS2812_CHAIN_LENGTH(n),                                                                  \
+      DT_INST_PROP(n, reset_us),                                                               \
+      normalize_offset(DT_INST_PROP(n, pixel_offset), WS2812_CHAIN_LENGTH(n)),                 \
+      make_wire_order(parse_color_order(DT_INST_PROP(n, color_order))),                        \
+      g_ws2812_pixels_##n,                                                                     \
+      g_ws2812_frames_##n,                                                                     \
+      WS2812_DITHER_BUFFER(n),                                                                 \
+      g_ws2812_pulses_##n,                                                                     \
+      pulse_buffer_size(WS2812_CHAIN_LENGTH(n)),                                               \
+  };                                                                                           \
+  ZephyrWs2812 g_ws2812_##n(g_ws2812_config_##n);
+
+#define WS2812_INSTANCE_PTR(n) &g_ws2812_##n,
+
+DT_INST_FOREACH_STATUS_OKAY(WS2812_DEFINE)
+
+/** @brief 全部实例, 末尾的 nullptr 保证没有节点时数组非空. */
+ZephyrWs2812* const g_ws2812_table[] = {DT_INST_FOREACH_STATUS_OKAY(WS2812_INSTANCE_PTR) nullptr};
+/** @brief 实例个数. */
+constexpr size_t kInstanceCount = ARRAY_SIZE(g_ws2812_table) - 1U;
+
+#if DT_NODE_HAS_COMPAT_STATUS(DT_ALIAS(ws2812_0), DT_DRV_COMPAT, okay)
+/** @brief ws2812-0 别名指向的节点, ws2812() 优先返回它. */
+constexpr uint32_t kPrimaryDepOrd = DT_DEP_ORD(DT_ALIAS(ws2812_0));
+#else
+constexpr uint32_t kPrimaryDepOrd = UINT32_MAX;
+#endif
+
+#if !DT_HAS_COMPAT_STATUS_OKAY(DT_DRV_COMPAT)
+/* 没有启用的节点时提供一个空实例: size() 为 0, init/show 返回 -ENODEV. */
+platform::Ws2812Rgb g_ws2812_none_pixel[1];
+uint32_t g_ws2812_none_pulse[1];
+const Ws2812Config g_ws2812_none_config = {
+    UINT32_MAX,          /* dep_ord */
+    0U,                  /* timer_base */
+    false,               /* timer_on_apb2 */
+    1U,                  /* channel */
+    0U,                  /* period_ns */
+    false,               /* inverted */
+    nullptr,             /* dma_dev */
+    0U,                  /* dma_stream */
+    0U,                  /* dma_slot */
+    0U,                  /* dma_priority */
+    0U,                  /* chain_length */
+    0U,                  /* reset_us */
+    0U,                  /* pixel_offset */
+    {{1U, 0U, 2U}},      /* wire_order */
+    g_ws2812_none_pixel, /* pixels */
+    g_ws2812_none_pixel, /* frame_pixels */
+    nullptr,             /* dither_residuals */
+    g_ws2812_none_pulse, /* pulse_buffer */
+    0U,                  /* pulse_buffer_size */
+};
+ZephyrWs2812 g_ws2812_none(g_ws2812_none_config);
+#endif
+
+/**
+ * @brief 获取主实例: ws2812-0 别名指向的节点, 没有别名时为第一个实例.
+ * @return 驱动实例.
+ */
+ZephyrWs2812& primary_ws2812() noexcept {
+#if DT_HAS_COMPAT_STATUS_OKAY(DT_DRV_COMPAT)
+  for (size_t i = 0U; i < kInstanceCount; ++i) {
+    if (g_ws2812_table[i]->dep_ord() == kPrimaryDepOrd) {
+      return *g_ws2812_table[i];
+    }
+  }
+  return *g_ws2812_table[0];
+#else
+  return g_ws2812_none;
+#endif
+}
+
+/**
+ * @brief DMA 完成/错误回调.
+ * @param dev DMA 设备, 未使用.
+ * @param user_data 驱动实例.
+ * @param channel DMA stream, 未使用.
+ * @param status 传输状态.
+ */
+void on_dma_done(const struct device* dev, void* user_data, uint32_t channel, int status) {
+  (void)dev;
+  (void)channel;
+  static_cast<ZephyrWs2812*>(user_data)->dma_done(status);
+}
+
+/**
+ * @brief 复位锁存定时器到期回调.
+ * @param timer 定时器, user_data 为驱动实例.
+ */
+void on_latch_expired(struct k_timer* timer) {
+  static_cast<ZephyrWs2812*>(k_timer_user_data_get(timer))->latch_done();
+}
+
+/**
+ * @brief 帧启动工作项回调.
+ * @param work 工作项.
+ */
+void on_start_work(struct k_work* work) {
+  CONTAINER_OF(work, StartWork, work)->owner->start_pending();
+}
+
+/**
+ * @brief 保活定时器到期回调.
+ * @param timer 定时器, user_data 为驱动实例.
+ */
+void on_refresh_expired(struct k_timer* timer) {
+  static_cast<ZephyrWs2812*>(k_timer_user_data_get(timer))->refresh_due();
+}
 
 }  // namespace
 
-#undef WS2812_NODE
+#undef WS2812_INSTANCE_PTR
+#undef WS2812_DEFINE
+#undef WS2812_CHAIN_LENGTH
+#undef WS2812_TIMER_NODE
+#undef DT_DRV_COMPAT
 
 namespace platform {
 
-IWs2812& ws2812() noexcept { return g_ws2812; }
+IWs2812& ws2812() noexcept { return primary_ws2812(); }
+
+size_t ws2812_count() noexcept { return kInstanceCount; }
+
+IWs2812* ws2812_at(const size_t index) noexcept {
+  return (index < kInstanceCount) ? g_ws2812_table[index] : nullptr;
+}
+
+int ws2812_show_all() noexcept {
+  /* 先全部提交: 各实例在工作队列上依次编码, 先启动的 DMA 与后续实例的编码重叠. */
+  int first_error = 0;
+  int32_t timeout_ms = 0;
+  for (size_t i = 0U; i < kInstanceCount; ++i) {
+    const int ret = g_ws2812_table[i]->show_async();
+    if (ret < 0 && first_error == 0) {
+      first_error = ret;
+    }
+    const int32_t t = g_ws2812_table[i]->show_timeout();
+    timeout_ms = (t > timeout_ms) ? t : timeout_ms;
+  }
+
+  /* 再按同一个截止时间等待: 总耗时约为最长一条灯带的发送时间, 而不是各条之和. */
+  const int64_t deadline_ms = k_uptime_get() + timeout_ms;
+  for (size_t i = 0U; i < kInstanceCount; ++i) {
+    const int ret = g_ws2812_table[i]->finish_show(deadline_ms);
+    if (ret < 0 && first_error == 0) {
+      first_error = ret;
+    }
+  }
+  return first_error;
+}
 
 Ws2812Rgb ws2812_wheel(uint8_t pos) noexcept {
   pos = static_cast<uint8_t>(255U - pos);
@@ -480,6 +1294,35 @@ Ws2812Rgb ws2812_wheel(uint8_t pos) noexcept {
   return {static_cast<uint8_t>(pos * 3U), static_cast<uint8_t>(255U - pos * 3U), 0U};
 }
 
+Ws2812Rgb ws2812_hsv(uint16_t hue, const uint8_t sat, const uint8_t val) noexcept {
+  hue = static_cast<uint16_t>(hue % kWs2812HueRange);
+  const uint32_t frac = hue & 0xFFU;
+  const uint32_t v = val;
+  /* 各分量 = val * (255 - sat * k / 255) / 255, k 为 255, frac 或 255 - frac. */
+  const auto fade = [v, sat](const uint32_t k) {
+    const uint32_t drop = (static_cast<uint32_t>(sat) * k + 127U) / 255U;
+    return static_cast<uint8_t>((v * (255U - drop) + 127U) / 255U);
+  };
+  const uint8_t p = fade(255U);
+  const uint8_t q = fade(frac);
+  const uint8_t t = fade(255U - frac);
+  const uint8_t vv = static_cast<uint8_t>(v);
+  switch (hue >> 8) {
+    case 0:
+      return {vv, t, p};
+    case 1:
+      return {q, vv, p};
+    case 2:
+      return {p, vv, t};
+    case 3:
+      return {p, q, vv};
+    case 4:
+      return {t, p, vv};
+    default:
+      return {vv, p, q};
+  }
+}
+
 int ws2812_wheel_show(IWs2812& ws, const uint8_t phase) noexcept {
   const size_t count = ws.size();
   if (count == 0U) {
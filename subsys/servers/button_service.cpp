@@ -7,6 +7,7 @@
 
 #include <errno.h>
 
+#include "platform/platform_backlight.hpp"
 #include "platform/platform_buzzer.hpp"
 
 namespace servers {
@@ -226,7 +227,7 @@ void ButtonService::threadEntry(void* p1, void*, void*) {
 /**
  * @brief 按键服务主线程.
  * @note
- * 1) 阻塞读取平台按键事件.
+ * 1) 阻塞读取平台按键事件, 每个事件都上报为背光用户操作.
  * 2) 在释放沿计算按住时长并判定短按/长按.
  * 3) 更新内部状态缓存.
  * 4) 在锁外触发回调, 避免回调内潜在阻塞导致死锁.
@@ -249,6 +250,7 @@ void ButtonService::threads() noexcept {
       continue;
     }
     error_streak = 0U;
+    platform::backlight_user_activity();
 
     bool long_press_triggered = false;
     int64_t hold_ms = 0;
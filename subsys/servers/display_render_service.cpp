@@ -0,0 +1,1005 @@
+/**
+ * @file display_render_service.cpp
+ * @brief 异步显示渲染服务实现。
+ */
+
+#include "servers/display_render_service.hpp"
+
+#include <errno.h>
+#include <string.h>
+
+#include "platform/cjk_font.hpp"
+#include "platform/platform_spi_flash.hpp"
+#include "platform/shape_raster.hpp"
+
+namespace servers {
+
+namespace {
+
+/**
+ * @brief 判断 fence 序号 a 是否不早于 b（按 32-bit 回绕比较）。
+ * @param a 序号 a。
+ * @param b 序号 b。
+ * @return true 表示 a >= b。
+ */
+bool seq_reached(uint32_t a, uint32_t b) {
+  return static_cast<int32_t>(a - b) >= 0;
+}
+
+}  // namespace
+
+/**
+ * @brief 光栅化线程入口静态适配函数。
+ * @param p1 DisplayRenderService 对象指针。
+ */
+void DisplayRenderService::renderThreadEntry(void* p1, void*, void*) {
+  static_cast<DisplayRenderService*>(p1)->render_loop();
+}
+
+/**
+ * @brief 发送线程入口静态适配函数。
+ * @param p1 DisplayRenderService 对象指针。
+ */
+void DisplayRenderService::txThreadEntry(void* p1, void*, void*) {
+  static_cast<DisplayRenderService*>(p1)->tx_loop();
+}
+
+/**
+ * @brief 启动光栅化与发送线程。
+ * @return 0 表示成功或已运行；负值表示失败。
+ * @note 启动后面板由服务独占，调用方不应再直接访问底层显示实例。
+ */
+int DisplayRenderService::run() noexcept {
+  if (!atomic_cas(&running_, 0, 1)) {
+    log_.info("display render service already running");
+    return 0;
+  }
+
+  int ret = panel_.init();
+  if (ret < 0) {
+    atomic_set(&running_, 0);
+    log_.error("failed to init display panel", ret);
+    return ret;
+  }
+
+  width_ = panel_.width();
+  height_ = panel_.height();
+  if (width_ == 0U || width_ > kStripWidth) {
+    atomic_set(&running_, 0);
+    log_.error("display width not supported by render service", -ENOTSUP);
+    return -ENOTSUP;
+  }
+
+  /* 线程启动前重建队列与同步原语，确保每次 run() 行为一致。 */
+  k_msgq_init(&cmd_q_, cmd_q_buf_, sizeof(Command), kCommandQueueDepth);
+  k_msgq_init(&tx_q_, tx_q_buf_, sizeof(TxJob), kTxQueueDepth);
+  k_sem_init(&free_strips_, kStripBufferCount, kStripBufferCount);
+  k_mutex_init(&fence_mutex_);
+  k_mutex_init(&enqueue_mutex_);
+  k_condvar_init(&fence_cond_);
+  completed_fence_ = static_cast<uint32_t>(atomic_get(&fence_seq_));
+  next_strip_ = 0U;
+  list_.reset();
+  mode_ = platform::DisplayMode::kImmediate;
+  requested_mode_ = platform::DisplayMode::kImmediate;
+  tx_error_streak_ = 0U;
+  atomic_set(&stop_requested_, 0);
+  atomic_set(&live_threads_, 2);
+
+  k_tid_t tx_id = k_thread_create(&tx_thread_, tx_stack_, K_THREAD_STACK_SIZEOF(tx_stack_),
+                                  txThreadEntry, this, nullptr, nullptr, kTxPriority, 0, K_NO_WAIT);
+  if (tx_id == nullptr) {
+    atomic_set(&running_, 0);
+    log_.error("failed to create display tx thread", -1);
+    return -1;
+  }
+  k_thread_name_set(tx_id, "display_tx");
+
+  k_tid_t render_id =
+      k_thread_create(&render_thread_, render_stack_, K_THREAD_STACK_SIZEOF(render_stack_),
+                      renderThreadEntry, this, nullptr, nullptr, kRenderPriority, 0, K_NO_WAIT);
+  if (render_id == nullptr) {
+    /* 发送线程已启动：通过停止标志让其自行退出并清除运行标志。 */
+    atomic_set(&live_threads_, 1);
+    atomic_set(&stop_requested_, 1);
+    log_.error("failed to create display render thread", -1);
+    return -1;
+  }
+  k_thread_name_set(render_id, "display_render");
+  return 0;
+}
+
+/**
+ * @brief 请求停止服务线程。
+ * @note 线程在下一个轮询周期内观察到停止标志后退出。
+ */
+void DisplayRenderService::stop() noexcept {
+  if (atomic_get(&running_) == 0) {
+    return;
+  }
+  atomic_set(&stop_requested_, 1);
+}
+
+/**
+ * @brief 服务线程退出收尾。
+ * @param name 线程名。
+ */
+void DisplayRenderService::on_thread_exit(const char* name) noexcept {
+  log_.infof("[display] %s thread stopped", name);
+  if (atomic_dec(&live_threads_) == 1) {
+    atomic_set(&running_, 0);
+    log_.info("display render service stopped");
+  }
+}
+
+/**
+ * @brief 以非阻塞方式把命令放入队列。
+ * @param cmd 命令。
+ * @return 0 表示成功；-EAGAIN 队列已满；-ENODEV 服务未运行。
+ * @note 持有 enqueue_mutex_ 入队（可重入），多命令绘制在同一把锁内统计空位并入队时，
+ *       其他生产者无法插入占用空位。
+ */
+int DisplayRenderService::enqueue(const Command& cmd) noexcept {
+  if (atomic_get(&running_) == 0 || atomic_get(&stop_requested_) != 0) {
+    return -ENODEV;
+  }
+
+  k_mutex_lock(&enqueue_mutex_, K_FOREVER);
+  const int ret = k_msgq_put(&cmd_q_, &cmd, K_NO_WAIT) == 0 ? 0 : -EAGAIN;
+  k_mutex_unlock(&enqueue_mutex_);
+  return ret;
+}
+
+/**
+ * @brief 初始化底层面板。
+ * @return 0 表示成功；负值表示失败。
+ */
+int DisplayRenderService::init() noexcept {
+  return panel_.init();
+}
+
+/**
+ * @brief 异步清屏。
+ * @param color_rgb565 RGB565 颜色值。
+ * @return 0 表示已入队；负值表示失败。
+ */
+int DisplayRenderService::clear(uint16_t color_rgb565) noexcept {
+  return fill_rect(0U, 0U, width_, height_, color_rgb565);
+}
+
+/**
+ * @brief 异步填充矩形。
+ * @param x 左上角 X。
+ * @param y 左上角 Y。
+ * @param w 宽度。
+ * @param h 高度。
+ * @param color_rgb565 RGB565 颜色值。
+ * @return 0 表示已入队；负值表示失败。
+ */
+int DisplayRenderService::fill_rect(uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+                                    uint16_t color_rgb565) noexcept {
+  if (w == 0U || h == 0U) {
+    return 0;
+  }
+
+  Command cmd{};
+  cmd.type = CommandType::kFill;
+  cmd.x = x;
+  cmd.y = y;
+  cmd.w = w;
+  cmd.h = h;
+  cmd.fg_rgb565 = color_rgb565;
+  return enqueue(cmd);
+}
+
+/**
+ * @brief 异步绘制直线。
+ * @param x0 起点 X。
+ * @param y0 起点 Y。
+ * @param x1 终点 X。
+ * @param y1 终点 Y。
+ * @param color_rgb565 RGB565 颜色值。
+ * @return 0 表示已入队；负值表示失败。
+ */
+int DisplayRenderService::draw_line(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                                    uint16_t color_rgb565) noexcept {
+  Command cmd{};
+  cmd.type = CommandType::kShape;
+  cmd.fg_rgb565 = color_rgb565;
+  cmd.payload.shape = {ShapeKind::kLine, false, x0, y0, x1, y1, 0U, 0U, 0U};
+  return enqueue(cmd);
+}
+
+/**
+ * @brief 异步绘制圆或实心圆。
+ * @param cx 圆心 X。
+ * @param cy 圆心 Y。
+ * @param r 半径。
+ * @param color_rgb565 RGB565 颜色值。
+ * @param filled true 为实心。
+ * @return 0 表示已入队；负值表示失败。
+ */
+int DisplayRenderService::draw_circle(int16_t cx, int16_t cy, uint16_t r, uint16_t color_rgb565,
+                                      bool filled) noexcept {
+  Command cmd{};
+  cmd.type = CommandType::kShape;
+  cmd.fg_rgb565 = color_rgb565;
+  cmd.payload.shape = {ShapeKind::kCircle, filled, cx, cy, 0, 0, 0U, 0U, r};
+  return enqueue(cmd);
+}
+
+/**
+ * @brief 异步绘制圆角矩形或实心圆角矩形。
+ * @param x 左上角 X。
+ * @param y 左上角 Y。
+ * @param w 宽度。
+ * @param h 高度。
+ * @param r 圆角半径。
+ * @param color_rgb565 RGB565 颜色值。
+ * @param filled true 为实心。
+ * @return 0 表示已入队；负值表示失败。
+ */
+int DisplayRenderService::draw_round_rect(int16_t x, int16_t y, uint16_t w, uint16_t h,
+                                          uint16_t r, uint16_t color_rgb565,
+                                          bool filled) noexcept {
+  if (w == 0U || h == 0U) {
+    return 0;
+  }
+
+  Command cmd{};
+  cmd.type = CommandType::kShape;
+  cmd.fg_rgb565 = color_rgb565;
+  cmd.payload.shape = {ShapeKind::kRoundRect, filled, x, y, 0, 0, w, h, r};
+  return enqueue(cmd);
+}
+
+/**
+ * @brief 异步绘制单个字符。
+ * @param x 左上角 X。
+ * @param y 左上角 Y。
+ * @param c 待绘制字符。
+ * @param fg_rgb565 前景色。
+ * @param bg_rgb565 背景色。
+ * @param scale 缩放倍数，0 按 1 处理。
+ * @return 0 表示已入队；负值表示失败。
+ */
+int DisplayRenderService::draw_char(uint16_t x, uint16_t y, char c, uint16_t fg_rgb565,
+                                    uint16_t bg_rgb565, uint8_t scale) noexcept {
+  Command cmd{};
+  cmd.type = CommandType::kText;
+  cmd.scale = scale == 0U ? 1U : scale;
+  cmd.x = x;
+  cmd.y = y;
+  cmd.w = 1U;
+  cmd.fg_rgb565 = fg_rgb565;
+  cmd.bg_rgb565 = bg_rgb565;
+  cmd.payload.text[0] = c;
+  return enqueue(cmd);
+}
+
+/**
+ * @brief 异步绘制字符串（支持 '\n'）。
+ * @param x 起始 X。
+ * @param y 起始 Y。
+ * @param text 字符串。
+ * @param fg_rgb565 前景色。
+ * @param bg_rgb565 背景色。
+ * @param scale 缩放倍数，0 按 1 处理。
+ * @return 0 表示已入队；负值表示失败。
+ * @note 先统计所需命令条数再整体入队，队列空间不足时整段丢弃，避免只显示半行；
+ *       统计与入队在 enqueue_mutex_ 内完成，其他生产者不会在中途占用空位。
+ */
+int DisplayRenderService::draw_text(uint16_t x, uint16_t y, const char* text, uint16_t fg_rgb565,
+                                    uint16_t bg_rgb565, uint8_t scale) noexcept {
+  if (text == nullptr) {
+    return -EINVAL;
+  }
+
+  if (atomic_get(&running_) == 0) {
+    return -ENODEV;
+  }
+
+  if (scale == 0U) {
+    scale = 1U;
+  }
+
+  const uint32_t step_x = static_cast<uint32_t>(platform::raster::kCellWidth) * scale;
+  uint32_t step_y =
+      static_cast<uint32_t>(platform::font5x7::kHeight + platform::font5x7::kSpacing) * scale;
+#if defined(CONFIG_SKY_BOARD_CJK_FONT)
+  /* 含多字节字符的文本按 UTF-8 行高排版，并按字符边界分段。 */
+  const bool utf8 = platform::raster::utf8_has_multibyte(text, strlen(text));
+  if (utf8) {
+    step_y = platform::raster::utf8_line_height(scale) +
+             static_cast<uint32_t>(platform::font5x7::kSpacing) * scale;
+  }
+#endif
+
+  /* 第一遍统计命令条数，第二遍入队；两遍使用相同的切分规则。 */
+  int ret = 0;
+  k_mutex_lock(&enqueue_mutex_, K_FOREVER);
+  for (int pass = 0; pass < 2 && ret == 0; ++pass) {
+    uint32_t needed = 0U;
+    uint32_t cursor_y = y;
+    const char* line = text;
+    while (cursor_y < height_) {
+      size_t len = 0U;
+      while (line[len] != '\0' && line[len] != '\n') {
+        ++len;
+      }
+
+      uint32_t cursor_x = x;
+      size_t done = 0U;
+      while (done < len && cursor_x < width_ && ret == 0) {
+#if defined(CONFIG_SKY_BOARD_CJK_FONT)
+        const size_t chunk =
+            utf8 ? platform::raster::utf8_prefix(line + done, len - done, kMaxInlineText)
+                 : ((len - done) < kMaxInlineText ? (len - done) : kMaxInlineText);
+#else
+        const size_t chunk = (len - done) < kMaxInlineText ? (len - done) : kMaxInlineText;
+#endif
+        if (pass == 0) {
+          ++needed;
+        } else {
+          Command cmd{};
+#if defined(CONFIG_SKY_BOARD_CJK_FONT)
+          /* 排版方式对整段文本只判定一次，逐段判定会让纯 ASCII 段落回 5x7 行高。 */
+          cmd.type = utf8 ? CommandType::kUtf8Text : CommandType::kText;
+#else
+          cmd.type = CommandType::kText;
+#endif
+          cmd.scale = scale;
+          cmd.x = static_cast<uint16_t>(cursor_x);
+          cmd.y = static_cast<uint16_t>(cursor_y);
+          cmd.w = static_cast<uint16_t>(chunk);
+          cmd.fg_rgb565 = fg_rgb565;
+          cmd.bg_rgb565 = bg_rgb565;
+          (void)memcpy(cmd.payload.text, line + done, chunk);
+          ret = enqueue(cmd);
+        }
+#if defined(CONFIG_SKY_BOARD_CJK_FONT)
+        cursor_x += utf8 ? platform::raster::utf8_line_width(line + done, chunk, scale)
+                         : static_cast<uint32_t>(chunk) * step_x;
+#else
+        cursor_x += static_cast<uint32_t>(chunk) * step_x;
+#endif
+        done += chunk;
+      }
+
+      if (line[len] == '\0' || ret < 0) {
+        break;
+      }
+      line += len + 1U;
+      cursor_y += step_y;
+    }
+
+    if (pass == 0) {
+      if (needed > kCommandQueueDepth) {
+        ret = -E2BIG;
+      } else if (k_msgq_num_free_get(&cmd_q_) < needed) {
+        ret = -EAGAIN;
+      }
+    }
+  }
+  k_mutex_unlock(&enqueue_mutex_);
+
+  return ret;
+}
+
+/**
+ * @brief 异步绘制有符号整数。
+ * @param x 起始 X。
+ * @param y 起始 Y。
+ * @param value 待绘制整数。
+ * @param fg_rgb565 前景色。
+ * @param bg_rgb565 背景色。
+ * @param scale 缩放倍数，0 按 1 处理。
+ * @return 0 表示已入队；负值表示失败。
+ */
+int DisplayRenderService::draw_int(uint16_t x, uint16_t y, int32_t value, uint16_t fg_rgb565,
+                                   uint16_t bg_rgb565, uint8_t scale) noexcept {
+  Command cmd{};
+  cmd.type = CommandType::kText;
+  cmd.scale = scale == 0U ? 1U : scale;
+  cmd.x = x;
+  cmd.y = y;
+  cmd.w = static_cast<uint16_t>(
+      platform::raster::format_int(value, cmd.payload.text, sizeof(cmd.payload.text)));
+  cmd.fg_rgb565 = fg_rgb565;
+  cmd.bg_rgb565 = bg_rgb565;
+  return enqueue(cmd);
+}
+
+/**
+ * @brief 异步写入像素块。
+ * @param x 左上角 X。
+ * @param y 左上角 Y。
+ * @param w 宽度。
+ * @param h 高度。
+ * @param pixels 像素数据。
+ * @return 0 表示已入队；负值表示失败。
+ * @note 窄块按整行打包（每条命令若干行），宽块按行内 kMaxInlinePixels 个像素分段；
+ *       与 draw_text 相同，在 enqueue_mutex_ 内统计空位并整体入队。
+ */
+int DisplayRenderService::blit(uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+                               const uint16_t* pixels) noexcept {
+  if (pixels == nullptr) {
+    return -EINVAL;
+  }
+
+  if (atomic_get(&running_) == 0) {
+    return -ENODEV;
+  }
+
+  if (w == 0U || h == 0U) {
+    return 0;
+  }
+
+  if (x >= width_ || y >= height_ || w > (width_ - x) || h > (height_ - y)) {
+    return -EINVAL;
+  }
+
+  constexpr uint16_t kSegPixels = static_cast<uint16_t>(kMaxInlinePixels);
+  const uint16_t rows_per_cmd = static_cast<uint16_t>(w <= kSegPixels ? kSegPixels / w : 1U);
+  const uint16_t segs_per_row = static_cast<uint16_t>((w + kSegPixels - 1U) / kSegPixels);
+  const uint32_t needed =
+      static_cast<uint32_t>((h + rows_per_cmd - 1U) / rows_per_cmd) * segs_per_row;
+  /* 超过队列深度的块即使队列全空也放不下，返回 -E2BIG 而不是让调用方无休止地重试。 */
+  if (needed > kCommandQueueDepth) {
+    return -E2BIG;
+  }
+
+  int ret = 0;
+  k_mutex_lock(&enqueue_mutex_, K_FOREVER);
+  if (k_msgq_num_free_get(&cmd_q_) < needed) {
+    ret = -EAGAIN;
+  }
+  for (uint16_t row = 0U; row < h && ret == 0; row = static_cast<uint16_t>(row + rows_per_cmd)) {
+    const uint16_t rows =
+        static_cast<uint16_t>((h - row) < rows_per_cmd ? (h - row) : rows_per_cmd);
+    for (uint16_t col = 0U; col < w && ret == 0; col = static_cast<uint16_t>(col + kSegPixels)) {
+      const uint16_t cols =
+          static_cast<uint16_t>((w - col) < kSegPixels ? (w - col) : kSegPixels);
+      Command cmd{};
+      cmd.type = CommandType::kBlit;
+      cmd.x = static_cast<uint16_t>(x + col);
+      cmd.y = static_cast<uint16_t>(y + row);
+      cmd.w = cols;
+      cmd.h = rows;
+      for (uint16_t r = 0U; r < rows; ++r) {
+        (void)memcpy(&cmd.payload.pixels[static_cast<size_t>(r) * cols],
+                     &pixels[static_cast<size_t>(row + r) * w + col], cols * sizeof(pixels[0]));
+      }
+      ret = enqueue(cmd);
+    }
+  }
+  k_mutex_unlock(&enqueue_mutex_);
+
+  return ret;
+}
+
+/**
+ * @brief 异步绘制外置 SPI Flash 中的 RLE 图像。
+ * @param x 左上角 X。
+ * @param y 左上角 Y。
+ * @param flash_offset 图像资源偏移。
+ * @return 0 表示已入队；负值表示失败。
+ */
+int DisplayRenderService::draw_image(uint16_t x, uint16_t y, uint32_t flash_offset) noexcept {
+  if (atomic_get(&running_) == 0) {
+    return -ENODEV;
+  }
+
+  if (x >= width_ || y >= height_) {
+    return -EINVAL;
+  }
+
+  Command cmd{};
+  cmd.type = CommandType::kImage;
+  cmd.x = x;
+  cmd.y = y;
+  cmd.flash_offset = flash_offset;
+  return enqueue(cmd);
+}
+
+/**
+ * @brief 排空流水线后同步绘制启动画面。
+ * @return 0 表示已入队；负值表示失败。
+ */
+int DisplayRenderService::show_boot_screen() noexcept {
+  Command cmd{};
+  cmd.type = CommandType::kBootScreen;
+  return enqueue(cmd);
+}
+
+/**
+ * @brief 异步切换绘制模式。
+ * @param mode 目标模式。
+ * @return 0 表示已入队；负值表示失败。
+ */
+int DisplayRenderService::set_mode(platform::DisplayMode mode) noexcept {
+  /* 渲染服务自带 RGB565 条带流水线，调色板帧缓冲与日志控制台只在面板后端直接使用。 */
+  if (mode == platform::DisplayMode::kPaletteFramebuffer ||
+      mode == platform::DisplayMode::kConsole) {
+    return -ENOTSUP;
+  }
+
+  Command cmd{};
+  cmd.type = CommandType::kSetMode;
+  cmd.mode = mode;
+  const int ret = enqueue(cmd);
+  if (ret == 0) {
+    requested_mode_ = mode;
+  }
+  return ret;
+}
+
+/**
+ * @brief 异步下发保留模式下记录的内容。
+ * @return 0 表示已入队；负值表示失败。
+ */
+int DisplayRenderService::flush() noexcept {
+  Command cmd{};
+  cmd.type = CommandType::kFlush;
+  return enqueue(cmd);
+}
+
+/**
+ * @brief 提交 fence。
+ * @param[out] out_seq fence 序号。
+ * @return 0 表示成功；负值表示失败。
+ */
+int DisplayRenderService::submit_fence(uint32_t& out_seq) noexcept {
+  Command cmd{};
+  cmd.type = CommandType::kFence;
+  /* 序号分配与入队在同一临界区内完成，保证队列中的 fence 序号单调递增。 */
+  k_mutex_lock(&fence_mutex_, K_FOREVER);
+  cmd.seq = static_cast<uint32_t>(atomic_get(&fence_seq_)) + 1U;
+  const int ret = enqueue(cmd);
+  if (ret == 0) {
+    atomic_set(&fence_seq_, static_cast<atomic_val_t>(cmd.seq));
+    out_seq = cmd.seq;
+  }
+  k_mutex_unlock(&fence_mutex_);
+  return ret;
+}
+
+/**
+ * @brief 查询 fence 是否已完成。
+ * @param seq fence 序号。
+ * @return true 表示已完成。
+ */
+bool DisplayRenderService::fence_done(uint32_t seq) noexcept {
+  k_mutex_lock(&fence_mutex_, K_FOREVER);
+  const bool done = seq_reached(completed_fence_, seq);
+  k_mutex_unlock(&fence_mutex_);
+  return done;
+}
+
+/**
+ * @brief 等待 fence 完成。
+ * @param seq fence 序号。
+ * @param timeout_ms 最长等待时间（毫秒）。
+ * @return 0 表示已完成；-ETIMEDOUT 表示超时；-EINVAL 表示参数非法。
+ */
+int DisplayRenderService::wait_fence(uint32_t seq, int64_t timeout_ms) noexcept {
+  if (timeout_ms <= 0) {
+    return -EINVAL;
+  }
+
+  const int64_t deadline_ms = k_uptime_get() + timeout_ms;
+  int ret = 0;
+  k_mutex_lock(&fence_mutex_, K_FOREVER);
+  while (!seq_reached(completed_fence_, seq)) {
+    const int64_t remaining_ms = deadline_ms - k_uptime_get();
+    if (remaining_ms <= 0) {
+      ret = -ETIMEDOUT;
+      break;
+    }
+    (void)k_condvar_wait(&fence_cond_, &fence_mutex_, K_MSEC(remaining_ms));
+  }
+  k_mutex_unlock(&fence_mutex_);
+  return ret;
+}
+
+/**
+ * @brief 获取一个空闲条带缓冲。
+ * @param[out] out_index 缓冲下标。
+ * @return 0 表示成功；-ECANCELED 表示服务正在停止。
+ * @note 发送线程按提交顺序归还缓冲，因此轮转分配得到的下标一定已空闲。
+ */
+int DisplayRenderService::acquire_strip(uint8_t& out_index) noexcept {
+  while (k_sem_take(&free_strips_, K_MSEC(kPollPeriodMs)) != 0) {
+    if (atomic_get(&stop_requested_) != 0) {
+      return -ECANCELED;
+    }
+  }
+
+  out_index = next_strip_;
+  next_strip_ = static_cast<uint8_t>((next_strip_ + 1U) % kStripBufferCount);
+  return 0;
+}
+
+/**
+ * @brief 把任务交给发送线程。
+ * @param job 发送任务。
+ * @return 0 表示成功；-ECANCELED 表示服务正在停止。
+ */
+int DisplayRenderService::post_tx(const TxJob& job) noexcept {
+  while (k_msgq_put(&tx_q_, &job, K_MSEC(kPollPeriodMs)) != 0) {
+    if (atomic_get(&stop_requested_) != 0) {
+      return -ECANCELED;
+    }
+  }
+  return 0;
+}
+
+/**
+ * @brief 等待全部条带缓冲回到空闲状态。
+ * @return 0 表示成功；-ECANCELED 表示服务正在停止。
+ */
+int DisplayRenderService::drain_pipeline() noexcept {
+  size_t taken = 0U;
+  while (taken < kStripBufferCount) {
+    if (k_sem_take(&free_strips_, K_MSEC(kPollPeriodMs)) == 0) {
+      ++taken;
+    } else if (atomic_get(&stop_requested_) != 0) {
+      break;
+    }
+  }
+
+  for (size_t i = 0U; i < taken; ++i) {
+    k_sem_give(&free_strips_);
+  }
+  return taken == kStripBufferCount ? 0 : -ECANCELED;
+}
+
+/**
+ * @brief 把显示列表按脏矩形逐条带光栅化并交给发送线程，随后清空列表。
+ * @note 光栅化第 N+1 个条带时，发送线程正在把第 N 个条带写入面板。
+ */
+void DisplayRenderService::render_list() noexcept {
+  for (size_t i = 0U; i < list_.dirty_count(); ++i) {
+    const platform::raster::Rect rect = list_.dirty_at(i);
+    const uint16_t strip_rows = static_cast<uint16_t>(kStripPixels / rect.w);
+    for (uint16_t row = 0U; row < rect.h; row = static_cast<uint16_t>(row + strip_rows)) {
+      TxJob job{};
+      job.region = {rect.x, static_cast<uint16_t>(rect.y + row), rect.w,
+                    static_cast<uint16_t>((rect.h - row) < strip_rows ? (rect.h - row)
+                                                                      : strip_rows)};
+      if (acquire_strip(job.buffer) < 0) {
+        list_.reset();
+        return;
+      }
+      list_.render(job.region, strips_[job.buffer]);
+      if (post_tx(job) < 0) {
+        list_.reset();
+        return;
+      }
+    }
+  }
+
+  list_.reset();
+}
+
+/**
+ * @brief 逐条带解码 RLE 图像并交给发送线程，超出屏幕的列跳过、行不再解码。
+ * @param cmd 图像命令。
+ * @return 0 表示成功；负值表示失败。
+ * @note 解码第 N+1 个条带（含 Flash 读取）时，发送线程正在把第 N 个条带写入面板。
+ */
+int DisplayRenderService::render_image(const Command& cmd) noexcept {
+  int ret = image_reader_.open(platform::spi_flash_ext(), cmd.flash_offset);
+  if (ret < 0) {
+    return ret;
+  }
+
+  const uint16_t max_w = static_cast<uint16_t>(width_ - cmd.x);
+  const uint16_t max_h = static_cast<uint16_t>(height_ - cmd.y);
+  const uint16_t w = image_reader_.width() < max_w ? image_reader_.width() : max_w;
+  const uint16_t h = image_reader_.height() < max_h ? image_reader_.height() : max_h;
+  const uint16_t strip_rows = static_cast<uint16_t>(kStripPixels / w);
+  for (uint16_t row = 0U; row < h; row = static_cast<uint16_t>(row + strip_rows)) {
+    TxJob job{};
+    job.region = {cmd.x, static_cast<uint16_t>(cmd.y + row), w,
+                  static_cast<uint16_t>((h - row) < strip_rows ? (h - row) : strip_rows)};
+    ret = acquire_strip(job.buffer);
+    if (ret < 0) {
+      return ret;
+    }
+    ret = image_reader_.read_rows(strips_[job.buffer], w, 0U, w, job.region.h);
+    if (ret < 0) {
+      /* 归还未提交的条带并回退轮转下标，保持“按提交顺序归还”的分配前提。 */
+      next_strip_ = job.buffer;
+      k_sem_give(&free_strips_);
+      return ret;
+    }
+    ret = post_tx(job);
+    if (ret < 0) {
+      return ret;
+    }
+  }
+
+  return 0;
+}
+
+/**
+ * @brief 以单色填充一个矩形：每个条带填充一次颜色后交给发送线程。
+ * @param rect 已裁剪的矩形。
+ * @param color_rgb565 RGB565 颜色值。
+ * @return 0 表示成功；-ECANCELED 表示服务正在停止。
+ */
+int DisplayRenderService::render_solid(const platform::raster::Rect& rect,
+                                       uint16_t color_rgb565) noexcept {
+  const uint16_t strip_rows = static_cast<uint16_t>(kStripPixels / rect.w);
+  for (uint16_t row = 0U; row < rect.h; row = static_cast<uint16_t>(row + strip_rows)) {
+    TxJob job{};
+    job.region = {rect.x, static_cast<uint16_t>(rect.y + row), rect.w,
+                  static_cast<uint16_t>((rect.h - row) < strip_rows ? (rect.h - row)
+                                                                    : strip_rows)};
+    int ret = acquire_strip(job.buffer);
+    if (ret < 0) {
+      return ret;
+    }
+    platform::raster::fill_rgb565_words(strips_[job.buffer],
+                                        static_cast<size_t>(job.region.w) * job.region.h,
+                                        color_rgb565);
+    ret = post_tx(job);
+    if (ret < 0) {
+      return ret;
+    }
+  }
+
+  return 0;
+}
+
+/**
+ * @brief 图元光栅化的矩形输出。
+ * @param rect 已裁剪的矩形。
+ * @param user ShapeJob 指针。
+ * @return 0 表示成功；-ECANCELED 表示服务正在停止。
+ */
+int DisplayRenderService::shape_sink(const platform::raster::Rect& rect, void* user) {
+  const ShapeJob& job = *static_cast<const ShapeJob*>(user);
+  return job.service->render_solid(rect, job.color_rgb565);
+}
+
+/**
+ * @brief 光栅化图元命令并下发。
+ * @param cmd 图元命令。
+ * @return 0 表示成功；-ECANCELED 表示服务正在停止。
+ * @note 光栅化得到的矩形数远少于像素数：水平跨度合并为一行，同列同宽的相邻行再合并为一块。
+ */
+int DisplayRenderService::render_shape(const Command& cmd) noexcept {
+  const ShapeParams& shape = cmd.payload.shape;
+  const platform::raster::Rect clip{0U, 0U, width_, height_};
+  ShapeJob job{this, cmd.fg_rgb565};
+  switch (shape.kind) {
+    case ShapeKind::kLine:
+      return platform::raster::rasterize_line(shape.x0, shape.y0, shape.x1, shape.y1, clip,
+                                              shape_sink, &job);
+    case ShapeKind::kCircle:
+      return platform::raster::rasterize_circle(shape.x0, shape.y0, shape.r, shape.filled, clip,
+                                                shape_sink, &job);
+    case ShapeKind::kRoundRect:
+      return platform::raster::rasterize_round_rect(shape.x0, shape.y0, shape.w, shape.h,
+                                                    shape.r, shape.filled, clip, shape_sink,
+                                                    &job);
+    default:
+      return 0;
+  }
+}
+
+#if defined(CONFIG_SKY_BOARD_CJK_FONT)
+/**
+ * @brief 逐条带光栅化 UTF-8 文本命令并交给发送线程。
+ * @param cmd 文本命令（cmd.w 为字节数）。
+ * @return 0 表示成功；-ECANCELED 表示服务正在停止。
+ * @note 显示列表只记录 5x7 文本，此类命令绕过列表直接下发，调用方须先提交列表。
+ */
+int DisplayRenderService::render_utf8_text(const Command& cmd) noexcept {
+  if (cmd.x >= width_ || cmd.y >= height_ || cmd.w == 0U) {
+    return 0;
+  }
+
+  const uint32_t line_w = platform::raster::utf8_line_width(cmd.payload.text, cmd.w, cmd.scale);
+  const uint32_t line_h = platform::raster::utf8_line_height(cmd.scale);
+  const uint16_t max_w = static_cast<uint16_t>(width_ - cmd.x);
+  const uint16_t max_h = static_cast<uint16_t>(height_ - cmd.y);
+  const uint16_t w = static_cast<uint16_t>(line_w < max_w ? line_w : max_w);
+  const uint16_t h = static_cast<uint16_t>(line_h < max_h ? line_h : max_h);
+  const uint16_t strip_rows = static_cast<uint16_t>(kStripPixels / w);
+  for (uint16_t row = 0U; row < h; row = static_cast<uint16_t>(row + strip_rows)) {
+    TxJob job{};
+    job.region = {cmd.x, static_cast<uint16_t>(cmd.y + row), w,
+                  static_cast<uint16_t>((h - row) < strip_rows ? (h - row) : strip_rows)};
+    int ret = acquire_strip(job.buffer);
+    if (ret < 0) {
+      return ret;
+    }
+    platform::raster::rasterize_utf8_block(platform::raster::cjk_font(), strips_[job.buffer], w,
+                                           0U, w, row, job.region.h, cmd.payload.text, cmd.w,
+                                           cmd.fg_rgb565, cmd.bg_rgb565, cmd.scale);
+    ret = post_tx(job);
+    if (ret < 0) {
+      return ret;
+    }
+  }
+
+  return 0;
+}
+#endif
+
+/**
+ * @brief 把填充/文本命令裁剪到屏幕并记录进显示列表。
+ * @param cmd 命令。
+ * @note 立即模式下记录后随即渲染；保留模式下列表满时先下发已记录内容再重试。
+ */
+void DisplayRenderService::record_command(const Command& cmd) noexcept {
+  if (cmd.x >= width_ || cmd.y >= height_ || cmd.w == 0U) {
+    return;
+  }
+
+  const uint16_t max_w = static_cast<uint16_t>(width_ - cmd.x);
+  const uint16_t max_h = static_cast<uint16_t>(height_ - cmd.y);
+  platform::raster::Rect bounds{cmd.x, cmd.y, 0U, 0U};
+  size_t text_len = 0U;
+  if (cmd.type == CommandType::kFill) {
+    bounds.w = cmd.w < max_w ? cmd.w : max_w;
+    bounds.h = cmd.h < max_h ? cmd.h : max_h;
+  } else {
+    text_len = cmd.w;
+    const uint32_t line_w =
+        static_cast<uint32_t>(text_len) * platform::raster::kCellWidth * cmd.scale;
+    const uint32_t line_h = static_cast<uint32_t>(platform::font5x7::kHeight) * cmd.scale;
+    bounds.w = static_cast<uint16_t>(line_w < max_w ? line_w : max_w);
+    bounds.h = static_cast<uint16_t>(line_h < max_h ? line_h : max_h);
+  }
+
+  for (int attempt = 0; attempt < 2; ++attempt) {
+    const int ret = cmd.type == CommandType::kFill
+                        ? list_.add_fill(bounds, cmd.fg_rgb565)
+                        : list_.add_text(cmd.x, cmd.y, bounds, cmd.payload.text, text_len,
+                                         cmd.fg_rgb565, cmd.bg_rgb565, cmd.scale);
+    if (ret != -ENOMEM) {
+      break;
+    }
+    render_list();
+  }
+
+  if (mode_ == platform::DisplayMode::kImmediate) {
+    render_list();
+  }
+}
+
+/**
+ * @brief 在光栅化线程内处理一条命令。
+ * @param cmd 命令。
+ */
+void DisplayRenderService::handle_command(const Command& cmd) noexcept {
+  switch (cmd.type) {
+    case CommandType::kFill:
+      record_command(cmd);
+      break;
+    case CommandType::kText:
+      record_command(cmd);
+      break;
+    case CommandType::kUtf8Text:
+#if defined(CONFIG_SKY_BOARD_CJK_FONT)
+      render_list();
+      (void)render_utf8_text(cmd);
+#endif
+      break;
+    case CommandType::kBlit: {
+      /* 保留模式下先下发更早记录的内容，保证像素块不被随后的 flush 覆盖。 */
+      render_list();
+      TxJob job{};
+      job.region = {cmd.x, cmd.y, cmd.w, cmd.h};
+      if (acquire_strip(job.buffer) < 0) {
+        break;
+      }
+      (void)memcpy(strips_[job.buffer], cmd.payload.pixels,
+                   static_cast<size_t>(cmd.w) * cmd.h * sizeof(cmd.payload.pixels[0]));
+      (void)post_tx(job);
+      break;
+    }
+    case CommandType::kImage: {
+      render_list();
+      const int ret = render_image(cmd);
+      if (ret < 0 && ret != -ECANCELED) {
+        log_.error("failed to draw display image", ret);
+      }
+      break;
+    }
+    case CommandType::kShape:
+      /* 图元由大量小矩形组成，不进显示列表：先下发更早记录的内容，再直接下发。 */
+      render_list();
+      (void)render_shape(cmd);
+      break;
+    case CommandType::kSetMode:
+      render_list();
+      mode_ = cmd.mode;
+      break;
+    case CommandType::kFlush:
+      render_list();
+      break;
+    case CommandType::kFence: {
+      TxJob job{};
+      job.fence = true;
+      job.seq = cmd.seq;
+      (void)post_tx(job);
+      break;
+    }
+    case CommandType::kBootScreen: {
+      render_list();
+      if (drain_pipeline() < 0) {
+        break;
+      }
+      /* 两块条带均空闲即发送线程不再访问面板，此时可直接同步绘制。 */
+      const int ret = panel_.show_boot_screen();
+      if (ret < 0) {
+        log_.error("failed to draw display boot screen", ret);
+      }
+      break;
+    }
+    default:
+      break;
+  }
+}
+
+/**
+ * @brief 光栅化线程主循环。
+ */
+void DisplayRenderService::render_loop() noexcept {
+  log_.info("display render thread starting");
+
+  while (atomic_get(&stop_requested_) == 0) {
+    Command cmd{};
+    if (k_msgq_get(&cmd_q_, &cmd, K_MSEC(kPollPeriodMs)) != 0) {
+      continue;
+    }
+    handle_command(cmd);
+  }
+
+  list_.reset();
+  on_thread_exit("render");
+}
+
+/**
+ * @brief 发送线程主循环。
+ * @note 面板写入在 SPI DMA 传输期间让出 CPU，光栅化线程借此准备下一个条带。
+ */
+void DisplayRenderService::tx_loop() noexcept {
+  log_.info("display tx thread starting");
+
+  while (atomic_get(&stop_requested_) == 0) {
+    TxJob job{};
+    if (k_msgq_get(&tx_q_, &job, K_MSEC(kPollPeriodMs)) != 0) {
+      continue;
+    }
+
+    if (job.fence) {
+      k_mutex_lock(&fence_mutex_, K_FOREVER);
+      completed_fence_ = job.seq;
+      k_condvar_broadcast(&fence_cond_);
+      k_mutex_unlock(&fence_mutex_);
+      continue;
+    }
+
+    const int ret = panel_.blit(job.region.x, job.region.y, job.region.w, job.region.h,
+                                strips_[job.buffer]);
+    k_sem_give(&free_strips_);
+    if (ret < 0) {
+      ++tx_error_streak_;
+      if (tx_error_streak_ == 1U || (tx_error_streak_ % 10U) == 0U) {
+        log_.error("display strip write failed", ret);
+      }
+    } else {
+      tx_error_streak_ = 0U;
+    }
+  }
+
+  on_thread_exit("tx");
+}
+
+}  // namespace servers
@@ -0,0 +1,377 @@
+/**
+ * @file display_service.cpp
+ * @brief 仪表盘显示服务实现。
+ */
+
+#include "servers/display_service.hpp"
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "platform/display_raster.hpp"
+#include "platform/platform_button.hpp"
+#include "platform/screen_capture.hpp"
+
+namespace servers {
+
+namespace {
+
+/** @brief 仪表盘文本缩放倍数。 */
+constexpr uint8_t kTextScale = 2U;
+/** @brief 缩放后的字符单元宽度（像素）。 */
+constexpr uint16_t kCellPx = static_cast<uint16_t>(platform::raster::kCellWidth * kTextScale);
+/** @brief 左边距（像素）。 */
+constexpr uint16_t kMarginX = 8U;
+/** @brief 标题行 Y 坐标。 */
+constexpr uint16_t kTitleY = 10U;
+/** @brief 标题下方分隔线 Y 坐标。 */
+constexpr uint16_t kRuleY = 34U;
+/** @brief 首个字段行 Y 坐标。 */
+constexpr uint16_t kFirstRowY = 48U;
+/** @brief 字段行间距（像素）。 */
+constexpr uint16_t kRowPitch = 32U;
+/** @brief 标签列宽（字符数，含间隔）。 */
+constexpr uint16_t kLabelChars = 5U;
+/** @brief 字段值起始 X 坐标。 */
+constexpr uint16_t kValueX = static_cast<uint16_t>(kMarginX + kLabelChars * kCellPx);
+
+/** @brief 背景色（黑）。 */
+constexpr uint16_t kColorBg = 0x0000U;
+/** @brief 标题色（黄）。 */
+constexpr uint16_t kColorTitle = 0xFFE0U;
+/** @brief 分隔线色（深灰）。 */
+constexpr uint16_t kColorRule = 0x39E7U;
+/** @brief 标签色（灰）。 */
+constexpr uint16_t kColorLabel = 0x8410U;
+/** @brief 字段值颜色（白）。 */
+constexpr uint16_t kColorValue = 0xFFFFU;
+/** @brief 电流曲线颜色（青）。 */
+constexpr uint16_t kColorChart = 0x07FFU;
+
+/** @brief 字段标签，顺序与 DisplayService::Field 一致。 */
+constexpr const char* kFieldLabels[] = {"VBUS", "IBUS", "PWR", "TEMP", "RH", "ENC", "KEYS"};
+
+/** @brief 电流曲线顶部 Y 坐标（最后一个字段行之下）。 */
+constexpr uint16_t kChartY =
+    static_cast<uint16_t>(kFirstRowY + sizeof(kFieldLabels) / sizeof(kFieldLabels[0]) * kRowPitch);
+/** @brief 电流曲线高度（像素）。 */
+constexpr uint16_t kChartHeight = 40U;
+/** @brief 电流曲线量程上限（mA），下限为 0。 */
+constexpr int32_t kChartMaxMa = 1000;
+
+/** @brief 数据无效时的占位文本。 */
+constexpr const char* kNoData = "---";
+
+/**
+ * @brief 把千分单位定点数格式化为带小数的文本。
+ * @param out 输出缓冲。
+ * @param size 输出缓冲大小。
+ * @param milli 数值（千分单位，例如 mV、m°C）。
+ * @param decimals 保留小数位数（1~3）。
+ * @param unit 单位后缀（含前导空格）。
+ */
+void format_milli(char* out, size_t size, int32_t milli, uint8_t decimals, const char* unit) {
+  static constexpr uint32_t kDropDivisor[] = {1000U, 100U, 10U, 1U};
+  const bool negative = milli < 0;
+  const uint32_t abs_value =
+      negative ? static_cast<uint32_t>(-(milli + 1)) + 1U : static_cast<uint32_t>(milli);
+  const uint32_t frac = (abs_value % 1000U) / kDropDivisor[decimals];
+  (void)snprintf(out, size, "%s%lu.%0*lu%s", negative ? "-" : "",
+                 static_cast<unsigned long>(abs_value / 1000U), static_cast<int>(decimals),
+                 static_cast<unsigned long>(frac), unit);
+}
+
+}  // namespace
+
+/**
+ * @brief 线程入口静态适配函数。
+ * @param p1 DisplayService 对象指针。
+ */
+void DisplayService::threadEntry(void* p1, void*, void*) {
+  static_cast<DisplayService*>(p1)->threads();
+}
+
+/**
+ * @brief 服务线程主循环。
+ * @note 刷新在保留模式下记录，周期末尾统一 flush，同一行相邻的变化段可合并为一次传输。
+ */
+void DisplayService::threads() noexcept {
+  log_.info("display service starting");
+
+  while (atomic_get(&stop_requested_) == 0) {
+    const int64_t start_ms = k_uptime_get();
+
+#if defined(CONFIG_SKY_BOARD_SCREEN_MIRROR)
+    /* 镜像客户端接入或捕获数据丢失：整屏重绘，使远端画面完整。 */
+    if (platform::screen_capture().take_resync()) {
+      layout_drawn_ = false;
+    }
+#endif
+
+    if (!layout_drawn_) {
+      const int ret = draw_static_layout();
+      if (ret < 0) {
+        ++error_streak_;
+        if (error_streak_ == 1U || (error_streak_ % 10U) == 0U) {
+          log_.error("display dashboard layout draw failed", ret);
+        }
+      } else {
+        layout_drawn_ = true;
+      }
+    }
+
+    if (layout_drawn_) {
+      refresh();
+      const int ret = display_.flush();
+      if (ret < 0) {
+        /* 记录内容未能下发：下个周期整字段重绘。 */
+        for (FieldState& field : fields_) {
+          field.valid = false;
+        }
+        chart_.invalidate();
+      }
+    }
+
+    const int64_t elapsed_ms = k_uptime_get() - start_ms;
+    if (elapsed_ms < kRefreshPeriodMs) {
+      k_sleep(K_MSEC(kRefreshPeriodMs - elapsed_ms));
+    }
+  }
+
+  atomic_set(&running_, 0);
+  thread_id_ = nullptr;
+  log_.info("display service stopped");
+}
+
+/**
+ * @brief 清屏并绘制静态布局。
+ * @return 0 表示成功；负值表示失败。
+ */
+int DisplayService::draw_static_layout() noexcept {
+  static_assert(sizeof(kFieldLabels) / sizeof(kFieldLabels[0]) == kFieldCount,
+                "field label table out of sync");
+
+  int ret = display_.set_mode(platform::DisplayMode::kRetained);
+  if (ret < 0) {
+    return ret;
+  }
+
+  ret = display_.clear(kColorBg);
+  if (ret < 0) {
+    return ret;
+  }
+
+  ret = display_.draw_text(kMarginX, kTitleY, "BENCH MONITOR", kColorTitle, kColorBg, kTextScale);
+  if (ret < 0) {
+    return ret;
+  }
+
+  const uint16_t rule_w = static_cast<uint16_t>(display_.width() - 2U * kMarginX);
+  ret = display_.fill_rect(kMarginX, kRuleY, rule_w, 2U, kColorRule);
+  if (ret < 0) {
+    return ret;
+  }
+
+  for (uint8_t i = 0U; i < kFieldCount; ++i) {
+    const uint16_t y = static_cast<uint16_t>(kFirstRowY + i * kRowPitch);
+    ret = display_.draw_text(kMarginX, y, kFieldLabels[i], kColorLabel, kColorBg, kTextScale);
+    if (ret < 0) {
+      return ret;
+    }
+    fields_[i].valid = false;
+  }
+
+  /* 曲线外框留出 2 像素间隙；曲线背景在首个样本到来时由控件自行绘制。 */
+  ret = display_.draw_round_rect(static_cast<int16_t>(kMarginX - 3U),
+                                 static_cast<int16_t>(kChartY - 3U),
+                                 static_cast<uint16_t>(rule_w + 6U),
+                                 static_cast<uint16_t>(kChartHeight + 6U), 4U, kColorRule, false);
+  if (ret < 0) {
+    return ret;
+  }
+
+  const platform::raster::Rect chart_area{kMarginX, kChartY, rule_w, kChartHeight};
+  ret = chart_.configure(chart_area, 0, kChartMaxMa, {kColorChart, kColorBg, kColorRule});
+  if (ret < 0) {
+    return ret;
+  }
+
+  return display_.flush();
+}
+
+/**
+ * @brief 采集全部数据源并刷新各字段。
+ */
+void DisplayService::refresh() noexcept {
+  char text[kFieldChars + 1] = {};
+
+  platform::Ina226Sample ina = {};
+  const bool ina_ok = sensors_.get_latest_ina226(ina) == 0;
+  if (ina_ok) {
+    format_milli(text, sizeof(text), ina.bus_mv, 3U, " V");
+  }
+  update_field(kBusVoltage, ina_ok ? text : kNoData);
+  if (ina_ok) {
+    (void)snprintf(text, sizeof(text), "%ld mA", static_cast<long>(ina.current_ma));
+  }
+  update_field(kCurrent, ina_ok ? text : kNoData);
+  if (ina_ok) {
+    (void)snprintf(text, sizeof(text), "%ld mW", static_cast<long>(ina.power_mw));
+  }
+  update_field(kPower, ina_ok ? text : kNoData);
+  if (ina_ok) {
+    update_chart(ina);
+  }
+
+  platform::Aht20Sample aht = {};
+  const bool aht_ok = sensors_.get_latest_aht20(aht) == 0;
+  if (aht_ok) {
+    format_milli(text, sizeof(text), aht.temp_mc, 2U, " C");
+  }
+  update_field(kTemperature, aht_ok ? text : kNoData);
+  if (aht_ok) {
+    /* 千分比 x100 即千分之一百分点，复用千分单位格式化。 */
+    format_milli(text, sizeof(text), aht.rh_mpermille * 100, 1U, " %");
+  }
+  update_field(kHumidity, aht_ok ? text : kNoData);
+
+  int64_t count = 0;
+  const bool enc_ok = encoder_.get_count(count) == 0;
+  if (enc_ok) {
+    (void)snprintf(text, sizeof(text), "%lld", static_cast<long long>(count));
+  }
+  update_field(kEncoderCount, enc_ok ? text : kNoData);
+
+  platform::ButtonState keys = {};
+  const bool keys_ok = platform::button_get_state(keys) == 0;
+  if (keys_ok) {
+    (void)snprintf(text, sizeof(text), "%c %c %c", keys.key1_pressed ? '1' : '-',
+                   keys.key2_pressed ? '2' : '-', keys.key3_pressed ? '3' : '-');
+  }
+  update_field(kButtons, keys_ok ? text : kNoData);
+}
+
+/**
+ * @brief 比较字段新旧文本，只重绘变化的字符段。
+ * @param field 字段下标。
+ * @param text 新的字段文本。
+ * @note 文本右对齐到 kFieldChars 个字符，数值位数变化时个位仍保持在固定列。
+ *       间隔不超过 kRunMergeGap 个未变字符的两个变化段合并绘制，减少命令条数。
+ */
+void DisplayService::update_field(Field field, const char* text) noexcept {
+  char padded[kFieldChars + 1] = {};
+  size_t len = strlen(text);
+  if (len > kFieldChars) {
+    len = kFieldChars;
+  }
+  (void)memset(padded, ' ', kFieldChars);
+  (void)memcpy(&padded[kFieldChars - len], text, len);
+
+  FieldState& state = fields_[field];
+  const uint16_t y = static_cast<uint16_t>(kFirstRowY + field * kRowPitch);
+  size_t i = 0U;
+  while (i < kFieldChars) {
+    if (state.valid && padded[i] == state.shown[i]) {
+      ++i;
+      continue;
+    }
+
+    size_t end = i + 1U;
+    size_t gap = 0U;
+    for (size_t j = end; j < kFieldChars; ++j) {
+      if (!state.valid || padded[j] != state.shown[j]) {
+        end = j + 1U;
+        gap = 0U;
+      } else if (++gap > kRunMergeGap) {
+        break;
+      }
+    }
+
+    char run[kFieldChars + 1] = {};
+    (void)memcpy(run, &padded[i], end - i);
+    const int ret = display_.draw_text(static_cast<uint16_t>(kValueX + i * kCellPx), y, run,
+                                       kColorValue, kColorBg, kTextScale);
+    if (ret < 0) {
+      /* 屏幕内容已不确定，下次整字段重绘。 */
+      state.valid = false;
+      ++error_streak_;
+      if (error_streak_ == 1U || (error_streak_ % 10U) == 0U) {
+        log_.error("display dashboard field draw failed", ret);
+      }
+      return;
+    }
+    i = end;
+  }
+
+  (void)memcpy(state.shown, padded, sizeof(padded));
+  state.valid = true;
+  error_streak_ = 0U;
+}
+
+/**
+ * @brief 把新的 INA226 电流样本追加到曲线。
+ * @param sample INA226 样本。
+ * @note 仪表盘刷新比采样快，按时间戳去重，每个采样周期只追加一列。
+ */
+void DisplayService::update_chart(const platform::Ina226Sample& sample) noexcept {
+  if (sample.ts_ms == chart_ts_ms_) {
+    return;
+  }
+
+  const int ret = chart_.push(display_, sample.current_ma);
+  if (ret < 0) {
+    ++error_streak_;
+    if (error_streak_ == 1U || (error_streak_ % 10U) == 0U) {
+      log_.error("display dashboard chart draw failed", ret);
+    }
+    return;
+  }
+  chart_ts_ms_ = sample.ts_ms;
+}
+
+/**
+ * @brief 请求停止仪表盘服务线程。
+ * @note 仅设置停止标志并唤醒线程，不阻塞等待线程退出。
+ */
+void DisplayService::stop() noexcept {
+  if (atomic_get(&running_) == 0) {
+    return;
+  }
+  atomic_set(&stop_requested_, 1);
+  if (thread_id_ != nullptr) {
+    k_wakeup(thread_id_);
+  }
+}
+
+/**
+ * @brief 启动仪表盘服务线程。
+ * @return 0 表示成功或已运行；负值表示失败。
+ */
+int DisplayService::run() noexcept {
+  if (!atomic_cas(&running_, 0, 1)) {
+    log_.info("display service already running");
+    return 0;
+  }
+
+  for (FieldState& field : fields_) {
+    field = {};
+  }
+  layout_drawn_ = false;
+  chart_ts_ms_ = -1;
+  error_streak_ = 0U;
+  atomic_set(&stop_requested_, 0);
+
+  thread_id_ = k_thread_create(&thread_, stack_, K_THREAD_STACK_SIZEOF(stack_), threadEntry, this,
+                               nullptr, nullptr, kPriority, 0, K_NO_WAIT);
+  if (thread_id_ == nullptr) {
+    atomic_set(&running_, 0);
+    log_.error("failed to create display service thread", -1);
+    return -1;
+  }
+
+  k_thread_name_set(thread_id_, "display_service");
+  return 0;
+}
+
+}  // namespace servers
@@ -8,6 +8,8 @@
 #include <errno.h>
 #include <stdio.h>
 
+#include "platform/platform_backlight.hpp"
+
 namespace servers {
 
 namespace {
@@ -39,7 +41,7 @@ void EncoderService::threadEntry(void* p1, void*, void*) {
 
 /**
  * @brief 编码器服务主线程.
- * @note 周期采样编码器, 输出角度变化并维护累计计数.
+ * @note 周期采样编码器, 输出角度变化并维护累计计数. 位置变化上报为背光用户操作.
  */
 void EncoderService::threads() noexcept {
   log_.info("encoder service starting");
@@ -65,6 +67,9 @@ void EncoderService::threads() noexcept {
     if (!have_last_position || sample.position_deg != last_position) {
       const int32_t delta =
           have_last_position ? circular_delta_deg(sample.position_deg, last_position) : 0;
+      if (have_last_position) {
+        platform::backlight_user_activity();
+      }
       residual_deg += delta;
       const int32_t step_delta = residual_deg / kDegPerStep;
       residual_deg -= (step_delta * kDegPerStep);
@@ -10,6 +10,8 @@
 #include <zephyr/drivers/gpio.h>
 #include <zephyr/kernel.h>
 
+#include "platform/platform_display.hpp"
+
 namespace servers {
 
 /** @brief 板级 led0 别名节点（本板映射到 PB2）。 */
@@ -66,6 +68,9 @@ void HelloService::threads() noexcept {
     }
 
     log_.info("heartbeat: system alive");
+#if defined(CONFIG_SKY_BOARD_DISPLAY_STATS)
+    (void)platform::display_stats_log(log_, true);
+#endif
     k_sleep(K_SECONDS(10));
   }
 
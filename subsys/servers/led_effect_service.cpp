@@ -0,0 +1,317 @@
+/**
+ * @file led_effect_service.cpp
+ * @brief WS2812 灯效服务实现：灯效注册表与固定周期帧调度。
+ */
+
+#include "servers/led_effect_service.hpp"
+
+#include <errno.h>
+
+namespace servers {
+
+namespace {
+
+/**
+ * @brief 单帧渲染所需的上下文。
+ */
+struct EffectContext {
+  /** @brief WS2812 驱动。 */
+  platform::IWs2812& ws;
+  /** @brief 传感器服务。 */
+  SensorService& sensors;
+  /** @brief 灯珠数量（非 0）。 */
+  size_t count;
+  /** @brief 动画帧号。 */
+  uint32_t frame;
+};
+
+/**
+ * @brief 灯效注册表条目。
+ */
+struct EffectEntry {
+  /** @brief 灯效名称。 */
+  const char* name;
+  /** @brief 渲染函数：只写本地像素缓冲，不负责下发。 */
+  void (*render)(const EffectContext& ctx);
+};
+
+/** @brief 彩虹每帧推进的色相（100 Hz 下约 2.6 秒一圈）。 */
+constexpr uint32_t kRainbowHueStep = 6U;
+/** @brief 呼吸效果一个周期的帧数。 */
+constexpr uint32_t kBreathePeriodFrames = 300U;
+/** @brief 跑马灯每移动一格的帧数。 */
+constexpr uint32_t kChaseFramesPerStep = 8U;
+/** @brief 跑马灯拖尾长度（含灯头）。 */
+constexpr uint32_t kChaseTail = 4U;
+/** @brief 电流映射的满量程（mA）。 */
+constexpr int32_t kCurrentFullScaleMa = 1000;
+/** @brief 温度映射的下限（milli-Celsius），对应蓝色。 */
+constexpr int32_t kTempColdMc = 15000;
+/** @brief 温度映射的上限（milli-Celsius），对应红色。 */
+constexpr int32_t kTempHotMc = 35000;
+/** @brief 绿色色相。 */
+constexpr uint16_t kHueGreen = 512U;
+/** @brief 蓝色色相。 */
+constexpr uint16_t kHueBlue = 1024U;
+/** @brief 暂无传感器样本时的提示色（暗白）。 */
+constexpr platform::Ws2812Rgb kNoDataColor = {16U, 16U, 16U};
+
+/**
+ * @brief 把数值线性映射到 [0, 255] 并截断。
+ * @param value 输入值。
+ * @param lo 映射到 0 的输入值。
+ * @param hi 映射到 255 的输入值（大于 lo）。
+ * @return 映射结果。
+ */
+uint32_t map_to_u8(int32_t value, int32_t lo, int32_t hi) noexcept {
+  if (value <= lo) {
+    return 0U;
+  }
+  if (value >= hi) {
+    return 255U;
+  }
+  return static_cast<uint32_t>((static_cast<int64_t>(value - lo) * 255) / (hi - lo));
+}
+
+/**
+ * @brief 彩虹：整条灯带铺满一圈色相并随时间流动。
+ * @param ctx 渲染上下文。
+ */
+void render_rainbow(const EffectContext& ctx) {
+  /* 色相在 uint32_t 中先对色相范围取模再收窄；65536 不是 1536 的整数倍，直接截断会跳色。 */
+  const uint32_t base =
+      ((ctx.frame % platform::kWs2812HueRange) * kRainbowHueStep) % platform::kWs2812HueRange;
+  for (size_t i = 0U; i < ctx.count; ++i) {
+    const uint32_t hue =
+        (base + (i * platform::kWs2812HueRange) / ctx.count) % platform::kWs2812HueRange;
+    (void)ctx.ws.set_pixel(i, platform::ws2812_hsv(static_cast<uint16_t>(hue), 255U, 255U));
+  }
+}
+
+/**
+ * @brief 呼吸：全灯同色，明度按三角波平方起伏，色相缓慢变化。
+ * @param ctx 渲染上下文。
+ */
+void render_breathe(const EffectContext& ctx) {
+  const uint32_t phase = ctx.frame % kBreathePeriodFrames;
+  const uint32_t half = kBreathePeriodFrames / 2U;
+  const uint32_t tri = ((phase < half) ? phase : (kBreathePeriodFrames - phase)) * 255U / half;
+  const uint8_t val = static_cast<uint8_t>((tri * tri + 127U) / 255U);
+  const uint16_t hue = static_cast<uint16_t>((ctx.frame / 4U) % platform::kWs2812HueRange);
+  (void)ctx.ws.fill(platform::ws2812_hsv(hue, 255U, val));
+}
+
+/**
+ * @brief 跑马灯：一个灯头带渐暗拖尾循环移动。
+ * @param ctx 渲染上下文。
+ */
+void render_chase(const EffectContext& ctx) {
+  const size_t head = (ctx.frame / kChaseFramesPerStep) % ctx.count;
+  const uint16_t hue = static_cast<uint16_t>(ctx.frame % platform::kWs2812HueRange);
+  for (size_t i = 0U; i < ctx.count; ++i) {
+    const size_t behind = (head + ctx.count - i) % ctx.count;
+    const uint8_t val = (behind < kChaseTail) ? static_cast<uint8_t>(255U >> (2U * behind)) : 0U;
+    (void)ctx.ws.set_pixel(i, platform::ws2812_hsv(hue, 255U, val));
+  }
+}
+
+/**
+ * @brief 电流映射：点亮的灯珠数与颜色随 INA226 电流变化（绿 -> 红）。
+ * @param ctx 渲染上下文。
+ */
+void render_current(const EffectContext& ctx) {
+  platform::Ina226Sample sample = {};
+  if (ctx.sensors.get_latest_ina226(sample) < 0) {
+    (void)ctx.ws.fill(kNoDataColor);
+    return;
+  }
+
+  const uint32_t level = map_to_u8(sample.current_ma, 0, kCurrentFullScaleMa);
+  const uint16_t hue = static_cast<uint16_t>(kHueGreen - (level * kHueGreen) / 255U);
+  /* 至少点亮一颗，表示数据有效。 */
+  const size_t lit = 1U + (level * (ctx.count - 1U)) / 255U;
+  for (size_t i = 0U; i < ctx.count; ++i) {
+    (void)ctx.ws.set_pixel(i, platform::ws2812_hsv(hue, 255U, (i < lit) ? 255U : 0U));
+  }
+}
+
+/**
+ * @brief 温度映射：全灯颜色随 AHT20 温度变化（蓝 -> 红）。
+ * @param ctx 渲染上下文。
+ */
+void render_temperature(const EffectContext& ctx) {
+  platform::Aht20Sample sample = {};
+  if (ctx.sensors.get_latest_aht20(sample) < 0) {
+    (void)ctx.ws.fill(kNoDataColor);
+    return;
+  }
+
+  const uint32_t level = map_to_u8(sample.temp_mc, kTempColdMc, kTempHotMc);
+  const uint16_t hue = static_cast<uint16_t>(kHueBlue - (level * kHueBlue) / 255U);
+  (void)ctx.ws.fill(platform::ws2812_hsv(hue, 255U, 255U));
+}
+
+/** @brief 灯效注册表，下标即 set_effect 的参数。 */
+constexpr EffectEntry kEffects[] = {
+    {"rainbow", render_rainbow},
+    {"breathe", render_breathe},
+    {"chase", render_chase},
+    {"current", render_current},
+    {"temperature", render_temperature},
+};
+
+/** @brief 注册的灯效个数。 */
+constexpr size_t kEffectCount = sizeof(kEffects) / sizeof(kEffects[0]);
+
+}  // namespace
+
+/**
+ * @brief 获取注册的灯效个数。
+ * @return 灯效个数。
+ */
+size_t LedEffectService::effect_count() noexcept { return kEffectCount; }
+
+/**
+ * @brief 获取灯效名称。
+ * @param index 灯效下标。
+ * @return 灯效名称；越界时返回 nullptr。
+ */
+const char* LedEffectService::effect_name(size_t index) noexcept {
+  return (index < kEffectCount) ? kEffects[index].name : nullptr;
+}
+
+/**
+ * @brief 切换当前灯效，下一帧生效。
+ * @param index 灯效下标。
+ * @return 0 表示成功；-EINVAL 表示下标越界。
+ */
+int LedEffectService::set_effect(size_t index) noexcept {
+  if (index >= kEffectCount) {
+    return -EINVAL;
+  }
+  atomic_set(&effect_, static_cast<atomic_val_t>(index));
+  log_.infof("led effect: %s", kEffects[index].name);
+  return 0;
+}
+
+/**
+ * @brief 读取运行统计。
+ * @param out 输出统计。
+ */
+void LedEffectService::get_stats(LedEffectStats& out) const noexcept {
+  out.frames = static_cast<uint32_t>(atomic_get(&frames_));
+  out.skipped = static_cast<uint32_t>(atomic_get(&skipped_));
+}
+
+/**
+ * @brief 帧工作项回调。
+ * @param work 工作项。
+ */
+void LedEffectService::workHandler(struct k_work* work) {
+  struct k_work_delayable* dwork = k_work_delayable_from_work(work);
+  CONTAINER_OF(dwork, FrameWork, work)->owner->frame();
+}
+
+/**
+ * @brief 渲染并提交一帧，然后调度下一帧。
+ * @note 截止时间按固定周期累加而不是从本帧结束时刻起算，因此帧率不漂移；
+ *       落后一个周期以上时跳过错过的帧，灯带仍在发送上一帧时本帧同样跳过。
+ */
+void LedEffectService::frame() noexcept {
+  if (atomic_get(&stop_requested_) != 0) {
+    atomic_set(&running_, 0);
+    log_.info("led effect service stopped");
+    return;
+  }
+
+  const int64_t period = k_ms_to_ticks_ceil64(CONFIG_SKY_BOARD_LED_EFFECT_PERIOD_MS);
+  const int64_t late = k_uptime_ticks() - next_tick_;
+  uint32_t skipped = 0U;
+  if (late >= period) {
+    skipped = static_cast<uint32_t>(late / period);
+    next_tick_ += static_cast<int64_t>(skipped) * period;
+  }
+  frame_index_ += 1U + skipped;
+
+  const size_t count = ws_.size();
+  if (count != 0U) {
+    /* 非阻塞查询上一帧：仍在发送则跳过本帧，否则同时取回它的发送结果。 */
+    int ret = ws_.wait_idle(0);
+    if (ret == -EAGAIN) {
+      ++skipped;
+    } else {
+      if (ret >= 0) {
+        const size_t effect = static_cast<size_t>(atomic_get(&effect_));
+        kEffects[effect].render({ws_, sensors_, count, frame_index_});
+        ret = ws_.show_async();
+      }
+      if (ret < 0) {
+        ++error_streak_;
+        if (error_streak_ == 1U || (error_streak_ % 100U) == 0U) {
+          log_.error("led effect frame failed", ret);
+        }
+      } else {
+        error_streak_ = 0U;
+        (void)atomic_inc(&frames_);
+      }
+    }
+  }
+  if (skipped != 0U) {
+    (void)atomic_add(&skipped_, static_cast<atomic_val_t>(skipped));
+  }
+
+  const int64_t now_ms = k_uptime_get();
+  const uint32_t total_skipped = static_cast<uint32_t>(atomic_get(&skipped_));
+  if (now_ms >= next_log_ms_ && total_skipped != logged_skipped_) {
+    log_.infof("led effect: frames=%lu skipped=%lu",
+               static_cast<unsigned long>(atomic_get(&frames_)),
+               static_cast<unsigned long>(total_skipped));
+    logged_skipped_ = total_skipped;
+    next_log_ms_ = now_ms + kStatsLogPeriodMs;
+  }
+
+  next_tick_ += period;
+  (void)k_work_schedule(&work_.work, K_TIMEOUT_ABS_TICKS(next_tick_));
+}
+
+/**
+ * @brief 请求停止调度。
+ */
+void LedEffectService::stop() noexcept {
+  if (atomic_get(&running_) == 0) {
+    return;
+  }
+  atomic_set(&stop_requested_, 1);
+  if (k_work_cancel_delayable(&work_.work) == 0) {
+    /* 已取消尚未执行的帧，不会再有回调来清除运行标志。 */
+    atomic_set(&running_, 0);
+    log_.info("led effect service stopped");
+  }
+}
+
+/**
+ * @brief 开始调度灯效帧。
+ * @return 0 表示成功或已运行；负值表示失败。
+ */
+int LedEffectService::run() noexcept {
+  if (!atomic_cas(&running_, 0, 1)) {
+    log_.info("led effect service already running");
+    return 0;
+  }
+  atomic_set(&stop_requested_, 0);
+
+  k_work_init_delayable(&work_.work, workHandler);
+  next_tick_ = k_uptime_ticks();
+  const int ret = k_work_schedule(&work_.work, K_NO_WAIT);
+  if (ret < 0) {
+    atomic_set(&running_, 0);
+    log_.error("failed to schedule led effect frame", ret);
+    return ret;
+  }
+
+  log_.infof("led effect service started: %s @ %d ms", kEffects[atomic_get(&effect_)].name,
+             CONFIG_SKY_BOARD_LED_EFFECT_PERIOD_MS);
+  return 0;
+}
+
+}  // namespace servers
@@ -0,0 +1,60 @@
+/**
+ * @file screen_mirror_service.cpp
+ * @brief 屏幕镜像服务实现。
+ */
+
+#include "servers/screen_mirror_service.hpp"
+
+#include <errno.h>
+#include <zephyr/net/socket.h>
+
+#include "platform/screen_capture.hpp"
+
+namespace servers {
+
+/**
+ * @brief 镜像会话主循环。
+ * @param client_fd 客户端 socket。
+ * @note 客户端发来的数据被忽略；记录流为空时用非阻塞 recv 探测连接是否已关闭。
+ */
+void ScreenMirrorService::serve(int client_fd) noexcept {
+  platform::ScreenCapture& capture = platform::screen_capture();
+  capture.begin(display_.width(), display_.height());
+
+  while (!stop_requested()) {
+    const size_t len = capture.read(chunk_, sizeof(chunk_), K_MSEC(kIdleWaitMs));
+    if (len == 0U) {
+      uint8_t probe = 0U;
+      const ssize_t recv_len = zsock_recv(client_fd, &probe, sizeof(probe), ZSOCK_MSG_DONTWAIT);
+      if (recv_len == 0) {
+        log_.info("screen mirror client disconnected");
+        break;
+      }
+      if (recv_len < 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
+        log_.error("screen mirror recv failed", -errno);
+        break;
+      }
+      continue;
+    }
+
+    const int ret = send_all(client_fd, chunk_, len);
+    if (ret < 0) {
+      if (ret != -ECANCELED) {
+        log_.error("screen mirror send failed", ret);
+      }
+      break;
+    }
+  }
+
+  capture.end();
+
+  platform::ScreenCaptureStats stats{};
+  capture.get_stats(stats, true);
+  log_.infof("screen mirror session: raw=%lu sent=%lu records=%lu dropped=%lu",
+             static_cast<unsigned long>(stats.raw_bytes),
+             static_cast<unsigned long>(stats.stream_bytes),
+             static_cast<unsigned long>(stats.records),
+             static_cast<unsigned long>(stats.dropped));
+}
+
+}  // namespace servers
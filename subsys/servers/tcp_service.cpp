@@ -35,7 +35,7 @@ void TcpService::threadEntry(void* p1, void*, void*) { static_cast<TcpService*>(
 
 /**
  * @brief TCP 服务线程主循环。
- * @note 负责建链监听、接入客户端、接收并回传数据。
+ * @note 负责建链监听、接入客户端，并把客户端会话交给 serve()。
  */
 void TcpService::threads() noexcept {
   /*
@@ -44,7 +44,7 @@ void TcpService::threads() noexcept {
    * 2) 进入主循环并确保监听 socket 就绪。
    * 3) 轮询监听 socket，周期检查停止标志。
    * 4) 有新连接时 accept 客户端并配置收发超时。
-   * 5) 在客户端会话内循环 recv -> send，完成 TCP 回传。
+   * 5) 调用 serve() 处理客户端会话（默认循环 recv -> send 完成回传）。
    * 6) 客户端断开或异常后关闭 client fd，回到主循环等待下一个连接。
    * 7) 收到停止请求后统一清理资源并更新服务状态。
    */
@@ -53,16 +53,15 @@ void TcpService::threads() noexcept {
   int listen_fd = -1;
   int client_fd = -1;
 
-  log_.info("tcp service starting");
+  log_.infof("%s starting", name_);
 
   /* 步骤 2：主循环，直到收到 stop 请求。 */
   while (atomic_get(&stop_requested_) == 0) {
     if (listen_fd < 0) {
-      /* 步骤 2.1：监听 fd 未就绪时，创建并配置 0.0.0.0:8000。 */
-      /* 监听端点固定为 0.0.0.0:8000。 */
+      /* 步骤 2.1：监听 fd 未就绪时，创建并配置 0.0.0.0:port_。 */
       struct sockaddr_in addr = {};
       addr.sin_family = AF_INET;
-      addr.sin_port = htons(kListenPort);
+      addr.sin_port = htons(port_);
       addr.sin_addr.s_addr = htonl(INADDR_ANY);
 
       listen_fd = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
@@ -89,7 +88,7 @@ void TcpService::threads() noexcept {
         continue;
       }
 
-      log_.info("tcp service listening on port 8000");
+      log_.infof("%s listening on port %u", name_, static_cast<unsigned int>(port_));
     }
 
     /* 步骤 3：轮询监听 socket，避免 accept 永久阻塞。 */
@@ -116,7 +115,7 @@ void TcpService::threads() noexcept {
       continue;
     }
 
-    log_.info("tcp client connected");
+    log_.infof("%s client connected", name_);
 
     /* 步骤 4.1：给收发设置超时，便于及时响应 stop。 */
     struct timeval timeout = {};
@@ -125,48 +124,8 @@ void TcpService::threads() noexcept {
     (void)zsock_setsockopt(client_fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
     (void)zsock_setsockopt(client_fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
 
-    /* 步骤 5：客户端会话循环，持续执行接收与回传。 */
-    while (atomic_get(&stop_requested_) == 0) {
-      uint8_t buf[256];
-      const ssize_t recv_len = zsock_recv(client_fd, buf, sizeof(buf), 0);
-
-      if (recv_len == 0) {
-        log_.info("tcp client disconnected");
-        break;
-      }
-
-      if (recv_len < 0) {
-        if (errno == EAGAIN || errno == EWOULDBLOCK) {
-          continue;
-        }
-
-        log_.error("tcp recv failed", -errno);
-        break;
-      }
-
-      /* 把本次收到的数据完整回传给客户端。 */
-      size_t sent_total = 0U;
-      /* 步骤 5.1：处理短写，确保本次 payload 全量发回。 */
-      while (sent_total < static_cast<size_t>(recv_len)) {
-        const ssize_t sent_len =
-            zsock_send(client_fd, &buf[sent_total], static_cast<size_t>(recv_len) - sent_total, 0);
-        if (sent_len < 0) {
-          if (errno == EAGAIN || errno == EWOULDBLOCK) {
-            continue;
-          }
-
-          log_.error("tcp send failed", -errno);
-          sent_total = 0U;
-          break;
-        }
-
-        sent_total += static_cast<size_t>(sent_len);
-      }
-
-      if (sent_total == 0U) {
-        break;
-      }
-    }
+    /* 步骤 5：客户端会话，默认执行接收与回传。 */
+    serve(client_fd);
 
     /* 步骤 6：一次客户端会话结束，释放 client fd。 */
     close_fd(client_fd);
@@ -178,7 +137,69 @@ void TcpService::threads() noexcept {
 
   atomic_set(&running_, 0);
   thread_id_ = nullptr;
-  log_.info("tcp service stopped");
+  log_.infof("%s stopped", name_);
+}
+
+/**
+ * @brief 回传会话：循环接收并把数据原样发回，直到客户端断开或请求停止。
+ * @param client_fd 客户端 socket。
+ */
+void TcpService::serve(int client_fd) noexcept {
+  while (!stop_requested()) {
+    uint8_t buf[256];
+    const ssize_t recv_len = zsock_recv(client_fd, buf, sizeof(buf), 0);
+
+    if (recv_len == 0) {
+      log_.info("tcp client disconnected");
+      break;
+    }
+
+    if (recv_len < 0) {
+      if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        continue;
+      }
+
+      log_.error("tcp recv failed", -errno);
+      break;
+    }
+
+    /* 把本次收到的数据完整回传给客户端。 */
+    const int ret = send_all(client_fd, buf, static_cast<size_t>(recv_len));
+    if (ret < 0) {
+      if (ret != -ECANCELED) {
+        log_.error("tcp send failed", ret);
+      }
+      break;
+    }
+  }
+}
+
+/**
+ * @brief 发送全部数据：处理短写，发送超时后重试直到请求停止。
+ * @param fd socket。
+ * @param data 数据。
+ * @param len 字节数。
+ * @return 0 成功；-ECANCELED 请求停止；其他负值为发送错误。
+ */
+int TcpService::send_all(int fd, const void* data, size_t len) noexcept {
+  const uint8_t* bytes = static_cast<const uint8_t*>(data);
+  size_t sent_total = 0U;
+  while (sent_total < len) {
+    if (stop_requested()) {
+      return -ECANCELED;
+    }
+
+    const ssize_t sent_len = zsock_send(fd, &bytes[sent_total], len - sent_total, 0);
+    if (sent_len < 0) {
+      if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        continue;
+      }
+      return -errno;
+    }
+
+    sent_total += static_cast<size_t>(sent_len);
+  }
+  return 0;
 }
 
 /**
@@ -202,7 +223,7 @@ void TcpService::stop() noexcept {
  */
 int TcpService::run() noexcept {
   if (!atomic_cas(&running_, 0, 1)) {
-    log_.info("tcp service already running");
+    log_.infof("%s already running", name_);
     return 0;
   }
 
@@ -211,11 +232,11 @@ int TcpService::run() noexcept {
                                nullptr, nullptr, kPriority, 0, K_NO_WAIT);
   if (thread_id_ == nullptr) {
     atomic_set(&running_, 0);
-    log_.error("failed to create tcp service thread", -1);
+    log_.errorf("failed to create %s thread", name_);
     return -1;
   }
 
-  k_thread_name_set(thread_id_, "tcp_service");
+  k_thread_name_set(thread_id_, name_);
   return 0;
 }
 